@@ -0,0 +1,378 @@
+#include <Scene.h>
+#include <SceneView.h>
+#include <SceneNode.h>
+#include <SceneMesh.h>
+#include <SceneMaterial.h>
+#include <ShaderWatcher.h>
+#include <ShaderCache.h>
+#include <StubShaderCompiler.h>
+#include <VertexBuffer.h>
+#include <WorkerPool.h>
+#include <FrameArena.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// children of a node. depth is log8 of nodes
+const int BRANCH = 8;
+const int ROOT_COUNT = 16;
+const int MESH_COUNT = 64;
+const int MATERIAL_COUNT = 8;
+
+// NODE_WORLD to b1 by StubShaderCompiler
+static const char NODE_WORLD_SHADER[] = "float4x4 b1World : NODE_WORLD;\n";
+// and per instance world of MergeInstances
+static const char INSTANCE_WORLD_SHADER[] = "float4x4 b1World : NODE_WORLD;\nfloat4x4 world : INSTANCE_WORLD;\n";
+
+static hierarchy::ShaderWatcherPtr CompileShader(hierarchy::ShaderCache *cache, const char *source)
+{
+    auto shader = std::make_shared<hierarchy::ShaderWatcher>("bench", cache);
+    shader->source(source);
+    for (int i = 0; i < 1000 && !shader->Compiled(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return shader->Compiled() ? shader : nullptr;
+}
+
+// trees of rootCount roots. every node has one of MESH_COUNT meshes
+static void CreateScene(hierarchy::Scene *scene, int nodeCount, int rootCount, const hierarchy::ShaderWatcherPtr &shader)
+{
+    std::vector<hierarchy::SceneMaterialPtr> materials;
+    for (int i = 0; i < MATERIAL_COUNT; ++i)
+    {
+        auto material = hierarchy::SceneMaterial::Create();
+        material->shader(shader);
+        if (i == MATERIAL_COUNT - 1)
+        {
+            material->alphaMode(hierarchy::AlphaMode::Blend);
+        }
+        materials.push_back(material);
+    }
+
+    float vertices[9] = {};
+    uint16_t indices[] = {0, 1, 2};
+    std::vector<hierarchy::SceneMeshPtr> meshes;
+    for (int i = 0; i < MESH_COUNT; ++i)
+    {
+        auto mesh = hierarchy::SceneMesh::Create();
+        mesh->vertices = hierarchy::VertexBuffer::CreateStatic(
+            hierarchy::Semantics::Vertex, sizeof(float) * 3, vertices, sizeof(vertices));
+        mesh->indices = hierarchy::VertexBuffer::CreateStatic(
+            hierarchy::Semantics::Index, 2, indices, sizeof(indices));
+        mesh->submeshes.push_back({.drawCount = 3, .material = materials[i % materials.size()]});
+        meshes.push_back(mesh);
+    }
+
+    // parent of node i is (i - rootCount) / BRANCH
+    std::vector<hierarchy::SceneNodePtr> nodes;
+    nodes.reserve(nodeCount);
+    uint32_t seed = 1;
+    for (int i = 0; i < nodeCount; ++i)
+    {
+        auto node = hierarchy::SceneNode::Create("node" + std::to_string(i));
+        seed = seed * 1664525u + 1013904223u;
+        node->Mesh(meshes[(seed >> 16) % meshes.size()]);
+        falg::Transform local{};
+        local.translation = {(float)(i % BRANCH), (float)(i / BRANCH % BRANCH), 0};
+        node->Local(local);
+        if (i < rootCount)
+        {
+            scene->sceneNodes.push_back(node);
+        }
+        else
+        {
+            nodes[(i - rootCount) / BRANCH]->AddChild(node);
+        }
+        nodes.push_back(node);
+    }
+    for (auto &root : scene->sceneNodes)
+    {
+        root->UpdateWorld();
+    }
+}
+
+// parallel chunks are concatenated in serial order
+static bool Equals(const hierarchy::DrawList &l, const hierarchy::DrawList &r)
+{
+    if (l.Items.size() != r.Items.size() || l.CB != r.CB || l.CBRanges != r.CBRanges || l.Instances != r.Instances)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < l.Items.size(); ++i)
+    {
+        auto &li = l.Items[i];
+        auto &ri = r.Items[i];
+        if (li.Mesh != ri.Mesh || li.SubmeshIndex != ri.SubmeshIndex ||
+            li.InstanceOffset != ri.InstanceOffset || li.InstanceCount != ri.InstanceCount)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void PushExpected(hierarchy::SceneNode *node, std::unordered_map<const hierarchy::SceneMesh *, uint32_t> *opaque,
+                         std::vector<std::array<float, 16>> *blend)
+{
+    auto &mesh = node->Mesh();
+    if (mesh->submeshes[0].material->alphaMode() == hierarchy::AlphaMode::Blend)
+    {
+        blend->push_back(node->World().RowMatrix());
+    }
+    else
+    {
+        ++(*opaque)[mesh.get()];
+    }
+    int count;
+    auto child = node->GetChildren(&count);
+    for (int i = 0; i < count; ++i, ++child)
+    {
+        PushExpected(child->get(), opaque, blend);
+    }
+}
+
+// INSTANCE_WORLD shader on the retained path. one item per opaque mesh, blend items in traversal order
+static bool CheckMerge(hierarchy::ShaderCache *cache)
+{
+    auto shader = CompileShader(cache, INSTANCE_WORLD_SHADER);
+    if (!shader)
+    {
+        std::cerr << "fail to compile" << std::endl;
+        return false;
+    }
+    // one root is one segment
+    hierarchy::Scene scene;
+    CreateScene(&scene, 4096, 1, shader);
+
+    std::unordered_map<const hierarchy::SceneMesh *, uint32_t> opaque;
+    std::vector<std::array<float, 16>> blend;
+    PushExpected(scene.sceneNodes[0].get(), &opaque, &blend);
+
+    hierarchy::SceneView view;
+    view.RetainDrawList = true;
+    // built, then retained
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        hierarchy::FrameArena::NewFrame();
+        view.UpdateDrawList(&scene);
+        auto &drawlist = view.Drawlist;
+        if (drawlist.Items.size() != opaque.size() + blend.size())
+        {
+            std::cerr << "merge: " << drawlist.Items.size() << " items" << std::endl;
+            return false;
+        }
+        auto remaining = opaque;
+        for (size_t i = 0; i < opaque.size(); ++i)
+        {
+            auto &item = drawlist.Items[i];
+            auto found = remaining.find(item.Mesh.get());
+            if (found == remaining.end() || item.InstanceCount != found->second)
+            {
+                std::cerr << "merge: opaque item " << i << ", " << item.InstanceCount << " instances" << std::endl;
+                return false;
+            }
+            remaining.erase(found);
+        }
+        for (size_t i = 0; i < blend.size(); ++i)
+        {
+            auto &item = drawlist.Items[opaque.size() + i];
+            if (item.InstanceCount != 1 || drawlist.Instances[item.InstanceOffset] != blend[i])
+            {
+                std::cerr << "merge: blend item " << i << " is merged or reordered" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// retained DrawList equals a full build after moves and structure changes of some roots
+static bool CheckRetained(hierarchy::ShaderCache *cache)
+{
+    auto shader = CompileShader(cache, INSTANCE_WORLD_SHADER);
+    if (!shader)
+    {
+        std::cerr << "fail to compile" << std::endl;
+        return false;
+    }
+    hierarchy::Scene scene;
+    CreateScene(&scene, 4096, ROOT_COUNT, shader);
+    auto &roots = scene.sceneNodes;
+    auto move = [](const hierarchy::SceneNodePtr &node) {
+        auto local = node->Local();
+        local.translation[2] += 1;
+        node->Local(local);
+    };
+
+    std::function<void()> changes[] = {
+        // build
+        [] {},
+        // patch
+        [&] {
+            int count;
+            move(*roots[2]->GetChildren(&count));
+        },
+        // grow a segment
+        [&] {
+            auto node = hierarchy::SceneNode::Create("added");
+            node->Mesh(roots[4]->Mesh());
+            roots[3]->AddChild(node);
+        },
+        // shrink a segment
+        [&] { roots[5]->Mesh(nullptr); },
+        // splice and patch
+        [&] {
+            roots[7]->Mesh(roots[9]->Mesh());
+            move(roots[0]);
+            move(roots[ROOT_COUNT - 1]);
+        },
+        // retained
+        [] {},
+    };
+
+    hierarchy::SceneView retained;
+    retained.RetainDrawList = true;
+    for (size_t i = 0; i < std::size(changes); ++i)
+    {
+        changes[i]();
+        scene.Update();
+        hierarchy::FrameArena::NewFrame();
+        retained.UpdateDrawList(&scene);
+
+        hierarchy::SceneView full;
+        full.RetainDrawList = false;
+        full.UpdateDrawList(&scene);
+        if (!Equals(retained.Drawlist, full.Drawlist))
+        {
+            std::cerr << "retained: frame " << i << " differs from full build" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cerr << "usage: " << argv[0] << " [nodes] [frames]" << std::endl;
+        std::cerr << "usage: " << argv[0] << " --merge" << std::endl;
+        std::cerr << "usage: " << argv[0] << " --retained" << std::endl;
+        return 0;
+    }
+
+    hierarchy::ShaderCache cache(std::make_unique<hierarchy::StubShaderCompiler>(), {});
+    if (argc > 1 && std::string(argv[1]) == "--merge")
+    {
+        if (!CheckMerge(&cache))
+        {
+            return 1;
+        }
+        std::cout << "merge ok" << std::endl;
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--retained")
+    {
+        if (!CheckRetained(&cache))
+        {
+            return 1;
+        }
+        std::cout << "retained ok" << std::endl;
+        return 0;
+    }
+
+    int nodeCount = std::max(argc > 1 ? std::stoi(argv[1]) : 100000, ROOT_COUNT);
+    int frames = std::max(argc > 2 ? std::stoi(argv[2]) : 20, 1);
+
+    auto shader = CompileShader(&cache, NODE_WORLD_SHADER);
+    if (!shader)
+    {
+        std::cerr << "fail to compile" << std::endl;
+        return 2;
+    }
+
+    hierarchy::Scene scene;
+    CreateScene(&scene, nodeCount, ROOT_COUNT, shader);
+    std::cout << nodeCount << " nodes, " << MESH_COUNT << " meshes, " << MATERIAL_COUNT << " materials, "
+              << hierarchy::WorkerPool::Instance().ThreadCount() << " workers" << std::endl;
+
+    using clock = std::chrono::high_resolution_clock;
+    auto report = [](const char *name, const hierarchy::SceneView &view, std::vector<double> &times) {
+        std::sort(times.begin(), times.end());
+        double sum = 0;
+        for (auto t : times)
+        {
+            sum += t;
+        }
+        std::cout
+            << name << ": "
+            << view.Drawlist.Items.size() << " items, "
+            << view.DrawListTasks.size() << " tasks, "
+            << "avg " << sum / times.size() << "ms, "
+            << "min " << times.front() << "ms, "
+            << "median " << times[times.size() / 2] << "ms, "
+            << "max " << times.back() << "ms" << std::endl;
+    };
+
+    hierarchy::DrawList serial;
+    for (auto parallel : {false, true})
+    {
+        hierarchy::SceneView view;
+        view.ParallelDrawList = parallel;
+        // full build each frame
+        view.RetainDrawList = false;
+
+        std::vector<double> times;
+        times.reserve(frames);
+        for (int i = 0; i < frames; ++i)
+        {
+            hierarchy::FrameArena::NewFrame();
+            auto start = clock::now();
+            view.UpdateDrawList(&scene);
+            times.push_back(std::chrono::duration<double, std::milli>(clock::now() - start).count());
+        }
+        report(parallel ? "parallel" : "serial", view, times);
+
+        if (!parallel)
+        {
+            serial = view.Drawlist;
+        }
+        else if (!Equals(serial, view.Drawlist))
+        {
+            std::cerr << "parallel DrawList differs from serial" << std::endl;
+            return 1;
+        }
+    }
+
+    {
+        // one node is added to a root each frame. splice the segment
+        hierarchy::SceneView view;
+        hierarchy::FrameArena::NewFrame();
+        view.UpdateDrawList(&scene);
+
+        std::vector<double> times;
+        times.reserve(frames);
+        for (int i = 0; i < frames; ++i)
+        {
+            auto &root = scene.sceneNodes[i % scene.sceneNodes.size()];
+            auto node = hierarchy::SceneNode::Create("added" + std::to_string(i));
+            node->Mesh(root->Mesh());
+            root->AddChild(node);
+            node->UpdateWorld();
+
+            hierarchy::FrameArena::NewFrame();
+            auto start = clock::now();
+            view.UpdateDrawList(&scene);
+            times.push_back(std::chrono::duration<double, std::milli>(clock::now() - start).count());
+        }
+        report("retained", view, times);
+    }
+
+    return 0;
+}
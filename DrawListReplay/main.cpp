@@ -0,0 +1,105 @@
+#include <DrawListCapture.h>
+#include <NullBackend.h>
+#include <DrawListSubmitter.h>
+#include <UploadResources.h>
+#include <plog/Log.h>
+#include <plog/Appenders/ColorConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    plog::ColorConsoleAppender<plog::TxtFormatter> consoleAppender;
+    plog::init(plog::debug, &consoleAppender);
+
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " {capture} [frames] [latency] [frames_in_flight]" << std::endl;
+        return 1;
+    }
+
+    auto capture = hierarchy::DrawListCapture::LoadFromPath(argv[1]);
+    if (!capture)
+    {
+        return 2;
+    }
+    int frames = argc > 2 ? std::stoi(argv[2]) : 1000;
+    // frames in flight of simulated gpu
+    int latency = argc > 3 ? std::stoi(argv[3]) : 2;
+    // per frame buffers of submitter
+    int framesInFlight = argc > 4 ? std::stoi(argv[4]) : d12u::DrawListSubmitter::FRAME_COUNT;
+
+    auto &drawlist = capture->Drawlist;
+    std::cout
+        << drawlist.Items.size() << " items, "
+        << capture->Meshes.size() << " meshes, "
+        << capture->Materials.size() << " materials, "
+        << drawlist.CB.size() << " CB bytes, "
+        << drawlist.Instances.size() << " instances" << std::endl;
+
+    std::unordered_map<const hierarchy::SceneMaterial *, std::string> shaders;
+    for (size_t i = 0; i < capture->Materials.size(); ++i)
+    {
+        shaders.insert(std::make_pair(capture->Materials[i].get(), capture->MaterialShaders[i]));
+    }
+
+    d12u::NullBackend backend;
+    backend.Latency = latency;
+    d12u::UploadResources resources(&backend, framesInFlight);
+    resources.ShaderName = [&shaders](const hierarchy::SceneMaterial *material) {
+        return shaders[material];
+    };
+    d12u::DrawListSubmitter submitter(&backend, &resources, framesInFlight);
+
+    // first frame uploads meshes and textures
+    submitter.Submit(drawlist);
+    backend.ResetCounters();
+
+    using clock = std::chrono::high_resolution_clock;
+    std::vector<double> times;
+    times.reserve(frames);
+    for (int i = 0; i < frames; ++i)
+    {
+        auto start = clock::now();
+        submitter.Submit(drawlist);
+        times.push_back(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+    }
+    if (times.empty())
+    {
+        return 0;
+    }
+
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for (auto t : times)
+    {
+        sum += t;
+    }
+    std::cout
+        << frames << " frames: "
+        << "avg " << sum / times.size() << "us, "
+        << "min " << times.front() << "us, "
+        << "median " << times[times.size() / 2] << "us, "
+        << "max " << times.back() << "us" << std::endl;
+
+    using Type = d12u::NullBackend::CommandType;
+    auto &counters = backend.GetCounters();
+    std::cout
+        << "per frame: "
+        << counters[Type::DrawIndexedInstanced] / frames << " draws, "
+        << counters[Type::SetPipeline] / frames << " pipelines, "
+        << counters[Type::SetTexture] / frames << " textures, "
+        << counters[Type::SetVertexBuffer] / frames << " vertex buffer views, "
+        << counters.WriteBytes / frames << " upload bytes, "
+        << counters.CopyBytes / frames << " copy bytes" << std::endl;
+    std::cout
+        << "total: "
+        << counters.BuffersCreated << " buffers created, "
+        << counters.Submits << " submits, "
+        << counters.Stalls << " stalls" << std::endl;
+
+    return 0;
+}
@@ -1,21 +1,24 @@
-#pragma once
-#include <hierarchy.h>
-#include <ScreenState.h>
-
-namespace gui
-{
-
-class Gui
-{
-    class GuiImpl *m_impl = nullptr;
-
-public:
-    Gui();
-    ~Gui();
-    void Log(const char *msg);
-    void OnFrame(const screenstate::ScreenState &state, hierarchy::Scene *scene);
-    bool View(hierarchy::SceneView *view, const screenstate::ScreenState &state, size_t textureID,
-              screenstate::ScreenState *viewState);
-};
-
-} // namespace gui
+#pragma once
+#include <hierarchy.h>
+#include <ScreenState.h>
+
+class Renderer;
+
+namespace gui
+{
+
+class Gui
+{
+    class GuiImpl *m_impl = nullptr;
+
+public:
+    Gui();
+    ~Gui();
+    void Log(const char *msg);
+    // renderer: stats of the Performance window
+    void OnFrame(const screenstate::ScreenState &state, hierarchy::Scene *scene, Renderer *renderer);
+    bool View(hierarchy::SceneView *view, const screenstate::ScreenState &state, size_t textureID,
+              screenstate::ScreenState *viewState);
+};
+
+} // namespace gui
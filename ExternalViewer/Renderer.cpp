@@ -1,324 +1,372 @@
-#include "Renderer.h"
-#include "Gui/ImGuiDX12.h"
-#include <d12util.h>
-
-#include <DrawList.h>
-#include <SceneView.h>
-
-#include <plog/Log.h>
-#include <imgui.h>
-
-const UINT BACKBUFFER_COUNT = 2;
-
-template <class T>
-using ComPtr = Microsoft::WRL::ComPtr<T>;
-
-class Impl
-{
-    std::unique_ptr<d12u::SwapChain> m_swapchain;
-    std::unique_ptr<d12u::RenderTargetChain> m_backbuffer;
-    int m_width = 0;
-    int m_height = 0;
-
-    Microsoft::WRL::ComPtr<ID3D12Device> m_device;
-    std::unique_ptr<d12u::CommandQueue> m_queue;
-    std::unique_ptr<d12u::RootSignature> m_rootSignature;
-    std::unique_ptr<d12u::CommandList> m_commandlist;
-    std::unique_ptr<d12u::SceneMapper> m_sceneMapper;
-
-    ImGuiDX12 m_imguiDX12;
-
-    // scene
-    std::unique_ptr<hierarchy::SceneLight> m_light;
-
-public:
-    Impl(int maxModelCount)
-        : m_queue(new d12u::CommandQueue),
-          m_swapchain(new d12u::SwapChain),
-          m_backbuffer(new d12u::RenderTargetChain),
-          m_commandlist(new d12u::CommandList),
-          m_rootSignature(new d12u::RootSignature),
-          m_sceneMapper(new d12u::SceneMapper),
-          m_light(new hierarchy::SceneLight)
-    {
-    }
-
-    void Initialize(HWND hwnd)
-    {
-        assert(!m_device);
-
-        ComPtr<IDXGIFactory4> factory;
-        d12u::ThrowIfFailed(CreateDXGIFactory2(d12u::GetDxgiFactoryFlags(), IID_PPV_ARGS(&factory)));
-
-        ComPtr<IDXGIAdapter1> hardwareAdapter = d12u::GetHardwareAdapter(factory.Get());
-        d12u::ThrowIfFailed(D3D12CreateDevice(
-            hardwareAdapter.Get(),
-            D3D_FEATURE_LEVEL_11_0,
-            IID_PPV_ARGS(&m_device)));
-
-        m_queue->Initialize(m_device);
-        m_swapchain->Initialize(factory, m_queue->Get(), hwnd, BACKBUFFER_COUNT);
-        m_backbuffer->Initialize(m_swapchain->Get(), m_device, BACKBUFFER_COUNT);
-        m_sceneMapper->Initialize(m_device);
-        m_commandlist->InitializeDirect(m_device);
-        m_rootSignature->Initialize(m_device);
-
-        m_imguiDX12.Initialize(m_device.Get(), BACKBUFFER_COUNT);
-
-        //
-        // settings
-        // https://blog.techlab-xe.net/dx12-debug-id3d12infoqueue/
-        //
-        ComPtr<ID3D12InfoQueue> infoQueue;
-        m_device.As(&infoQueue);
-
-        D3D12_MESSAGE_ID denyIds[] = {
-            D3D12_MESSAGE_ID_CLEARRENDERTARGETVIEW_MISMATCHINGCLEARVALUE,
-        };
-        D3D12_MESSAGE_SEVERITY severities[] = {
-            D3D12_MESSAGE_SEVERITY_INFO};
-        D3D12_INFO_QUEUE_FILTER filter{};
-        filter.DenyList.NumIDs = _countof(denyIds);
-        filter.DenyList.pIDList = denyIds;
-        filter.DenyList.NumSeverities = _countof(severities);
-        filter.DenyList.pSeverityList = severities;
-
-        infoQueue->PushStorageFilter(&filter);
-
-        infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);
-    }
-
-    void BeginFrame(HWND hwnd, int width, int height)
-    {
-        UpdateBackbuffer(hwnd, width, height);
-        m_sceneMapper->Update(m_device);
-        m_rootSignature->Update(m_device);
-
-        // new frame
-        m_commandlist->Reset(nullptr);
-    }
-
-    void EndFrame()
-    {
-        auto commandList = m_commandlist->Get();
-        auto frameIndex = m_swapchain->CurrentFrameIndex();
-
-        // barrier
-        m_backbuffer->Begin(frameIndex, commandList, nullptr);
-
-        ImGui::Render();
-        m_imguiDX12.RenderDrawData(commandList.Get(), ImGui::GetDrawData());
-
-        m_backbuffer->End(frameIndex, commandList);
-
-        // execute
-        auto callbacks = m_commandlist->CloseAndGetCallbacks();
-        m_queue->Execute(commandList);
-        m_swapchain->Present();
-        m_queue->SyncFence(callbacks);
-    }
-
-    size_t ViewTextureID(const hierarchy::SceneViewPtr &sceneView)
-    {
-        // view texture for current frame
-        auto viewRenderTarget = m_sceneMapper->GetOrCreate(sceneView);
-        auto resource = viewRenderTarget->Resource(m_swapchain->CurrentFrameIndex());
-        size_t texture = resource ? m_imguiDX12.GetOrCreateTexture(m_device.Get(), resource->renderTarget.Get()) : -1;
-        return texture;
-    }
-
-    void View(const hierarchy::SceneViewPtr &sceneView)
-    {
-        auto viewRenderTarget = m_sceneMapper->GetOrCreate(sceneView);
-
-        UpdateNodes(sceneView->Drawlist);
-
-        UpdateView(viewRenderTarget, sceneView);
-
-        DrawView(m_commandlist->Get(), m_swapchain->CurrentFrameIndex(), viewRenderTarget, sceneView);
-    }
-
-private:
-    void UpdateBackbuffer(HWND hwnd, int width, int height)
-    {
-        if (m_width != width || m_height != height)
-        {
-            // recreate swapchain
-            m_queue->SyncFence();
-            m_backbuffer->Release(); // require before resize
-            m_swapchain->Resize(m_queue->Get(),
-                                hwnd, BACKBUFFER_COUNT, width, height);
-            m_backbuffer->Initialize(m_swapchain->Get(), m_device, BACKBUFFER_COUNT);
-
-            m_width = width;
-            m_height = height;
-        }
-    }
-
-    void UpdateNodes(const hierarchy::DrawList &drawlist)
-    {
-        // skins
-        for (auto &drawMesh : drawlist.Items)
-        {
-            auto mesh = drawMesh.Mesh;
-            auto drawable = m_sceneMapper->GetOrCreate(m_device, drawMesh.Mesh, nullptr);
-            if (drawable)
-            {
-                auto skin = mesh->skin;
-                if (skin)
-                {
-                    drawable->VertexBuffer()->MapCopyUnmap(
-                        skin->cpuSkiningBuffer.data(), (uint32_t)skin->cpuSkiningBuffer.size(), mesh->vertices->stride);
-                }
-                if (drawMesh.Vertices.Ptr)
-                {
-                    drawable->VertexBuffer()->MapCopyUnmap(drawMesh.Vertices.Ptr, drawMesh.Vertices.Size, drawMesh.Vertices.Stride);
-                }
-                if (drawMesh.Indices.Ptr)
-                {
-                    drawable->IndexBuffer()->MapCopyUnmap(drawMesh.Indices.Ptr, drawMesh.Indices.Size, drawMesh.Indices.Stride);
-                }
-            }
-        }
-
-        // CB
-        m_rootSignature->m_drawConstantsBuffer.Assign(drawlist.CB.data(),
-                                                      (const std::pair<UINT, UINT> *)drawlist.CBRanges.data(),
-                                                      (uint32_t)drawlist.CBRanges.size());
-        m_rootSignature->m_drawConstantsBuffer.CopyToGpu();
-    }
-
-    void UpdateView(const std::shared_ptr<d12u::RenderTargetChain> &viewRenderTarget,
-                    const hierarchy::SceneViewPtr &sceneView)
-    {
-        {
-            // auto a = sizeof(d12u::RootSignature::ViewConstants);
-            auto buffer = m_rootSignature->GetViewConstantsBuffer(0);
-            buffer->b0Projection = sceneView->Projection;
-            buffer->b0View = sceneView->View;
-            buffer->b0LightDir = m_light->LightDirection;
-            buffer->b0LightColor = m_light->LightColor;
-            buffer->b0CameraPosition = sceneView->CameraPosition;
-            buffer->fovY = sceneView->CameraFovYRadians;
-            buffer->b0ScreenSize = {(float)sceneView->Width, (float)sceneView->Height};
-            m_rootSignature->m_viewConstantsBuffer.CopyToGpu();
-        }
-
-        if (viewRenderTarget->Resize(sceneView->Width, sceneView->Height))
-        {
-            // clear all
-            for (UINT i = 0; i < BACKBUFFER_COUNT; ++i)
-            {
-                auto resource = viewRenderTarget->Resource(i);
-                if (resource)
-                {
-                    m_imguiDX12.Remove(resource->renderTarget.Get());
-                }
-            }
-            viewRenderTarget->Initialize(sceneView->Width, sceneView->Height, m_device, BACKBUFFER_COUNT);
-        }
-    }
-
-    void DrawView(const ComPtr<ID3D12GraphicsCommandList> &commandList, int frameIndex,
-                  const std::shared_ptr<d12u::RenderTargetChain> &viewRenderTarget,
-                  const hierarchy::SceneViewPtr &sceneView)
-    {
-        // clear
-        if (viewRenderTarget->Resource(frameIndex))
-        {
-            viewRenderTarget->Begin(frameIndex, commandList, sceneView->ClearColor.data());
-
-            // global settings
-            m_rootSignature->Begin(m_device, commandList);
-
-            auto &drawlist = sceneView->Drawlist.Items;
-            for (size_t i = 0; i < drawlist.size(); ++i)
-            {
-                DrawMesh(commandList, (UINT)i, drawlist[i]);
-            }
-
-            viewRenderTarget->End(frameIndex, commandList);
-        }
-    }
-
-    void DrawMesh(const ComPtr<ID3D12GraphicsCommandList> &commandList, UINT i, const hierarchy::DrawList::DrawItem &info)
-    {
-        auto &mesh = info.Mesh;
-        if (!mesh)
-        {
-            return;
-        }
-
-        auto drawable = m_sceneMapper->GetOrCreate(m_device, mesh, m_rootSignature.get());
-        if (!drawable)
-        {
-            return;
-        }
-        if (!drawable->IsDrawable(m_commandlist.get()))
-        {
-            return;
-        }
-
-        // for (auto &submesh : mesh->submeshes)
-        {
-            m_rootSignature->SetDrawDescriptorTable(m_device, commandList, i);
-
-            auto &submesh = mesh->submeshes[info.SubmeshIndex];
-            auto material = m_rootSignature->GetOrCreate(m_device, submesh.material);
-
-            // texture setup
-            if (submesh.material->colorImage)
-            {
-                auto [texture, textureSlot] = m_rootSignature->GetOrCreate(m_device, submesh.material->colorImage,
-                                                                           m_sceneMapper->GetUploader());
-                if (texture)
-                {
-                    if (texture->IsDrawable(m_commandlist.get(), 0))
-                    {
-                        m_rootSignature->SetTextureDescriptorTable(m_device, commandList, textureSlot);
-                    }
-                }
-            }
-
-            if (material->Set(commandList))
-            {
-                m_commandlist->Get()->DrawIndexedInstanced(submesh.drawCount, 1, submesh.drawOffset, 0, 0);
-            }
-        }
-    }
-};
-
-Renderer::Renderer(int maxModelCount)
-    : m_impl(new Impl(maxModelCount))
-{
-}
-
-Renderer::~Renderer()
-{
-    delete m_impl;
-}
-
-void Renderer::Initialize(void *hwnd)
-{
-    m_impl->Initialize((HWND)hwnd);
-}
-
-void Renderer::BeginFrame(void *hwnd, int width, int height)
-{
-    m_impl->BeginFrame((HWND)hwnd, width, height);
-}
-
-void Renderer::EndFrame()
-{
-    m_impl->EndFrame();
-}
-
-size_t Renderer::ViewTextureID(const std::shared_ptr<hierarchy::SceneView> &view)
-{
-    return m_impl->ViewTextureID(view);
-}
-
-void Renderer::View(const hierarchy::SceneViewPtr &view)
-{
-    m_impl->View(view);
-}
+#include "Renderer.h"
+#include "Gui/ImGuiDX12.h"
+#include <d12util.h>
+
+#include <DrawList.h>
+#include <SceneView.h>
+
+#include <frame_metrics.h>
+#include <plog/Log.h>
+#include <imgui.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+const UINT BACKBUFFER_COUNT = 2;
+// meshes and textures. unreferenced ones are released regardless of budget
+const UINT64 RESIDENCY_BUDGET = 512 * 1024 * 1024;
+
+template <class T>
+using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+class Impl
+{
+    std::unique_ptr<d12u::SwapChain> m_swapchain;
+    std::unique_ptr<d12u::RenderTargetChain> m_backbuffer;
+    int m_width = 0;
+    int m_height = 0;
+
+    Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+    std::unique_ptr<d12u::CommandQueue> m_queue;
+    // before users
+    d12u::ResidencyTracker m_residency{RESIDENCY_BUDGET, BACKBUFFER_COUNT};
+    std::unique_ptr<d12u::RootSignature> m_rootSignature;
+    std::unique_ptr<d12u::SceneMapper> m_sceneMapper;
+
+    ImGuiDX12 m_imguiDX12;
+
+    // frames in flight. slot is the backbuffer index
+    struct Frame
+    {
+        std::unique_ptr<d12u::CommandList> CommandList;
+    };
+    std::array<Frame, BACKBUFFER_COUNT> m_frames;
+    d12u::FrameRing m_frameRing{BACKBUFFER_COUNT};
+    Frame &CurrentFrame() { return m_frames[m_frameRing.Index()]; }
+    d12u::CommandList *CurrentCommandList() { return CurrentFrame().CommandList.get(); }
+
+    // DrawList on the frame CommandList. after m_queue
+    std::unique_ptr<d12u::D3D12Backend> m_backend;
+    std::unique_ptr<d12u::D3D12SceneResources> m_resources;
+    std::unique_ptr<d12u::DrawListSubmitter> m_submitter;
+
+    // scene
+    std::unique_ptr<hierarchy::SceneLight> m_light;
+
+public:
+    Impl(int maxModelCount)
+        : m_queue(new d12u::CommandQueue),
+          m_swapchain(new d12u::SwapChain),
+          m_backbuffer(new d12u::RenderTargetChain),
+          m_rootSignature(new d12u::RootSignature(BACKBUFFER_COUNT, &m_residency)),
+          m_sceneMapper(new d12u::SceneMapper(BACKBUFFER_COUNT, &m_residency)),
+          m_light(new hierarchy::SceneLight)
+    {
+        for (auto &frame : m_frames)
+        {
+            frame.CommandList.reset(new d12u::CommandList);
+        }
+    }
+
+    ~Impl()
+    {
+        WaitIdle();
+    }
+
+    void Initialize(HWND hwnd)
+    {
+        assert(!m_device);
+
+        ComPtr<IDXGIFactory4> factory;
+        d12u::ThrowIfFailed(CreateDXGIFactory2(d12u::GetDxgiFactoryFlags(), IID_PPV_ARGS(&factory)));
+
+        ComPtr<IDXGIAdapter1> hardwareAdapter = d12u::GetHardwareAdapter(factory.Get());
+        d12u::ThrowIfFailed(D3D12CreateDevice(
+            hardwareAdapter.Get(),
+            D3D_FEATURE_LEVEL_11_0,
+            IID_PPV_ARGS(&m_device)));
+
+        m_queue->Initialize(m_device);
+        m_swapchain->Initialize(factory, m_queue->Get(), hwnd, BACKBUFFER_COUNT);
+        m_backbuffer->Initialize(m_swapchain->Get(), m_device, BACKBUFFER_COUNT);
+        m_sceneMapper->Initialize(m_device);
+        for (auto &frame : m_frames)
+        {
+            frame.CommandList->InitializeDirect(m_device);
+        }
+        m_rootSignature->Initialize(m_device, std::filesystem::current_path() / "pipeline_cache.bin",
+                                    std::filesystem::current_path() / "texture_cache");
+
+        m_imguiDX12.Initialize(m_device.Get(), BACKBUFFER_COUNT);
+
+        m_backend.reset(new d12u::D3D12Backend(m_device, m_queue.get(), m_rootSignature.get(), BACKBUFFER_COUNT));
+        m_resources.reset(new d12u::D3D12SceneResources(m_device, m_backend.get(), m_sceneMapper.get(), m_rootSignature.get()));
+        m_submitter.reset(new d12u::DrawListSubmitter(m_backend.get(), m_resources.get(), BACKBUFFER_COUNT));
+
+        //
+        // settings
+        // https://blog.techlab-xe.net/dx12-debug-id3d12infoqueue/
+        //
+        ComPtr<ID3D12InfoQueue> infoQueue;
+        m_device.As(&infoQueue);
+
+        D3D12_MESSAGE_ID denyIds[] = {
+            D3D12_MESSAGE_ID_CLEARRENDERTARGETVIEW_MISMATCHINGCLEARVALUE,
+        };
+        D3D12_MESSAGE_SEVERITY severities[] = {
+            D3D12_MESSAGE_SEVERITY_INFO};
+        D3D12_INFO_QUEUE_FILTER filter{};
+        filter.DenyList.NumIDs = _countof(denyIds);
+        filter.DenyList.pIDList = denyIds;
+        filter.DenyList.NumSeverities = _countof(severities);
+        filter.DenyList.pSeverityList = severities;
+
+        infoQueue->PushStorageFilter(&filter);
+
+        infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);
+    }
+
+    void BeginFrame(HWND hwnd, int width, int height)
+    {
+        UpdateBackbuffer(hwnd, width, height);
+
+        // wait the last use of this slot. then reuse its allocator and buffers
+        auto fence = m_frameRing.Acquire(m_swapchain->CurrentFrameIndex());
+        if (fence)
+        {
+            m_queue->Wait(fence);
+        }
+        auto &frame = CurrentFrame();
+        m_backend->Retire(m_queue->CurrentValue());
+        m_submitter->Retire(m_queue->CurrentValue());
+        d12u::PlacedAllocator::Instance().Retire(m_queue->CurrentValue());
+
+        // frames before the previous use of this slot are completed
+        m_residency.NewFrame();
+        m_residency.Evict();
+
+        m_sceneMapper->Update(m_device);
+        m_rootSignature->Update(m_device);
+        m_rootSignature->BeginFrame(m_frameRing.Index(), m_queue->CurrentValue());
+
+        // new frame
+        frame.CommandList->Reset(nullptr);
+        m_backend->Begin(frame.CommandList.get(), m_frameRing.Index());
+        m_resources->Begin(frame.CommandList.get());
+    }
+
+    void EndFrame()
+    {
+        auto &frame = CurrentFrame();
+        auto commandList = frame.CommandList->Get();
+        auto frameIndex = m_frameRing.Index();
+
+        // barrier
+        m_backbuffer->Begin(frameIndex, commandList, nullptr);
+
+        ImGui::Render();
+        m_imguiDX12.RenderDrawData(commandList.Get(), ImGui::GetDrawData());
+
+        m_backbuffer->End(frameIndex, commandList);
+
+        // execute. not wait. BeginFrame of the same slot waits this fence
+        auto fence = m_backend->Submit();
+        m_submitter->Close(fence);
+        m_frameRing.Release(fence);
+        m_rootSignature->EndFrame(fence);
+        d12u::PlacedAllocator::Instance().Close(fence);
+        m_swapchain->Present();
+
+        TraceCounters();
+    }
+
+    size_t ViewTextureID(const hierarchy::SceneViewPtr &sceneView)
+    {
+        // view texture for current frame
+        auto viewRenderTarget = m_sceneMapper->GetOrCreate(sceneView);
+        auto resource = viewRenderTarget->Resource(m_frameRing.Index());
+        size_t texture = resource ? m_imguiDX12.GetOrCreateTexture(m_device.Get(), resource->renderTarget.Get()) : -1;
+        return texture;
+    }
+
+    void View(const hierarchy::SceneViewPtr &sceneView)
+    {
+        auto viewRenderTarget = m_sceneMapper->GetOrCreate(sceneView);
+
+        UpdateNodes(sceneView->Drawlist);
+
+        UpdateView(viewRenderTarget, sceneView);
+
+        DrawView(CurrentCommandList()->Get(), m_frameRing.Index(), viewRenderTarget, sceneView);
+    }
+
+    d12u::Uploader *Uploader() { return m_sceneMapper->GetUploader(); }
+    d12u::DescriptorAllocator *Descriptors() { return m_rootSignature->Descriptors(); }
+    d12u::PipelineCache *Pipelines() { return m_rootSignature->Pipelines(); }
+    d12u::ResidencyTracker *Residency() { return &m_residency; }
+    hierarchy::TextureCache *Textures() { return m_rootSignature->Textures(); }
+
+private:
+    // write_trace tracks
+    void TraceCounters()
+    {
+        auto &uploads = Uploader()->LastStats();
+        frame_metrics::set_counter("upload_bytes", (double)uploads.Bytes);
+        frame_metrics::set_counter("upload_pending_bytes", (double)uploads.PendingBytes);
+        frame_metrics::set_counter("pending_uploads", uploads.Pending);
+        frame_metrics::set_counter("pending_pipelines", Pipelines()->GetStats().Pending);
+        if (auto textures = Textures())
+        {
+            frame_metrics::set_counter("pending_textures", textures->GetStats().Pending);
+        }
+        auto residency = m_residency.GetStats();
+        frame_metrics::set_counter("resident_mesh_bytes", (double)residency.Bytes[(size_t)d12u::ResidencyCategory::Mesh]);
+        frame_metrics::set_counter("resident_texture_bytes", (double)residency.Bytes[(size_t)d12u::ResidencyCategory::Texture]);
+    }
+
+    // all frames completed
+    void WaitIdle()
+    {
+        m_queue->SyncFence();
+        if (m_backend)
+        {
+            m_backend->Retire(m_queue->CurrentValue());
+            m_submitter->Retire(m_queue->CurrentValue());
+        }
+        m_frameRing.Reset();
+        d12u::PlacedAllocator::Instance().Retire(m_queue->CurrentValue());
+    }
+
+    void UpdateBackbuffer(HWND hwnd, int width, int height)
+    {
+        if (m_width != width || m_height != height)
+        {
+            // recreate swapchain
+            WaitIdle();
+            m_backbuffer->Release(); // require before resize
+            m_swapchain->Resize(m_queue->Get(),
+                                hwnd, BACKBUFFER_COUNT, width, height);
+            m_backbuffer->Initialize(m_swapchain->Get(), m_device, BACKBUFFER_COUNT);
+
+            m_width = width;
+            m_height = height;
+        }
+    }
+
+    void UpdateNodes(const hierarchy::DrawList &drawlist)
+    {
+        // CB slots and instances of this frame slot
+        m_submitter->Update(drawlist, m_frameRing.Index());
+    }
+
+    void UpdateView(const std::shared_ptr<d12u::RenderTargetChain> &viewRenderTarget,
+                    const hierarchy::SceneViewPtr &sceneView)
+    {
+        {
+            // auto a = sizeof(d12u::RootSignature::ViewConstants);
+            auto buffer = m_rootSignature->GetViewConstantsBuffer();
+            buffer->b0Projection = sceneView->Projection;
+            buffer->b0View = sceneView->View;
+            buffer->b0LightDir = m_light->LightDirection;
+            buffer->b0LightColor = m_light->LightColor;
+            buffer->b0CameraPosition = sceneView->CameraPosition;
+            buffer->fovY = sceneView->CameraFovYRadians;
+            buffer->b0ScreenSize = {(float)sceneView->Width, (float)sceneView->Height};
+            m_rootSignature->CopyViewConstantsToGpu();
+        }
+
+        if (viewRenderTarget->Resize(sceneView->Width, sceneView->Height))
+        {
+            // other slots may be in flight. EndFrame does not wait
+            WaitIdle();
+            // clear all
+            for (UINT i = 0; i < BACKBUFFER_COUNT; ++i)
+            {
+                auto resource = viewRenderTarget->Resource(i);
+                if (resource)
+                {
+                    m_imguiDX12.Remove(resource->renderTarget.Get());
+                }
+            }
+            viewRenderTarget->Initialize(sceneView->Width, sceneView->Height, m_device, BACKBUFFER_COUNT);
+        }
+    }
+
+    void DrawView(const ComPtr<ID3D12GraphicsCommandList> &commandList, int frameIndex,
+                  const std::shared_ptr<d12u::RenderTargetChain> &viewRenderTarget,
+                  const hierarchy::SceneViewPtr &sceneView)
+    {
+        // clear
+        if (viewRenderTarget->Resource(frameIndex))
+        {
+            viewRenderTarget->Begin(frameIndex, commandList, sceneView->ClearColor.data());
+
+            // global settings
+            m_rootSignature->Begin(m_device, commandList);
+
+            m_submitter->Draw(sceneView->Drawlist, frameIndex);
+
+            viewRenderTarget->End(frameIndex, commandList);
+        }
+    }
+};
+
+Renderer::Renderer(int maxModelCount)
+    : m_impl(new Impl(maxModelCount))
+{
+}
+
+Renderer::~Renderer()
+{
+    delete m_impl;
+}
+
+void Renderer::Initialize(void *hwnd)
+{
+    m_impl->Initialize((HWND)hwnd);
+}
+
+void Renderer::BeginFrame(void *hwnd, int width, int height)
+{
+    m_impl->BeginFrame((HWND)hwnd, width, height);
+}
+
+void Renderer::EndFrame()
+{
+    m_impl->EndFrame();
+}
+
+size_t Renderer::ViewTextureID(const std::shared_ptr<hierarchy::SceneView> &view)
+{
+    return m_impl->ViewTextureID(view);
+}
+
+void Renderer::View(const hierarchy::SceneViewPtr &view)
+{
+    m_impl->View(view);
+}
+
+d12u::Uploader *Renderer::Uploader()
+{
+    return m_impl->Uploader();
+}
+
+d12u::DescriptorAllocator *Renderer::Descriptors()
+{
+    return m_impl->Descriptors();
+}
+
+d12u::PipelineCache *Renderer::Pipelines()
+{
+    return m_impl->Pipelines();
+}
+
+d12u::ResidencyTracker *Renderer::Residency()
+{
+    return m_impl->Residency();
+}
+
+hierarchy::TextureCache *Renderer::Textures()
+{
+    return m_impl->Textures();
+}
@@ -1,24 +1,40 @@
-#pragma once
-#include <memory>
-
-namespace hierarchy
-{
-struct DrawList;
-struct SceneView;
-} // namespace hierarchy
-
-class Renderer
-{
-    class Impl *m_impl = nullptr;
-
-public:
-    Renderer(int maxModelCount);
-    ~Renderer();
-    void Initialize(void *hwnd);
-
-    void BeginFrame(void *hwnd, int width, int height);
-    void EndFrame();
-
-    size_t ViewTextureID(const std::shared_ptr<hierarchy::SceneView> &view);
-    void View(const std::shared_ptr<hierarchy::SceneView> &view);
-};
+#pragma once
+#include <memory>
+
+namespace hierarchy
+{
+struct DrawList;
+struct SceneView;
+class TextureCache;
+} // namespace hierarchy
+
+namespace d12u
+{
+class Uploader;
+class DescriptorAllocator;
+class PipelineCache;
+class ResidencyTracker;
+} // namespace d12u
+
+class Renderer
+{
+    class Impl *m_impl = nullptr;
+
+public:
+    Renderer(int maxModelCount);
+    ~Renderer();
+    void Initialize(void *hwnd);
+
+    void BeginFrame(void *hwnd, int width, int height);
+    void EndFrame();
+
+    size_t ViewTextureID(const std::shared_ptr<hierarchy::SceneView> &view);
+    void View(const std::shared_ptr<hierarchy::SceneView> &view);
+
+    // owners of the stats for Gui
+    d12u::Uploader *Uploader();
+    d12u::DescriptorAllocator *Descriptors();
+    d12u::PipelineCache *Pipelines();
+    d12u::ResidencyTracker *Residency();
+    hierarchy::TextureCache *Textures();
+};
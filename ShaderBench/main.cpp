@@ -0,0 +1,314 @@
+#include <ConstantSemanticParser.h>
+#include <ShaderCache.h>
+#include <StubShaderCompiler.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string.h>
+#include <vector>
+
+static const char *SEMANTICS[] = {
+    "RENDERTARGET_SIZE",
+    "CAMERA_VIEW",
+    "CAMERA_PROJECTION",
+    "CAMERA_POSITION",
+    "CAMERA_FOVY",
+    "LIGHT_DIRECTION",
+    "LIGHT_COLOR",
+    "NODE_WORLD",
+};
+
+// many cbuffers, commented out declarations, macros and function bodies
+static std::string Synthetic(int buffers, std::vector<std::string> *names)
+{
+    std::string source;
+    for (int i = 0; i < buffers; ++i)
+    {
+        auto b = std::to_string(i);
+        source += "// float4x4 c" + b + "_0 : NODE_WORLD;\n";
+        source += "#define DECLARE_" + b + "(x) \\\n    float4 x : CAMERA_VIEW;\n";
+        source += "cbuffer Buffer" + b + " : register(b" + std::to_string(i % 14) + ")\n{\n";
+        for (int j = 0; j < 8; ++j)
+        {
+            auto name = "c" + b + "_" + std::to_string(j);
+            source += "    float4x4 " + name + " : " + SEMANTICS[(i + j) % 8] + ";\n";
+            names->push_back(name);
+        }
+        source += "};\n";
+        source += "float4 Func" + b + "(float4 p : POSITION) : SV_POSITION\n{\n"
+                  "    /* c" + b + "_1 : LIGHT_COLOR */\n    return mul(c" + b + "_0, p);\n}\n";
+    }
+    return source;
+}
+
+// known answers. returns false if broken
+static bool Check()
+{
+    auto map = hierarchy::ParseConstantSemantics(R"(
+#define DECLARE(x) \
+    float4 macro : CAMERA_VIEW;
+// float4 line : LIGHT_COLOR;
+/* float4 block : LIGHT_COLOR; */
+struct VSInput { float4 position : POSITION; float3 normal : NORMAL; };
+cbuffer SceneConstantBuffer : register(b0)
+{
+    float4x4 b0View : CAMERA_VIEW;
+    float3 b0LightDir : LIGHT_DIRECTION, b0LightColor : LIGHT_COLOR;
+    float2 size[2] : RENDERTARGET_SIZE : packoffset(c10);
+    float b0Fovy : register(c11);
+};
+cbuffer NodeConstantBuffer : register(b1) { float4x4 b1World : WORLD : NODE_WORLD; }
+float4 gPosition : CAMERA_POSITION = {1, 2, 3, 4};
+float4 VSMain(VSInput i) : SV_POSITION { float4 local : LIGHT_COLOR; return 0; }
+float4x4 b0View : NODE_WORLD;
+)");
+    const std::pair<const char *, hierarchy::ConstantSemantics> expected[] = {
+        {"b0View", hierarchy::ConstantSemantics::CAMERA_VIEW},
+        {"b0LightDir", hierarchy::ConstantSemantics::LIGHT_DIRECTION},
+        {"b0LightColor", hierarchy::ConstantSemantics::LIGHT_COLOR},
+        {"size", hierarchy::ConstantSemantics::RENDERTARGET_SIZE},
+        {"b1World", hierarchy::ConstantSemantics::NODE_WORLD},
+        {"gPosition", hierarchy::ConstantSemantics::CAMERA_POSITION},
+    };
+    bool ok = map.size() == std::size(expected);
+    for (auto [name, semantic] : expected)
+    {
+        auto found = map.find(name);
+        if (found == map.end() || found->second != semantic)
+        {
+            std::cerr << name << ": " << (found == map.end() ? -1 : (int)found->second) << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static bool Equals(const std::vector<hierarchy::ConstantBuffer> &l, const std::vector<hierarchy::ConstantBuffer> &r)
+{
+    if (l.size() != r.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < l.size(); ++i)
+    {
+        if (l[i].reg != r[i].reg || l[i].Variables.size() != r[i].Variables.size())
+        {
+            return false;
+        }
+        for (size_t j = 0; j < l[i].Variables.size(); ++j)
+        {
+            auto &a = l[i].Variables[j];
+            auto &b = r[i].Variables[j];
+            if (a.Name != b.Name || a.Semantic != b.Semantic || a.Offset != b.Offset || a.Size != b.Size)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool Equals(const hierarchy::ShaderBinary &l, const hierarchy::ShaderBinary &r)
+{
+    if (l.VS != r.VS || l.PS != r.PS || l.Inputs.size() != r.Inputs.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < l.Inputs.size(); ++i)
+    {
+        if (l.Inputs[i].Semantic != r.Inputs[i].Semantic || l.Inputs[i].SemanticIndex != r.Inputs[i].SemanticIndex ||
+            l.Inputs[i].Format != r.Inputs[i].Format)
+        {
+            return false;
+        }
+    }
+    return Equals(l.VSConstants, r.VSConstants) && Equals(l.PSConstants, r.PSConstants);
+}
+
+// memory, disk and magic of ShaderCache with StubShaderCompiler. returns false if broken
+static bool CheckCache()
+{
+    std::error_code ec;
+    auto directory = std::filesystem::temp_directory_path(ec) / "ShaderBench_cache";
+    std::filesystem::remove_all(directory, ec);
+
+    auto include = [](const std::string &path, std::string *source) {
+        if (path != "common.hlsli")
+        {
+            return false;
+        }
+        *source = "cbuffer NodeConstantBuffer : register(b1) { float4x4 b1World : NODE_WORLD; };";
+        return true;
+    };
+    const std::string source = "#include \"common.hlsli\"\nfloat4 b1Color : LIGHT_COLOR;\n";
+    auto failed = [](const char *message) {
+        std::cerr << "cache: " << message << std::endl;
+        return false;
+    };
+
+    std::shared_ptr<const hierarchy::ShaderBinary> compiled;
+    {
+        hierarchy::ShaderCache cache(std::make_unique<hierarchy::StubShaderCompiler>(), directory);
+        std::string error;
+        compiled = cache.GetOrCompile("check", source, include, &error);
+        if (!compiled || compiled->VSConstants.empty() || compiled->VSConstants[0].Variables.size() != 2)
+        {
+            return failed(("compile " + error).c_str());
+        }
+        if (cache.GetOrCompile("check", source, include, &error) != compiled)
+        {
+            return failed("memory hit is not same binary");
+        }
+        if (cache.GetOrCompile("check", "#error\n", include, &error) || error.empty())
+        {
+            return failed("#error compiled");
+        }
+        if (cache.GetOrCompile("check", "#include \"missing.hlsli\"\n", include, &error))
+        {
+            return failed("missing include compiled");
+        }
+        auto stats = cache.GetStats();
+        if (stats.Requests != 4 || stats.MemoryHits != 1 || stats.Compiles != 1 || stats.Failures != 2)
+        {
+            return failed("stats");
+        }
+    }
+
+    // new process
+    std::filesystem::path file;
+    {
+        hierarchy::ShaderCache cache(std::make_unique<hierarchy::StubShaderCompiler>(), directory);
+        std::string error;
+        auto loaded = cache.GetOrCompile("check", source, include, &error);
+        if (!loaded || !Equals(*loaded, *compiled) || cache.GetStats().DiskHits != 1)
+        {
+            return failed("disk round-trip");
+        }
+        for (auto &entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            file = entry.path();
+        }
+    }
+
+    // serialized bytes
+    auto bytes = hierarchy::ShaderCache::Serialize(*compiled);
+    hierarchy::ShaderBinary binary;
+    if (!hierarchy::ShaderCache::Deserialize(bytes, &binary) || !Equals(binary, *compiled))
+    {
+        return failed("serialize round-trip");
+    }
+    for (size_t size = 0; size < bytes.size(); size += 7)
+    {
+        if (hierarchy::ShaderCache::Deserialize(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size), &binary))
+        {
+            return failed("truncated bytes accepted");
+        }
+    }
+    {
+        // Inputs count beyond the bytes
+        auto broken = bytes;
+        auto inputs = 4 + 4 + compiled->VS.size() + 4 + compiled->PS.size();
+        memset(broken.data() + inputs, 0xff, 4);
+        if (hierarchy::ShaderCache::Deserialize(broken, &binary))
+        {
+            return failed("invalid count accepted");
+        }
+    }
+
+    // old magic on disk is compiled again
+    {
+        auto broken = bytes;
+        broken[0] ^= 0xff;
+        if (hierarchy::ShaderCache::Deserialize(broken, &binary))
+        {
+            return failed("magic accepted");
+        }
+        std::ofstream(file, std::ios::binary).write((const char *)broken.data(), broken.size());
+        hierarchy::ShaderCache cache(std::make_unique<hierarchy::StubShaderCompiler>(), directory);
+        std::string error;
+        auto recompiled = cache.GetOrCompile("check", source, include, &error);
+        auto stats = cache.GetStats();
+        if (!recompiled || !Equals(*recompiled, *compiled) || stats.Compiles != 1 || stats.DiskHits != 0)
+        {
+            return failed("magic mismatch is not compiled");
+        }
+    }
+
+    std::filesystem::remove_all(directory, ec);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "--cache")
+    {
+        if (!CheckCache())
+        {
+            return 1;
+        }
+        std::cout << "cache ok" << std::endl;
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--check")
+    {
+        if (!Check())
+        {
+            return 1;
+        }
+        std::cout << "check ok" << std::endl;
+        return 0;
+    }
+
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    };
+
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::ifstream ifs(argv[i], std::ios::binary);
+            std::string source((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+            auto start = clock::now();
+            auto map = hierarchy::ParseConstantSemantics(source);
+            auto elapsed = ms(start);
+            std::cout << argv[i] << ": " << map.size() << " semantics, " << elapsed << "ms" << std::endl;
+            for (auto &[name, semantic] : map)
+            {
+                std::cout << "    " << name << " : " << SEMANTICS[(int)semantic - 1] << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    for (auto buffers : {16, 256, 4096})
+    {
+        std::vector<std::string> names;
+        auto source = Synthetic(buffers, &names);
+        auto start = clock::now();
+        auto map = hierarchy::ParseConstantSemantics(source);
+        auto elapsed = ms(start);
+        size_t matched = 0;
+        for (auto &name : names)
+        {
+            matched += map.count(name);
+        }
+        std::cout
+            << source.size() / 1024 << "KB, "
+            << names.size() << " variables: "
+            << elapsed << "ms, "
+            << source.size() / (1024.0 * 1024.0) / (elapsed / 1000) << "MB/s, "
+            << matched << "/" << map.size() << " matched" << std::endl;
+        if (matched != names.size() || map.size() != names.size())
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include <TextureProcessor.h>
+#include <TextureCache.h>
+#include <SceneImage.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <math.h>
+#include <string.h>
+#include <string>
+
+// gradients, noise and hard edges
+static std::vector<uint8_t> Synthetic(int width, int height)
+{
+    std::vector<uint8_t> rgba(width * height * 4);
+    uint32_t seed = 1;
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            auto p = &rgba[(y * width + x) * 4];
+            p[0] = (uint8_t)(x * 255 / width);
+            p[1] = (uint8_t)(y * 255 / height);
+            p[2] = ((x / 32 + y / 32) & 1) ? 220 : 40;
+            p[3] = (uint8_t)(128 + 127 * sinf(x * 0.05f) * cosf(y * 0.05f));
+            p[2] = (uint8_t)std::min(255, p[2] + (int)(seed >> 28));
+        }
+    }
+    return rgba;
+}
+
+static bool CheckLevel(const hierarchy::TextureLevel &level, hierarchy::TextureFormat format, uint32_t width, uint32_t height)
+{
+    auto blockSize = format == hierarchy::TextureFormat::RGBA8 ? 1u : 4u;
+    auto columns = std::max((width + blockSize - 1) / blockSize, 1u);
+    auto rows = std::max((height + blockSize - 1) / blockSize, 1u);
+    if (level.Width != width || level.Height != height ||
+        level.RowBytes != columns * hierarchy::BlockBytes(format) || level.Rows != rows ||
+        level.RowPitch % hierarchy::TEXTURE_PITCH_ALIGNMENT || level.RowPitch < level.RowBytes ||
+        level.RowPitch >= level.RowBytes + hierarchy::TEXTURE_PITCH_ALIGNMENT ||
+        level.Bytes.size() != (size_t)level.RowPitch * level.Rows)
+    {
+        std::cerr << "layout " << (int)format << " " << width << "x" << height << ": "
+                  << level.RowBytes << " bytes x " << level.Rows << " rows, pitch " << level.RowPitch << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// pitched layout of odd sizes. returns false if broken
+static bool CheckLayout()
+{
+    static const uint32_t SIZES[] = {1, 2, 3, 4, 5, 7, 8, 12, 13, 31, 63, 64, 65, 67, 100, 127, 129, 257};
+    bool ok = true;
+    for (auto width : SIZES)
+    {
+        for (auto height : SIZES)
+        {
+            auto rgba = Synthetic(width, height);
+            auto level = hierarchy::CreateLevel(rgba.data(), width, height);
+            ok &= CheckLevel(level, hierarchy::TextureFormat::RGBA8, width, height);
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                if (memcmp(level.Bytes.data() + y * level.RowPitch, rgba.data() + y * width * 4, width * 4))
+                {
+                    std::cerr << "CreateLevel " << width << "x" << height << ": row " << y << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+
+            for (auto format : {
+                     hierarchy::TextureFormat::RGBA8,
+                     hierarchy::TextureFormat::BC1,
+                     hierarchy::TextureFormat::BC3,
+                     hierarchy::TextureFormat::BC7,
+                 })
+            {
+                auto texture = hierarchy::ProcessTexture(rgba.data(), width, height, {.Format = format});
+                if (texture->Levels.size() != hierarchy::MipCount(width, height))
+                {
+                    std::cerr << "mips " << width << "x" << height << ": " << texture->Levels.size() << std::endl;
+                    ok = false;
+                }
+                for (uint32_t i = 0; i < texture->Levels.size(); ++i)
+                {
+                    ok &= CheckLevel(texture->Levels[i], texture->Format,
+                                     std::max(width >> i, 1u), std::max(height >> i, 1u));
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// cache bytes. broken count and format are rejected. returns false if broken
+static bool CheckSerialize()
+{
+    auto rgba = Synthetic(67, 13);
+    auto texture = hierarchy::ProcessTexture(rgba.data(), 67, 13, {.Format = hierarchy::TextureFormat::BC1});
+    auto bytes = hierarchy::TextureCache::Serialize(*texture);
+    hierarchy::ProcessedTexture loaded;
+    if (!hierarchy::TextureCache::Deserialize(bytes, &loaded) || loaded.Format != texture->Format ||
+        loaded.Levels.size() != texture->Levels.size())
+    {
+        std::cerr << "serialize round-trip" << std::endl;
+        return false;
+    }
+
+    // magic, format, count
+    for (auto [offset, value] : {std::make_pair(4, 0xffu), std::make_pair(8, 0xffffffffu)})
+    {
+        auto broken = bytes;
+        memcpy(broken.data() + offset, &value, 4);
+        if (hierarchy::TextureCache::Deserialize(broken, &loaded))
+        {
+            std::cerr << "broken " << offset << " accepted" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "--layout")
+    {
+        if (!CheckLayout() || !CheckSerialize())
+        {
+            return 1;
+        }
+        std::cout << "layout ok" << std::endl;
+        return 0;
+    }
+
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    };
+
+    std::vector<uint8_t> rgba;
+    int width = 1024;
+    int height = 1024;
+    if (argc > 1)
+    {
+        std::ifstream ifs(argv[1], std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        auto image = hierarchy::SceneImage::Load(bytes.data(), (int)bytes.size());
+        if (!image)
+        {
+            std::cerr << "fail to load " << argv[1] << std::endl;
+            return 2;
+        }
+        rgba = image->buffer;
+        width = image->width;
+        height = image->height;
+    }
+    else
+    {
+        rgba = Synthetic(width, height);
+    }
+    auto level = hierarchy::CreateLevel(rgba.data(), width, height);
+    auto mb = level.Bytes.size() / (1024.0 * 1024.0);
+    std::cout << width << "x" << height << std::endl;
+
+    {
+        auto start = clock::now();
+        auto mips = hierarchy::ProcessTexture(rgba.data(), width, height, {.Format = hierarchy::TextureFormat::RGBA8});
+        std::cout << "mips: " << mips->Levels.size() << " levels, " << ms(start) << "ms" << std::endl;
+    }
+
+    if (width % 4 || height % 4)
+    {
+        std::cout << "BC requires multiple of 4" << std::endl;
+        return 0;
+    }
+
+    for (auto [format, label] : {
+             std::make_pair(hierarchy::TextureFormat::BC1, "BC1"),
+             std::make_pair(hierarchy::TextureFormat::BC3, "BC3"),
+             std::make_pair(hierarchy::TextureFormat::BC7, "BC7"),
+         })
+    {
+        auto start = clock::now();
+        auto encoded = hierarchy::EncodeLevel(level, format);
+        auto elapsed = ms(start);
+        auto decoded = hierarchy::DecodeLevel(encoded, format);
+        std::cout
+            << label << ": "
+            << elapsed << "ms, "
+            << mb / (elapsed / 1000) << "MB/s, "
+            << "PSNR rgb " << hierarchy::PSNR(level, decoded, 3) << "dB, "
+            << "rgba " << hierarchy::PSNR(level, decoded) << "dB" << std::endl;
+    }
+
+    return 0;
+}
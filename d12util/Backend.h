@@ -0,0 +1,71 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+
+namespace d12u
+{
+
+//
+// hardware independent render backend. no d3d12.h
+//
+// handles are 1 origin. 0 is invalid
+// textures and pipelines are made by the implementation. NullBackend::CreateTexture, D3D12Backend::Import
+//
+using BufferHandle = uint32_t;
+using TextureHandle = uint32_t;
+using PipelineHandle = uint32_t;
+
+enum class BufferUsage
+{
+    // gpu only. write by CopyBuffer
+    Default,
+    // cpu write. WriteBuffer
+    Upload,
+};
+
+class Backend
+{
+    Backend(const Backend &) = delete;
+    Backend &operator=(const Backend &) = delete;
+
+protected:
+    Backend() = default;
+
+public:
+    virtual ~Backend() = default;
+
+    //
+    // resources
+    //
+    virtual BufferHandle CreateBuffer(BufferUsage usage, uint64_t byteLength, const std::wstring &name) = 0;
+    virtual void DestroyBuffer(BufferHandle buffer) = 0;
+    // Upload buffer only
+    virtual void WriteBuffer(BufferHandle buffer, uint64_t offset, const void *p, uint64_t byteLength) = 0;
+    // recorded command
+    virtual void CopyBuffer(BufferHandle dst, uint64_t dstOffset, BufferHandle src, uint64_t srcOffset, uint64_t byteLength) = 0;
+
+    //
+    // command recording. state is kept until set again
+    //
+    // 0 skips draws
+    virtual void SetPipeline(PipelineHandle pipeline) = 0;
+    // b1: draw constants. 256 byte aligned offset and byteLength
+    virtual void SetDrawConstants(BufferHandle buffer, uint64_t offset, uint32_t byteLength) = 0;
+    // t0. 0 is none
+    virtual void SetTexture(TextureHandle texture) = 0;
+    virtual void SetVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) = 0;
+    virtual void SetIndexBuffer(BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) = 0;
+    virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                      uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) = 0;
+
+    //
+    // fence
+    //
+    // execute recorded commands. return fence value signaled when completed
+    virtual uint64_t Submit() = 0;
+    virtual uint64_t CompletedValue() = 0;
+    // block until CompletedValue() >= fenceValue
+    virtual void Wait(uint64_t fenceValue) = 0;
+};
+
+} // namespace d12u
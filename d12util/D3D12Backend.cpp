@@ -0,0 +1,247 @@
+#include "D3D12Backend.h"
+#include "CommandQueue.h"
+#include "CommandList.h"
+#include "ResourceItem.h"
+#include "RootSignature.h"
+#include "Material.h"
+#include <algorithm>
+
+namespace d12u
+{
+
+// imported in the current frame
+static const uint32_t FRAME_HANDLE = 0x80000000;
+
+D3D12Backend::D3D12Backend(const ComPtr<ID3D12Device> &device, CommandQueue *queue, RootSignature *rootSignature,
+                           uint32_t frameCount)
+    : m_device(device), m_queue(queue), m_rootSignature(rootSignature), m_frames(std::max(frameCount, 1u))
+{
+}
+
+D3D12Backend::~D3D12Backend()
+{
+}
+
+void D3D12Backend::Begin(CommandList *commandList, uint32_t frameIndex)
+{
+    m_commandList = commandList;
+    m_frameIndex = frameIndex % (uint32_t)m_frames.size();
+    m_frames[m_frameIndex] = {};
+
+    m_pipeline = nullptr;
+    m_pipelineReady = false;
+    m_drawConstants = 0;
+    m_drawConstantsBytes = 0;
+    m_texture = {};
+}
+
+void D3D12Backend::Retire(uint64_t completedValue)
+{
+    // in submit order
+    auto callbacks = std::stable_partition(m_callbacks.begin(), m_callbacks.end(), [completedValue](const auto &callback) {
+        return callback.first <= completedValue;
+    });
+    for (auto it = m_callbacks.begin(); it != callbacks; ++it)
+    {
+        it->second();
+    }
+    m_callbacks.erase(m_callbacks.begin(), callbacks);
+
+    auto end = std::remove_if(m_released.begin(), m_released.end(), [completedValue](const auto &released) {
+        return released.first != 0 && released.first <= completedValue;
+    });
+    m_released.erase(end, m_released.end());
+}
+
+std::shared_ptr<ResourceItem> D3D12Backend::GetBuffer(BufferHandle buffer) const
+{
+    if (!buffer)
+    {
+        return nullptr;
+    }
+    if (buffer & FRAME_HANDLE)
+    {
+        return m_frames[m_frameIndex].Buffers[(buffer & ~FRAME_HANDLE) - 1];
+    }
+    return m_buffers[buffer - 1];
+}
+
+BufferHandle D3D12Backend::Import(const std::shared_ptr<ResourceItem> &buffer)
+{
+    auto &frame = m_frames[m_frameIndex];
+    auto [found, inserted] = frame.ImportedObjects.insert(std::make_pair(buffer.get(), 0));
+    if (inserted)
+    {
+        frame.Buffers.push_back(buffer);
+        found->second = FRAME_HANDLE | (uint32_t)frame.Buffers.size();
+    }
+    return found->second;
+}
+
+TextureHandle D3D12Backend::Import(const Slot &srv)
+{
+    auto &frame = m_frames[m_frameIndex];
+    auto key = ((uint64_t)srv.Page << 32) | srv.Index;
+    auto [found, inserted] = frame.ImportedTextures.insert(std::make_pair(key, 0));
+    if (inserted)
+    {
+        frame.Textures.push_back(srv);
+        found->second = FRAME_HANDLE | (uint32_t)frame.Textures.size();
+    }
+    return found->second;
+}
+
+PipelineHandle D3D12Backend::Import(const std::shared_ptr<Material> &material)
+{
+    auto &frame = m_frames[m_frameIndex];
+    auto [found, inserted] = frame.ImportedObjects.insert(std::make_pair(material.get(), 0));
+    if (inserted)
+    {
+        frame.Pipelines.push_back(material);
+        found->second = FRAME_HANDLE | (uint32_t)frame.Pipelines.size();
+    }
+    return found->second;
+}
+
+BufferHandle D3D12Backend::CreateBuffer(BufferUsage usage, uint64_t byteLength, const std::wstring &name)
+{
+    auto item = usage == BufferUsage::Upload ? ResourceItem::CreateUpload(m_device, (UINT)byteLength, name.c_str())
+                                             : ResourceItem::CreateDefault(m_device, (UINT)byteLength, name.c_str());
+    if (!m_freeBuffers.empty())
+    {
+        auto buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+        m_buffers[buffer - 1] = item;
+        return buffer;
+    }
+    m_buffers.push_back(item);
+    return (BufferHandle)m_buffers.size();
+}
+
+void D3D12Backend::DestroyBuffer(BufferHandle buffer)
+{
+    if (!buffer || (buffer & FRAME_HANDLE))
+    {
+        // imported buffer is owned by SceneMapper
+        return;
+    }
+    // frames in flight may read it
+    m_released.push_back({0, std::move(m_buffers[buffer - 1])});
+    m_freeBuffers.push_back(buffer);
+}
+
+void D3D12Backend::WriteBuffer(BufferHandle buffer, uint64_t offset, const void *p, uint64_t byteLength)
+{
+    GetBuffer(buffer)->MapCopyUnmap(offset, p, byteLength);
+}
+
+void D3D12Backend::CopyBuffer(BufferHandle dst, uint64_t dstOffset, BufferHandle src, uint64_t srcOffset, uint64_t byteLength)
+{
+    // once for a Default buffer. COPY_DEST to read
+    auto item = GetBuffer(dst);
+    item->EnqueueCopy(m_commandList, GetBuffer(src), srcOffset, (UINT)dstOffset, (UINT)byteLength, 0);
+    item->EnqueueTransition(m_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
+}
+
+void D3D12Backend::SetPipeline(PipelineHandle pipeline)
+{
+    m_pipeline = pipeline ? m_frames[m_frameIndex].Pipelines[(pipeline & ~FRAME_HANDLE) - 1] : nullptr;
+    // false while compiling
+    m_pipelineReady = m_pipeline && m_pipeline->Set(m_commandList->Get());
+    if (m_pipelineReady)
+    {
+        m_commandList->Get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+}
+
+void D3D12Backend::SetDrawConstants(BufferHandle buffer, uint64_t offset, uint32_t byteLength)
+{
+    auto item = GetBuffer(buffer);
+    m_drawConstants = item ? item->GpuAddress() + offset : 0;
+    m_drawConstantsBytes = byteLength;
+}
+
+void D3D12Backend::SetTexture(TextureHandle texture)
+{
+    m_texture = texture ? m_frames[m_frameIndex].Textures[(texture & ~FRAME_HANDLE) - 1] : Slot{};
+}
+
+void D3D12Backend::SetVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride)
+{
+    auto item = GetBuffer(buffer);
+    if (!item)
+    {
+        return;
+    }
+    D3D12_VERTEX_BUFFER_VIEW view{
+        .BufferLocation = item->GpuAddress() + offset,
+        .SizeInBytes = byteLength,
+        .StrideInBytes = stride,
+    };
+    m_commandList->Get()->IASetVertexBuffers(slot, 1, &view);
+}
+
+void D3D12Backend::SetIndexBuffer(BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride)
+{
+    auto item = GetBuffer(buffer);
+    if (!item)
+    {
+        return;
+    }
+    D3D12_INDEX_BUFFER_VIEW view{
+        .BufferLocation = item->GpuAddress() + offset,
+        .SizeInBytes = byteLength,
+        .Format = stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
+    };
+    m_commandList->Get()->IASetIndexBuffer(&view);
+}
+
+void D3D12Backend::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                        uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    if (!m_pipelineReady || !m_drawConstants)
+    {
+        return;
+    }
+    m_rootSignature->SetDrawDescriptorTable(m_device, m_commandList->Get(), m_drawConstants, m_drawConstantsBytes, m_texture);
+    m_commandList->Get()->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
+
+uint64_t D3D12Backend::Submit()
+{
+    if (!m_commandList)
+    {
+        // nothing recorded
+        return m_queue->Signal();
+    }
+
+    auto callbacks = m_commandList->CloseAndGetCallbacks();
+    m_queue->Execute(m_commandList->Get());
+    auto fence = m_queue->Signal();
+    m_commandList = nullptr;
+
+    for (auto &callback : callbacks)
+    {
+        m_callbacks.push_back({fence, callback});
+    }
+    for (auto &released : m_released)
+    {
+        if (released.first == 0)
+        {
+            released.first = fence;
+        }
+    }
+    return fence;
+}
+
+uint64_t D3D12Backend::CompletedValue()
+{
+    return m_queue->CurrentValue();
+}
+
+void D3D12Backend::Wait(uint64_t fenceValue)
+{
+    m_queue->Wait(fenceValue);
+}
+
+} // namespace d12u
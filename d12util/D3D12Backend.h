@@ -0,0 +1,91 @@
+#pragma once
+#include "Backend.h"
+#include "Helper.h"
+#include "SlotAllocator.h"
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace d12u
+{
+
+///
+/// Backend on the frame CommandList of Renderer
+///
+/// * CreateBuffer makes ResourceItem. Import wraps SceneMapper buffers, RootSignature SRV and Material
+/// * imported handles are valid until Begin of the same frameIndex
+/// * textures and pipelines are imported only
+/// * DrawIndexedInstanced sets the [b1, t0] descriptor table. skipped while the pipeline is compiling
+/// * Submit executes the CommandList. OnCompleted callbacks run at Retire
+///
+class D3D12Backend : public Backend
+{
+    ComPtr<ID3D12Device> m_device;
+    class CommandQueue *m_queue;
+    class RootSignature *m_rootSignature;
+
+    class CommandList *m_commandList = nullptr;
+    uint32_t m_frameIndex = 0;
+
+    // handle - 1
+    std::vector<std::shared_ptr<class ResourceItem>> m_buffers;
+    std::vector<BufferHandle> m_freeBuffers;
+    // destroyed after the fence. 0 is not submitted
+    std::vector<std::pair<uint64_t, std::shared_ptr<class ResourceItem>>> m_released;
+    // CommandList callbacks after the fence
+    std::vector<std::pair<uint64_t, std::function<void()>>> m_callbacks;
+
+    struct Frame
+    {
+        std::vector<std::shared_ptr<class ResourceItem>> Buffers;
+        std::vector<Slot> Textures;
+        std::vector<std::shared_ptr<class Material>> Pipelines;
+        // same object is the same handle in the frame
+        std::unordered_map<const void *, uint32_t> ImportedObjects;
+        std::unordered_map<uint64_t, uint32_t> ImportedTextures;
+    };
+    std::vector<Frame> m_frames;
+
+    // state
+    std::shared_ptr<class Material> m_pipeline;
+    bool m_pipelineReady = false;
+    D3D12_GPU_VIRTUAL_ADDRESS m_drawConstants = 0;
+    UINT m_drawConstantsBytes = 0;
+    Slot m_texture;
+
+    std::shared_ptr<class ResourceItem> GetBuffer(BufferHandle buffer) const;
+
+public:
+    D3D12Backend(const ComPtr<ID3D12Device> &device, class CommandQueue *queue, class RootSignature *rootSignature,
+                 uint32_t frameCount);
+    ~D3D12Backend();
+
+    // record to commandList. previous use of frameIndex is completed
+    void Begin(class CommandList *commandList, uint32_t frameIndex);
+    // OnCompleted callbacks and released buffers of completed fences
+    void Retire(uint64_t completedValue);
+
+    BufferHandle Import(const std::shared_ptr<class ResourceItem> &buffer);
+    TextureHandle Import(const Slot &srv);
+    PipelineHandle Import(const std::shared_ptr<class Material> &material);
+
+    BufferHandle CreateBuffer(BufferUsage usage, uint64_t byteLength, const std::wstring &name) override;
+    void DestroyBuffer(BufferHandle buffer) override;
+    void WriteBuffer(BufferHandle buffer, uint64_t offset, const void *p, uint64_t byteLength) override;
+    void CopyBuffer(BufferHandle dst, uint64_t dstOffset, BufferHandle src, uint64_t srcOffset, uint64_t byteLength) override;
+
+    void SetPipeline(PipelineHandle pipeline) override;
+    void SetDrawConstants(BufferHandle buffer, uint64_t offset, uint32_t byteLength) override;
+    void SetTexture(TextureHandle texture) override;
+    void SetVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) override;
+    void SetIndexBuffer(BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    uint64_t Submit() override;
+    uint64_t CompletedValue() override;
+    void Wait(uint64_t fenceValue) override;
+};
+
+} // namespace d12u
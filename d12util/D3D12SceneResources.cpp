@@ -0,0 +1,77 @@
+#include "D3D12SceneResources.h"
+#include "D3D12Backend.h"
+#include "SceneMapper.h"
+#include "RootSignature.h"
+#include "Mesh.h"
+#include "Texture.h"
+#include "ResourceItem.h"
+
+namespace d12u
+{
+
+D3D12SceneResources::D3D12SceneResources(const ComPtr<ID3D12Device> &device, D3D12Backend *backend,
+                                         SceneMapper *sceneMapper, RootSignature *rootSignature)
+    : m_device(device), m_backend(backend), m_sceneMapper(sceneMapper), m_rootSignature(rootSignature)
+{
+}
+
+bool D3D12SceneResources::Mesh(const hierarchy::DrawList::DrawItem &item, uint32_t frameIndex, MeshBinding *binding)
+{
+    auto &mesh = item.Mesh;
+    auto drawable = m_sceneMapper->GetOrCreate(m_device, mesh, m_rootSignature);
+    if (!drawable)
+    {
+        return false;
+    }
+
+    // dynamic. buffers of this frame slot
+    auto skin = mesh->skin;
+    if (skin)
+    {
+        drawable->VertexBuffer(frameIndex)->MapCopyUnmap(
+            skin->cpuSkiningBuffer.data(), (uint32_t)skin->cpuSkiningBuffer.size(), mesh->vertices->stride);
+    }
+    if (item.Vertices.Ptr)
+    {
+        drawable->VertexBuffer(frameIndex)->MapCopyUnmap(item.Vertices.Ptr, item.Vertices.Size, item.Vertices.Stride);
+    }
+    if (item.Indices.Ptr)
+    {
+        drawable->IndexBuffer(frameIndex)->MapCopyUnmap(item.Indices.Ptr, item.Indices.Size, item.Indices.Stride);
+    }
+
+    if (!drawable->IsDrawable(m_commandList, frameIndex))
+    {
+        return false;
+    }
+
+    auto vertices = drawable->VertexBuffer(frameIndex);
+    auto indices = drawable->IndexBuffer(frameIndex);
+    *binding = {
+        .Vertices = m_backend->Import(vertices),
+        .VerticesBytes = vertices->ByteLength(),
+        .VertexStride = vertices->Stride(),
+        .Indices = m_backend->Import(indices),
+        .IndicesBytes = indices->ByteLength(),
+        .IndexStride = indices->Stride(),
+    };
+    return true;
+}
+
+PipelineHandle D3D12SceneResources::Pipeline(const std::shared_ptr<hierarchy::SceneMaterial> &material)
+{
+    auto pipeline = m_rootSignature->GetOrCreate(m_device, material);
+    return pipeline ? m_backend->Import(pipeline) : 0;
+}
+
+TextureHandle D3D12SceneResources::Texture(const std::shared_ptr<hierarchy::SceneImage> &image)
+{
+    auto [texture, slot] = m_rootSignature->GetOrCreate(m_device, image, m_sceneMapper->GetUploader());
+    if (!texture || !texture->IsDrawable(m_commandList, 0))
+    {
+        return 0;
+    }
+    return m_backend->Import(slot);
+}
+
+} // namespace d12u
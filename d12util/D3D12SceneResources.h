@@ -0,0 +1,35 @@
+#pragma once
+#include "DrawListResources.h"
+#include "Helper.h"
+
+namespace d12u
+{
+
+///
+/// DrawListResources of SceneMapper and RootSignature
+///
+/// * meshes, materials and textures are imported to D3D12Backend each frame
+/// * dynamic vertices and skins are written to the upload buffers of frameIndex
+///
+class D3D12SceneResources : public DrawListResources
+{
+    ComPtr<ID3D12Device> m_device;
+    class D3D12Backend *m_backend;
+    class SceneMapper *m_sceneMapper;
+    class RootSignature *m_rootSignature;
+    // barriers of uploaded buffers
+    class CommandList *m_commandList = nullptr;
+
+public:
+    D3D12SceneResources(const ComPtr<ID3D12Device> &device, class D3D12Backend *backend,
+                        class SceneMapper *sceneMapper, class RootSignature *rootSignature);
+
+    // CommandList of the current frame
+    void Begin(class CommandList *commandList) { m_commandList = commandList; }
+
+    bool Mesh(const hierarchy::DrawList::DrawItem &item, uint32_t frameIndex, MeshBinding *binding) override;
+    PipelineHandle Pipeline(const std::shared_ptr<hierarchy::SceneMaterial> &material) override;
+    TextureHandle Texture(const std::shared_ptr<hierarchy::SceneImage> &image) override;
+};
+
+} // namespace d12u
@@ -0,0 +1,97 @@
+#include "DescriptorAllocator.h"
+#include "Heap.h"
+
+namespace d12u
+{
+
+DescriptorAllocator::DescriptorAllocator(uint32_t framePageSize, uint32_t persistentPageSize)
+    : m_frameSlots(framePageSize), m_persistentSlots(persistentPageSize)
+{
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+}
+
+void DescriptorAllocator::Initialize(const ComPtr<ID3D12Device> &device)
+{
+    m_device = device;
+}
+
+Slot DescriptorAllocator::AllocateFrame(uint32_t count)
+{
+    bool newPage;
+    auto slot = m_frameSlots.Allocate(count, &newPage);
+    if (newPage)
+    {
+        auto heap = std::make_unique<Heap>();
+        heap->Initialize(m_device, m_frameSlots.PageSize());
+        m_framePages.push_back(std::move(heap));
+    }
+    return slot;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorAllocator::FrameCpuHandle(const Slot &slot) const
+{
+    return m_framePages[slot.Page]->CpuHandle(slot.Index);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorAllocator::FrameGpuHandle(const Slot &slot) const
+{
+    return m_framePages[slot.Page]->GpuHandle(slot.Index);
+}
+
+bool DescriptorAllocator::Bind(const ComPtr<ID3D12GraphicsCommandList> &commandList, const Slot &slot)
+{
+    if (slot.Page == m_boundPage)
+    {
+        return false;
+    }
+    ID3D12DescriptorHeap *ppHeaps[] = {m_framePages[slot.Page]->Get()};
+    commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
+    m_boundPage = slot.Page;
+    return true;
+}
+
+Slot DescriptorAllocator::AllocatePersistent()
+{
+    bool newPage;
+    auto slot = m_persistentSlots.Allocate(&newPage);
+    if (newPage)
+    {
+        auto heap = std::make_unique<Heap>();
+        heap->Initialize(m_device, m_persistentSlots.PageSize(), false);
+        m_persistentPages.push_back(std::move(heap));
+    }
+    return slot;
+}
+
+void DescriptorAllocator::FreePersistent(const Slot &slot)
+{
+    m_persistentSlots.Free(slot);
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorAllocator::PersistentCpuHandle(const Slot &slot) const
+{
+    return m_persistentPages[slot.Page]->CpuHandle(slot.Index);
+}
+
+void DescriptorAllocator::CopyToFrame(const Slot &persistent, const Slot &frame)
+{
+    m_device->CopyDescriptorsSimple(1, FrameCpuHandle(frame), PersistentCpuHandle(persistent),
+                                    D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+}
+
+void DescriptorAllocator::BeginFrame(UINT64 completedValue)
+{
+    m_frameSlots.Retire(completedValue);
+    m_boundPage = Slot::INVALID;
+}
+
+void DescriptorAllocator::EndFrame(UINT64 fenceValue)
+{
+    m_frameSlots.Close(fenceValue);
+    m_boundPage = Slot::INVALID;
+}
+
+} // namespace d12u
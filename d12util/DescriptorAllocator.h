@@ -0,0 +1,53 @@
+#pragma once
+#include "Helper.h"
+#include "SlotAllocator.h"
+#include <memory>
+
+namespace d12u
+{
+
+///
+/// CBV_SRV_UAV descriptors
+///
+/// * frame: shader visible pages. linear per frame, reused after the frame fence completes
+/// * persistent: cpu only pages with free list. copied to a frame slot to bind
+///
+class DescriptorAllocator : NonCopyable
+{
+    ComPtr<ID3D12Device> m_device;
+
+    LinearSlotAllocator m_frameSlots;
+    std::vector<std::unique_ptr<class Heap>> m_framePages;
+    FreeListSlotAllocator m_persistentSlots;
+    std::vector<std::unique_ptr<class Heap>> m_persistentPages;
+
+    // SetDescriptorHeaps
+    uint32_t m_boundPage = Slot::INVALID;
+
+public:
+    DescriptorAllocator(uint32_t framePageSize = 4096, uint32_t persistentPageSize = 1024);
+    ~DescriptorAllocator();
+    void Initialize(const ComPtr<ID3D12Device> &device);
+
+    // valid until EndFrame fence completes
+    Slot AllocateFrame(uint32_t count = 1);
+    D3D12_CPU_DESCRIPTOR_HANDLE FrameCpuHandle(const Slot &slot) const;
+    D3D12_GPU_DESCRIPTOR_HANDLE FrameGpuHandle(const Slot &slot) const;
+    // SetDescriptorHeaps if page of slot is not bound. descriptor tables must be set again
+    bool Bind(const ComPtr<ID3D12GraphicsCommandList> &commandList, const Slot &slot);
+    // after SetDescriptorHeaps by others
+    void Unbind() { m_boundPage = Slot::INVALID; }
+
+    Slot AllocatePersistent();
+    void FreePersistent(const Slot &slot);
+    D3D12_CPU_DESCRIPTOR_HANDLE PersistentCpuHandle(const Slot &slot) const;
+    void CopyToFrame(const Slot &persistent, const Slot &frame);
+
+    void BeginFrame(UINT64 completedValue);
+    void EndFrame(UINT64 fenceValue);
+
+    const LinearSlotAllocator::Counters &FrameCounters() const { return m_frameSlots.GetCounters(); }
+    const FreeListSlotAllocator::Counters &PersistentCounters() const { return m_persistentSlots.GetCounters(); }
+};
+
+} // namespace d12u
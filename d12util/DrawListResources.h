@@ -0,0 +1,49 @@
+#pragma once
+#include "Backend.h"
+#include <DrawList.h>
+#include <memory>
+
+namespace hierarchy
+{
+class SceneMaterial;
+class SceneImage;
+} // namespace hierarchy
+
+namespace d12u
+{
+
+struct MeshBinding
+{
+    BufferHandle Vertices = 0;
+    uint32_t VerticesBytes = 0;
+    uint32_t VertexStride = 0;
+    BufferHandle Indices = 0;
+    uint32_t IndicesBytes = 0;
+    uint32_t IndexStride = 0;
+};
+
+///
+/// scene objects to Backend handles for DrawListSubmitter
+///
+/// * UploadResources uploads by NullBackend commands. D3D12SceneResources maps SceneMapper and RootSignature
+/// * handles are valid until the fence of the frame
+///
+class DrawListResources
+{
+public:
+    virtual ~DrawListResources() = default;
+
+    // write dynamic vertices to the buffers of frameIndex. false if not drawable yet
+    virtual bool Mesh(const hierarchy::DrawList::DrawItem &item, uint32_t frameIndex, MeshBinding *binding) = 0;
+    // 0 skips the draw
+    virtual PipelineHandle Pipeline(const std::shared_ptr<hierarchy::SceneMaterial> &material) = 0;
+    // 0 is none
+    virtual TextureHandle Texture(const std::shared_ptr<hierarchy::SceneImage> &image) = 0;
+
+    // fence of the commands recorded since the last Close
+    virtual void Close(uint64_t /*fenceValue*/) {}
+    // staging of completed fences
+    virtual void Retire(uint64_t /*completedValue*/) {}
+};
+
+} // namespace d12u
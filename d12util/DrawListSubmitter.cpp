@@ -0,0 +1,163 @@
+#include "DrawListSubmitter.h"
+#include <SceneMesh.h>
+#include <SceneMaterial.h>
+#include <algorithm>
+#include <array>
+#include <string.h>
+
+namespace d12u
+{
+
+DrawListSubmitter::DrawListSubmitter(Backend *backend, DrawListResources *resources, uint32_t frameCount)
+    : m_backend(backend), m_resources(resources), m_ring(frameCount), m_frames(m_ring.Count())
+{
+}
+
+DrawListSubmitter::~DrawListSubmitter()
+{
+    m_backend->Wait(m_backend->Submit());
+    for (auto &frame : m_frames)
+    {
+        for (auto buffer : {frame.DrawConstants.Buffer, frame.Instances.Buffer})
+        {
+            if (buffer)
+            {
+                m_backend->DestroyBuffer(buffer);
+            }
+        }
+    }
+}
+
+void DrawListSubmitter::Reserve(UploadBuffer *buffer, uint64_t byteLength, const wchar_t *name)
+{
+    if (byteLength <= buffer->Capacity)
+    {
+        return;
+    }
+    if (buffer->Buffer)
+    {
+        m_backend->DestroyBuffer(buffer->Buffer);
+    }
+    buffer->Capacity = std::max(byteLength, buffer->Capacity * 2);
+    buffer->Buffer = m_backend->CreateBuffer(BufferUsage::Upload, buffer->Capacity, name);
+}
+
+static uint32_t SlotSize(uint32_t size)
+{
+    return (size + DrawListSubmitter::CB_SLOT_SIZE - 1) & ~(DrawListSubmitter::CB_SLOT_SIZE - 1);
+}
+
+void DrawListSubmitter::Update(const hierarchy::DrawList &drawlist, uint32_t frameIndex)
+{
+    auto &frame = m_frames[frameIndex % m_frames.size()];
+
+    // CB. each range to 256 byte aligned slot
+    uint64_t slotsSize = 0;
+    for (auto [offset, size] : drawlist.CBRanges)
+    {
+        slotsSize += SlotSize(size);
+    }
+    m_slots.resize(slotsSize);
+    {
+        auto dst = m_slots.data();
+        for (auto [offset, size] : drawlist.CBRanges)
+        {
+            memcpy(dst, drawlist.CB.data() + offset, size);
+            dst += SlotSize(size);
+        }
+    }
+    if (slotsSize)
+    {
+        Reserve(&frame.DrawConstants, slotsSize, L"##drawconstants##");
+        m_backend->WriteBuffer(frame.DrawConstants.Buffer, 0, m_slots.data(), slotsSize);
+    }
+
+    // instances
+    if (!drawlist.Instances.empty())
+    {
+        auto byteLength = drawlist.Instances.size() * sizeof(drawlist.Instances[0]);
+        Reserve(&frame.Instances, byteLength, L"##instances##");
+        m_backend->WriteBuffer(frame.Instances.Buffer, 0, drawlist.Instances.data(), byteLength);
+    }
+}
+
+void DrawListSubmitter::Draw(const hierarchy::DrawList &drawlist, uint32_t frameIndex)
+{
+    auto &frame = m_frames[frameIndex % m_frames.size()];
+    auto stride = (uint32_t)sizeof(std::array<float, 16>);
+
+    // state of the backend is unknown at first
+    PipelineHandle pipeline = ~0u;
+    TextureHandle texture = ~0u;
+    uint64_t slot = 0;
+    for (size_t i = 0; i < drawlist.Items.size(); ++i)
+    {
+        auto &item = drawlist.Items[i];
+        uint64_t slotOffset = slot;
+        uint32_t slotSize = 0;
+        if (i < drawlist.CBRanges.size())
+        {
+            slotSize = SlotSize(drawlist.CBRanges[i].second);
+            slot += slotSize;
+        }
+        if (!item.Mesh)
+        {
+            continue;
+        }
+
+        MeshBinding mesh;
+        if (!m_resources->Mesh(item, frameIndex, &mesh))
+        {
+            continue;
+        }
+        auto &submesh = item.Mesh->submeshes[item.SubmeshIndex];
+        auto itemPipeline = m_resources->Pipeline(submesh.material);
+        if (!itemPipeline)
+        {
+            continue;
+        }
+        if (itemPipeline != pipeline)
+        {
+            m_backend->SetPipeline(itemPipeline);
+            pipeline = itemPipeline;
+        }
+        m_backend->SetDrawConstants(frame.DrawConstants.Buffer, slotOffset, slotSize);
+        auto &image = submesh.material->colorImage();
+        auto itemTexture = image ? m_resources->Texture(image) : 0;
+        if (itemTexture != texture)
+        {
+            m_backend->SetTexture(itemTexture);
+            texture = itemTexture;
+        }
+        m_backend->SetVertexBuffer(0, mesh.Vertices, 0, mesh.VerticesBytes, mesh.VertexStride);
+        if (item.InstanceCount)
+        {
+            // slot 1: INSTANCE_WORLD
+            m_backend->SetVertexBuffer(1, frame.Instances.Buffer, (uint64_t)item.InstanceOffset * stride,
+                                       item.InstanceCount * stride, stride);
+        }
+        m_backend->SetIndexBuffer(mesh.Indices, 0, mesh.IndicesBytes, mesh.IndexStride);
+        m_backend->DrawIndexedInstanced(submesh.drawCount, std::max(item.InstanceCount, 1u), submesh.drawOffset, 0, 0);
+    }
+}
+
+uint64_t DrawListSubmitter::Submit(const hierarchy::DrawList &drawlist)
+{
+    // per frame buffers of the slot are in use until its fence
+    auto wait = m_ring.Acquire(m_ring.Next());
+    if (wait)
+    {
+        m_backend->Wait(wait);
+    }
+    Retire(m_backend->CompletedValue());
+
+    Update(drawlist, m_ring.Index());
+    Draw(drawlist, m_ring.Index());
+
+    auto fence = m_backend->Submit();
+    m_ring.Release(fence);
+    Close(fence);
+    return fence;
+}
+
+} // namespace d12u
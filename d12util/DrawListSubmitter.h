@@ -0,0 +1,65 @@
+#pragma once
+#include "Backend.h"
+#include "DrawListResources.h"
+#include "FrameRing.h"
+#include <DrawList.h>
+#include <memory>
+#include <vector>
+
+namespace d12u
+{
+
+///
+/// Renderer::View CPU path on Backend
+///
+/// * DrawList::CB to 256 byte aligned slots(b1). Instances to vertex slot 1
+/// * meshes, pipelines and textures from DrawListResources
+/// * per frame buffers of frameIndex are reused after the fence of the frame
+/// * Renderer calls Update and Draw in its frame. Submit is the headless frame
+///
+class DrawListSubmitter
+{
+    Backend *m_backend;
+    DrawListResources *m_resources;
+
+    struct UploadBuffer
+    {
+        BufferHandle Buffer = 0;
+        uint64_t Capacity = 0;
+    };
+    struct FrameBuffers
+    {
+        UploadBuffer DrawConstants;
+        UploadBuffer Instances;
+    };
+    FrameRing m_ring;
+    std::vector<FrameBuffers> m_frames;
+
+    std::vector<uint8_t> m_slots;
+
+    DrawListSubmitter(const DrawListSubmitter &) = delete;
+    DrawListSubmitter &operator=(const DrawListSubmitter &) = delete;
+
+    void Reserve(UploadBuffer *buffer, uint64_t byteLength, const wchar_t *name);
+
+public:
+    static constexpr uint32_t CB_SLOT_SIZE = 256;
+    static constexpr uint32_t FRAME_COUNT = 3;
+
+    // resources: not owned
+    DrawListSubmitter(Backend *backend, DrawListResources *resources, uint32_t frameCount = FRAME_COUNT);
+    ~DrawListSubmitter();
+
+    // write CB slots and instances to the buffers of frameIndex. previous use of frameIndex is completed
+    void Update(const hierarchy::DrawList &drawlist, uint32_t frameIndex);
+    // record draws. after Update of the same frameIndex
+    void Draw(const hierarchy::DrawList &drawlist, uint32_t frameIndex);
+    // fence of the recorded frame
+    void Close(uint64_t fenceValue) { m_resources->Close(fenceValue); }
+    void Retire(uint64_t completedValue) { m_resources->Retire(completedValue); }
+
+    // wait the frame slot, Update, Draw and Backend::Submit. return fence value
+    uint64_t Submit(const hierarchy::DrawList &drawlist);
+};
+
+} // namespace d12u
@@ -0,0 +1,28 @@
+#include "FrameRing.h"
+#include <algorithm>
+
+namespace d12u
+{
+
+uint64_t FrameRing::Last() const
+{
+    return *std::max_element(m_fences.begin(), m_fences.end());
+}
+
+uint64_t FrameRing::Acquire(uint32_t index)
+{
+    m_index = index % Count();
+    return m_fences[m_index];
+}
+
+void FrameRing::Release(uint64_t fenceValue)
+{
+    m_fences[m_index] = fenceValue;
+}
+
+void FrameRing::Reset()
+{
+    std::fill(m_fences.begin(), m_fences.end(), 0);
+}
+
+} // namespace d12u
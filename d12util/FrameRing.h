@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace d12u
+{
+
+///
+/// fence values of frames in flight. no d3d12
+///
+/// * Acquire selects the slot of per frame resources. returns fence value to wait before reuse
+/// * Release tags the slot with the fence value of its submit
+/// * slot resources are reused only after its fence completed
+///
+class FrameRing
+{
+    // 0 is not submitted
+    std::vector<uint64_t> m_fences;
+    uint32_t m_index = 0;
+
+public:
+    FrameRing(uint32_t count)
+        : m_fences(count ? count : 1)
+    {
+    }
+    uint32_t Count() const { return (uint32_t)m_fences.size(); }
+    uint32_t Index() const { return m_index; }
+    uint32_t Next() const { return (m_index + 1) % Count(); }
+    // largest fence value of all slots. wait this before resize or shutdown
+    uint64_t Last() const;
+
+    uint64_t Acquire(uint32_t index);
+    void Release(uint64_t fenceValue);
+    // all slots completed
+    void Reset();
+};
+
+} // namespace d12u
@@ -1,85 +1,96 @@
-#include "Mesh.h"
-#include "ResourceItem.h"
-#include "CommandList.h"
-#include "Material.h"
-
-namespace d12u
-{
-
-bool Mesh::IsDrawable(class CommandList *commandList)
-{
-    auto _commandList = commandList->Get();
-
-    //
-    // vertexState
-    //
-    if (!m_vertexBuffer)
-    {
-        return false;
-    }
-    auto vertexState = m_vertexBuffer->State();
-    if (vertexState.State == D3D12_RESOURCE_STATE_COPY_DEST)
-    {
-        if (vertexState.Upload == UploadStates::Uploaded)
-        {
-            m_vertexBuffer->EnqueueTransition(commandList, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-        }
-    }
-
-    //
-    // indexState
-    //
-    if (!m_indexBuffer)
-    {
-        // //
-        // // draw non indexed: deprecated
-        // //
-        // if (vertexState.Drawable())
-        // {
-        //     _commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        //     _commandList->IASetVertexBuffers(0, 1, &m_vertexBuffer->VertexBufferView());
-        //     _commandList->DrawInstanced(m_vertexBuffer->Count(), 1, 0, 0);
-        // }
-        return false;
-    }
-    auto indexState = m_indexBuffer->State();
-    if (indexState.State == D3D12_RESOURCE_STATE_COPY_DEST)
-    {
-        if (indexState.Upload == UploadStates::Uploaded)
-        {
-            m_indexBuffer->EnqueueTransition(commandList, D3D12_RESOURCE_STATE_INDEX_BUFFER);
-        }
-    }
-
-    //
-    // draw Indexed
-    //
-    if (!vertexState.Drawable() || !indexState.Drawable())
-    {
-        return false;
-    }
-
-    _commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    _commandList->IASetVertexBuffers(0, 1, &m_vertexBuffer->VertexBufferView());
-    _commandList->IASetIndexBuffer(&m_indexBuffer->IndexBufferView());
-
-    // // draw
-    // if (submeshes.empty())
-    // {
-    //     _commandList->DrawIndexedInstanced(m_indexBuffer->Count(), 1, 0, 0, 0);
-    // }
-    // else
-    // {
-    //     int offset = 0;
-    //     for (auto &submesh : submeshes)
-    //     {
-    //         submesh.material->Set(_commandList);
-    //         _commandList->DrawIndexedInstanced(submesh.draw_count, 1, 0, 0, 0);
-    //         offset += submesh.draw_count;
-    //     }
-    // }}
-
-    return true;
-}
-
+#include "Mesh.h"
+#include "ResourceItem.h"
+#include "CommandList.h"
+#include "Material.h"
+
+namespace d12u
+{
+
+UINT64 Mesh::AllocatedBytes() const
+{
+    UINT64 bytes = 0;
+    for (auto buffers : {&m_vertexBuffers, &m_indexBuffers})
+    {
+        for (auto &buffer : *buffers)
+        {
+            bytes += buffer->AllocatedBytes();
+        }
+    }
+    return bytes;
+}
+
+bool Mesh::IsDrawable(class CommandList *commandList, UINT frameIndex)
+{
+    auto vertexBuffer = VertexBuffer(frameIndex);
+    auto indexBuffer = IndexBuffer(frameIndex);
+
+    //
+    // vertexState
+    //
+    if (!vertexBuffer)
+    {
+        return false;
+    }
+    auto vertexState = vertexBuffer->State();
+    if (vertexState.State == D3D12_RESOURCE_STATE_COPY_DEST)
+    {
+        if (vertexState.Upload == UploadStates::Uploaded)
+        {
+            vertexBuffer->EnqueueTransition(commandList, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+        }
+    }
+
+    //
+    // indexState
+    //
+    if (!indexBuffer)
+    {
+        // //
+        // // draw non indexed: deprecated
+        // //
+        // if (vertexState.Drawable())
+        // {
+        //     _commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        //     _commandList->IASetVertexBuffers(0, 1, &vertexBuffer->VertexBufferView());
+        //     _commandList->DrawInstanced(vertexBuffer->Count(), 1, 0, 0);
+        // }
+        return false;
+    }
+    auto indexState = indexBuffer->State();
+    if (indexState.State == D3D12_RESOURCE_STATE_COPY_DEST)
+    {
+        if (indexState.Upload == UploadStates::Uploaded)
+        {
+            indexBuffer->EnqueueTransition(commandList, D3D12_RESOURCE_STATE_INDEX_BUFFER);
+        }
+    }
+
+    //
+    // draw Indexed
+    //
+    if (!vertexState.Drawable() || !indexState.Drawable())
+    {
+        return false;
+    }
+
+    // Backend binds the views
+    // // draw
+    // if (submeshes.empty())
+    // {
+    //     _commandList->DrawIndexedInstanced(indexBuffer->Count(), 1, 0, 0, 0);
+    // }
+    // else
+    // {
+    //     int offset = 0;
+    //     for (auto &submesh : submeshes)
+    //     {
+    //         submesh.material->Set(_commandList);
+    //         _commandList->DrawIndexedInstanced(submesh.draw_count, 1, 0, 0, 0);
+    //         offset += submesh.draw_count;
+    //     }
+    // }}
+
+    return true;
+}
+
 } // namespace d12u
\ No newline at end of file
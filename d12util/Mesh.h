@@ -1,25 +1,36 @@
-#pragma once
-#include "Helper.h"
-#include <memory>
-#include <vector>
-
-namespace d12u
-{
-
-class Mesh : NonCopyable
-{
-    template <class T>
-    using ComPtr = Microsoft::WRL::ComPtr<T>;
-
-    std::shared_ptr<class ResourceItem> m_vertexBuffer;
-    std::shared_ptr<class ResourceItem> m_indexBuffer;
-
-public:
-    void VertexBuffer(const std::shared_ptr<class ResourceItem> &item) { m_vertexBuffer = item; }
-    const std::shared_ptr<class ResourceItem> &VertexBuffer() const { return m_vertexBuffer; }
-    void IndexBuffer(const std::shared_ptr<class ResourceItem> &item) { m_indexBuffer = item; }
-    const std::shared_ptr<class ResourceItem> &IndexBuffer() const { return m_indexBuffer; }
-    bool IsDrawable(class CommandList *commandList);
-};
-
-} // namespace d12u
+#pragma once
+#include "Helper.h"
+#include <memory>
+#include <vector>
+
+namespace d12u
+{
+
+class Mesh : NonCopyable
+{
+    template <class T>
+    using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    // dynamic mesh has an upload buffer for each frame in flight
+    using Buffers = std::vector<std::shared_ptr<class ResourceItem>>;
+    Buffers m_vertexBuffers;
+    Buffers m_indexBuffers;
+
+    static std::shared_ptr<class ResourceItem> FrameBuffer(const Buffers &buffers, UINT frameIndex)
+    {
+        return buffers.empty() ? nullptr : buffers[frameIndex % buffers.size()];
+    }
+
+public:
+    void VertexBuffer(const std::shared_ptr<class ResourceItem> &item) { m_vertexBuffers = {item}; }
+    void VertexBuffers(const Buffers &items) { m_vertexBuffers = items; }
+    std::shared_ptr<class ResourceItem> VertexBuffer(UINT frameIndex = 0) const { return FrameBuffer(m_vertexBuffers, frameIndex); }
+    void IndexBuffer(const std::shared_ptr<class ResourceItem> &item) { m_indexBuffers = {item}; }
+    void IndexBuffers(const Buffers &items) { m_indexBuffers = items; }
+    std::shared_ptr<class ResourceItem> IndexBuffer(UINT frameIndex = 0) const { return FrameBuffer(m_indexBuffers, frameIndex); }
+    bool IsDrawable(class CommandList *commandList, UINT frameIndex = 0);
+    // all buffers of all frames
+    UINT64 AllocatedBytes() const;
+};
+
+} // namespace d12u
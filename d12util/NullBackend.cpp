@@ -0,0 +1,163 @@
+#include "NullBackend.h"
+#include <string.h>
+#include <algorithm>
+
+namespace d12u
+{
+
+void NullBackend::Push(CommandType type, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t a4)
+{
+    ++m_counters.Commands[(size_t)type];
+    if (Recording)
+    {
+        m_commands.push_back({type, {a0, a1, a2, a3, a4}});
+    }
+}
+
+const uint8_t *NullBackend::BufferBytes(BufferHandle buffer) const
+{
+    if (buffer == 0 || buffer > m_buffers.size())
+    {
+        return nullptr;
+    }
+    auto &b = m_buffers[buffer - 1];
+    return b.Bytes.empty() ? nullptr : b.Bytes.data();
+}
+
+BufferHandle NullBackend::CreateBuffer(BufferUsage usage, uint64_t byteLength, const std::wstring &)
+{
+    ++m_counters.BuffersCreated;
+    m_counters.BufferBytes += byteLength;
+    m_buffers.push_back({
+        .Usage = usage,
+        .ByteLength = byteLength,
+        .Alive = true,
+    });
+    if (usage == BufferUsage::Upload)
+    {
+        m_buffers.back().Bytes.resize(byteLength);
+    }
+    return (BufferHandle)m_buffers.size();
+}
+
+void NullBackend::DestroyBuffer(BufferHandle buffer)
+{
+    if (buffer == 0 || buffer > m_buffers.size())
+    {
+        throw "NullBackend: invalid buffer";
+    }
+    auto &b = m_buffers[buffer - 1];
+    b.Alive = false;
+    b.Bytes = {};
+}
+
+void NullBackend::WriteBuffer(BufferHandle buffer, uint64_t offset, const void *p, uint64_t byteLength)
+{
+    if (buffer == 0 || buffer > m_buffers.size())
+    {
+        throw "NullBackend: invalid buffer";
+    }
+    auto &b = m_buffers[buffer - 1];
+    if (b.Usage != BufferUsage::Upload || offset + byteLength > b.ByteLength)
+    {
+        throw "NullBackend: invalid write";
+    }
+    memcpy(b.Bytes.data() + offset, p, byteLength);
+    m_counters.WriteBytes += byteLength;
+}
+
+void NullBackend::CopyBuffer(BufferHandle dst, uint64_t dstOffset, BufferHandle src, uint64_t srcOffset, uint64_t byteLength)
+{
+    m_counters.CopyBytes += byteLength;
+    Push(CommandType::CopyBuffer, dst, dstOffset, src, srcOffset, byteLength);
+}
+
+TextureHandle NullBackend::CreateTexture(uint32_t width, uint32_t height, const std::wstring &)
+{
+    ++m_counters.TexturesCreated;
+    m_textures.push_back({width, height});
+    return (TextureHandle)m_textures.size();
+}
+
+void NullBackend::DestroyTexture(TextureHandle texture)
+{
+    if (texture == 0 || texture > m_textures.size())
+    {
+        throw "NullBackend: invalid texture";
+    }
+    m_textures[texture - 1] = {};
+}
+
+void NullBackend::CopyBufferToTexture(TextureHandle dst, BufferHandle src, uint64_t srcOffset)
+{
+    if (dst == 0 || dst > m_textures.size())
+    {
+        throw "NullBackend: invalid texture";
+    }
+    auto [width, height] = m_textures[dst - 1];
+    m_counters.CopyBytes += (uint64_t)width * height * 4;
+    Push(CommandType::CopyBufferToTexture, dst, src, srcOffset);
+}
+
+PipelineHandle NullBackend::CreatePipeline(const PipelineDesc &desc)
+{
+    ++m_counters.PipelinesCreated;
+    m_pipelines.push_back(desc);
+    return (PipelineHandle)m_pipelines.size();
+}
+
+void NullBackend::SetPipeline(PipelineHandle pipeline)
+{
+    Push(CommandType::SetPipeline, pipeline);
+}
+
+void NullBackend::SetDrawConstants(BufferHandle buffer, uint64_t offset, uint32_t byteLength)
+{
+    Push(CommandType::SetDrawConstants, buffer, offset, byteLength);
+}
+
+void NullBackend::SetTexture(TextureHandle texture)
+{
+    Push(CommandType::SetTexture, texture);
+}
+
+void NullBackend::SetVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride)
+{
+    Push(CommandType::SetVertexBuffer, slot, buffer, offset, byteLength, stride);
+}
+
+void NullBackend::SetIndexBuffer(BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride)
+{
+    Push(CommandType::SetIndexBuffer, buffer, offset, byteLength, stride);
+}
+
+void NullBackend::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                       uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    Push(CommandType::DrawIndexedInstanced, indexCount, instanceCount, startIndex, (uint64_t)(int64_t)baseVertex, startInstance);
+}
+
+uint64_t NullBackend::Submit()
+{
+    ++m_counters.Submits;
+    m_commands.clear();
+    auto fence = ++m_submitted;
+    // gpu finished Latency submits ago
+    if (m_submitted > Latency)
+    {
+        m_completed = std::max(m_completed, m_submitted - Latency);
+    }
+    return fence;
+}
+
+void NullBackend::Wait(uint64_t fenceValue)
+{
+    if (m_completed >= fenceValue)
+    {
+        return;
+    }
+    ++m_counters.Stalls;
+    m_completed = std::min(fenceValue, m_submitted);
+}
+
+} // namespace d12u
@@ -0,0 +1,120 @@
+#pragma once
+#include "Backend.h"
+#include <vector>
+#include <array>
+
+namespace d12u
+{
+
+struct PipelineDesc
+{
+    std::string Shader;
+    int ShaderGeneration = 0;
+    // hierarchy::AlphaMode
+    int AlphaMode = 0;
+    bool DepthTest = true;
+    bool InstanceWorld = false;
+};
+
+///
+/// headless Backend
+///
+/// * counts commands and bytes
+/// * keeps Upload buffer bytes. Default buffer and texture are size only
+/// * fence completes Latency submits later, or at Wait
+/// * Recording = true keeps commands until next Submit
+///
+class NullBackend : public Backend
+{
+public:
+    enum class CommandType
+    {
+        CopyBuffer,
+        CopyBufferToTexture,
+        SetPipeline,
+        SetDrawConstants,
+        SetTexture,
+        SetVertexBuffer,
+        SetIndexBuffer,
+        DrawIndexedInstanced,
+        COUNT,
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        std::array<uint64_t, 5> Args;
+    };
+
+    struct Counters
+    {
+        std::array<uint64_t, (size_t)CommandType::COUNT> Commands{};
+        uint64_t BuffersCreated = 0;
+        uint64_t BufferBytes = 0;
+        uint64_t TexturesCreated = 0;
+        uint64_t PipelinesCreated = 0;
+        uint64_t WriteBytes = 0;
+        uint64_t CopyBytes = 0;
+        uint64_t Submits = 0;
+        // Wait for not completed fence
+        uint64_t Stalls = 0;
+
+        uint64_t operator[](CommandType type) const { return Commands[(size_t)type]; }
+    };
+
+private:
+    struct Buffer
+    {
+        BufferUsage Usage;
+        uint64_t ByteLength;
+        std::vector<uint8_t> Bytes;
+        bool Alive;
+    };
+    std::vector<Buffer> m_buffers;
+    std::vector<std::array<uint32_t, 2>> m_textures;
+    std::vector<PipelineDesc> m_pipelines;
+
+    std::vector<Command> m_commands;
+    Counters m_counters;
+
+    uint64_t m_submitted = 0;
+    uint64_t m_completed = 0;
+
+    void Push(CommandType type, uint64_t a0 = 0, uint64_t a1 = 0, uint64_t a2 = 0, uint64_t a3 = 0, uint64_t a4 = 0);
+
+public:
+    // submits until fence completion
+    uint32_t Latency = 0;
+    bool Recording = false;
+
+    const Counters &GetCounters() const { return m_counters; }
+    void ResetCounters() { m_counters = {}; }
+    const std::vector<Command> &Commands() const { return m_commands; }
+    const uint8_t *BufferBytes(BufferHandle buffer) const;
+
+    BufferHandle CreateBuffer(BufferUsage usage, uint64_t byteLength, const std::wstring &name) override;
+    void DestroyBuffer(BufferHandle buffer) override;
+    void WriteBuffer(BufferHandle buffer, uint64_t offset, const void *p, uint64_t byteLength) override;
+    void CopyBuffer(BufferHandle dst, uint64_t dstOffset, BufferHandle src, uint64_t srcOffset, uint64_t byteLength) override;
+
+    // headless textures and pipelines. not in Backend
+    TextureHandle CreateTexture(uint32_t width, uint32_t height, const std::wstring &name);
+    void DestroyTexture(TextureHandle texture);
+    // recorded command. src is Upload buffer of RGBA
+    void CopyBufferToTexture(TextureHandle dst, BufferHandle src, uint64_t srcOffset);
+    PipelineHandle CreatePipeline(const PipelineDesc &desc);
+
+    void SetPipeline(PipelineHandle pipeline) override;
+    void SetDrawConstants(BufferHandle buffer, uint64_t offset, uint32_t byteLength) override;
+    void SetTexture(TextureHandle texture) override;
+    void SetVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) override;
+    void SetIndexBuffer(BufferHandle buffer, uint64_t offset, uint32_t byteLength, uint32_t stride) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    uint64_t Submit() override;
+    uint64_t CompletedValue() override { return m_completed; }
+    void Wait(uint64_t fenceValue) override;
+};
+
+} // namespace d12u
@@ -0,0 +1,223 @@
+#include "PipelineCache.h"
+#include <WorkerPool.h>
+#include <frame_metrics.h>
+#include <plog/Log.h>
+#include <fstream>
+#include <string.h>
+
+namespace d12u
+{
+
+// owns everything desc points
+struct PipelineJob
+{
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc;
+    ComPtr<ID3D12RootSignature> RootSignature;
+    std::vector<uint8_t> VS;
+    std::vector<uint8_t> PS;
+    std::vector<std::string> Semantics;
+    std::vector<D3D12_INPUT_ELEMENT_DESC> InputLayout;
+
+    PipelineJob(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc)
+        : Desc(desc), RootSignature(desc.pRootSignature)
+    {
+        auto vs = (const uint8_t *)desc.VS.pShaderBytecode;
+        VS.assign(vs, vs + desc.VS.BytecodeLength);
+        auto ps = (const uint8_t *)desc.PS.pShaderBytecode;
+        PS.assign(ps, ps + desc.PS.BytecodeLength);
+        for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+        {
+            Semantics.push_back(desc.InputLayout.pInputElementDescs[i].SemanticName);
+            InputLayout.push_back(desc.InputLayout.pInputElementDescs[i]);
+        }
+        for (size_t i = 0; i < InputLayout.size(); ++i)
+        {
+            InputLayout[i].SemanticName = Semantics[i].c_str();
+        }
+
+        Desc.VS = {VS.data(), VS.size()};
+        Desc.PS = {PS.data(), PS.size()};
+        Desc.InputLayout = {InputLayout.data(), (UINT)InputLayout.size()};
+    }
+
+    // FNV-1a. stable between runs
+    uint64_t Hash() const
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        auto push = [&hash](const void *p, size_t size) {
+            auto bytes = (const uint8_t *)p;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ull;
+            }
+        };
+        push(VS.data(), VS.size());
+        push(PS.data(), PS.size());
+        for (auto &element : InputLayout)
+        {
+            push(element.SemanticName, strlen(element.SemanticName));
+            push(&element.SemanticIndex, sizeof(element.SemanticIndex));
+            push(&element.Format, sizeof(element.Format));
+            push(&element.InputSlot, sizeof(element.InputSlot));
+            push(&element.AlignedByteOffset, sizeof(element.AlignedByteOffset));
+            push(&element.InputSlotClass, sizeof(element.InputSlotClass));
+            push(&element.InstanceDataStepRate, sizeof(element.InstanceDataStepRate));
+        }
+        push(&Desc.BlendState, sizeof(Desc.BlendState));
+        push(&Desc.SampleMask, sizeof(Desc.SampleMask));
+        push(&Desc.RasterizerState, sizeof(Desc.RasterizerState));
+        push(&Desc.DepthStencilState, sizeof(Desc.DepthStencilState));
+        push(&Desc.PrimitiveTopologyType, sizeof(Desc.PrimitiveTopologyType));
+        push(&Desc.NumRenderTargets, sizeof(Desc.NumRenderTargets));
+        push(Desc.RTVFormats, sizeof(Desc.RTVFormats));
+        push(&Desc.DSVFormat, sizeof(Desc.DSVFormat));
+        push(&Desc.SampleDesc, sizeof(Desc.SampleDesc));
+        return hash;
+    }
+};
+
+PipelineCache::~PipelineCache()
+{
+    {
+        // workers capture this
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_stats.Pending == 0; });
+    }
+    Save();
+}
+
+void PipelineCache::Initialize(const ComPtr<ID3D12Device> &device, const std::filesystem::path &path)
+{
+    m_device = device;
+    m_path = path;
+    if (m_path.empty())
+    {
+        return;
+    }
+
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(m_device.As(&device1)))
+    {
+        return;
+    }
+
+    std::ifstream ifs(m_path, std::ios::binary);
+    if (ifs)
+    {
+        m_libraryBlob.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    if (!m_libraryBlob.empty())
+    {
+        if (FAILED(device1->CreatePipelineLibrary(m_libraryBlob.data(), m_libraryBlob.size(), IID_PPV_ARGS(&m_library))))
+        {
+            // driver or adapter is changed
+            LOGW << "discard pipeline library: " << m_path;
+            m_libraryBlob.clear();
+        }
+    }
+    if (!m_library)
+    {
+        if (FAILED(device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_library))))
+        {
+            // not supported. memory only
+            return;
+        }
+    }
+}
+
+std::shared_ptr<PipelineCache::Pipeline> PipelineCache::GetOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc)
+{
+    auto job = std::make_shared<PipelineJob>(desc);
+    auto key = job->Hash();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.Requests;
+    auto found = m_pipelineMap.find(key);
+    if (found != m_pipelineMap.end())
+    {
+        ++m_stats.Hits;
+        return found->second;
+    }
+
+    auto pipeline = std::make_shared<Pipeline>();
+    m_pipelineMap.insert(std::make_pair(key, pipeline));
+    ++m_stats.Pending;
+    hierarchy::WorkerPool::Instance().Enqueue([this, key, job, pipeline]() {
+        Compile(key, job, pipeline);
+    });
+    return pipeline;
+}
+
+void PipelineCache::Compile(uint64_t key, const std::shared_ptr<PipelineJob> &job, const std::shared_ptr<Pipeline> &pipeline)
+{
+    frame_metrics::scoped s("pipeline");
+
+    wchar_t name[17];
+    swprintf(name, _countof(name), L"%016llx", key);
+
+    bool loaded = false;
+    if (m_library)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        loaded = SUCCEEDED(m_library->LoadGraphicsPipeline(name, &job->Desc, IID_PPV_ARGS(&pipeline->m_pipelineState)));
+    }
+
+    if (!loaded)
+    {
+        // slow. out of lock
+        if (FAILED(m_device->CreateGraphicsPipelineState(&job->Desc, IID_PPV_ARGS(&pipeline->m_pipelineState))))
+        {
+            LOGE << "CreateGraphicsPipelineState failed";
+            pipeline->m_pipelineState = nullptr;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (loaded)
+        {
+            ++m_stats.LibraryHits;
+        }
+        else if (pipeline->m_pipelineState)
+        {
+            ++m_stats.Compiles;
+            if (m_library && SUCCEEDED(m_library->StorePipeline(name, pipeline->m_pipelineState.Get())))
+            {
+                m_dirty = true;
+            }
+        }
+        pipeline->m_ready.store(true, std::memory_order_release);
+        --m_stats.Pending;
+    }
+    m_cv.notify_all();
+}
+
+void PipelineCache::Save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_library || !m_dirty)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> bytes(m_library->GetSerializedSize());
+    if (FAILED(m_library->Serialize(bytes.data(), bytes.size())))
+    {
+        LOGE << "fail to serialize pipeline library";
+        return;
+    }
+    std::ofstream ofs(m_path, std::ios::binary);
+    ofs.write((const char *)bytes.data(), bytes.size());
+    m_dirty = false;
+}
+
+PipelineCache::Stats PipelineCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto stats = m_stats;
+    stats.Pipelines = (uint32_t)m_pipelineMap.size();
+    return stats;
+}
+
+} // namespace d12u
@@ -0,0 +1,76 @@
+#pragma once
+#include "Helper.h"
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <filesystem>
+
+namespace d12u
+{
+
+///
+/// PSO shared by hash of its description
+///
+/// * key: shader bytecode, input layout, blend, depth, rasterizer and formats. one root signature
+/// * CreateGraphicsPipelineState runs on hierarchy::WorkerPool
+/// * ID3D12PipelineLibrary is loaded from path and saved at destruction
+///
+class PipelineCache : NonCopyable
+{
+public:
+    class Pipeline
+    {
+        friend class PipelineCache;
+        ComPtr<ID3D12PipelineState> m_pipelineState;
+        std::atomic<bool> m_ready = false;
+
+    public:
+        // nullptr while compiling or failed
+        ID3D12PipelineState *Get() const
+        {
+            return m_ready.load(std::memory_order_acquire) ? m_pipelineState.Get() : nullptr;
+        }
+    };
+
+    struct Stats
+    {
+        uint32_t Pipelines = 0;
+        uint32_t Pending = 0;
+        uint64_t Requests = 0;
+        // shared with other material
+        uint64_t Hits = 0;
+        uint64_t LibraryHits = 0;
+        uint64_t Compiles = 0;
+    };
+
+private:
+    ComPtr<ID3D12Device> m_device;
+    // referenced by m_library
+    std::vector<uint8_t> m_libraryBlob;
+    ComPtr<ID3D12PipelineLibrary> m_library;
+    std::filesystem::path m_path;
+    bool m_dirty = false;
+
+    std::unordered_map<uint64_t, std::shared_ptr<Pipeline>> m_pipelineMap;
+    // m_library and m_stats from workers
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    Stats m_stats;
+
+    void Compile(uint64_t key, const std::shared_ptr<struct PipelineJob> &job, const std::shared_ptr<Pipeline> &pipeline);
+
+public:
+    ~PipelineCache();
+    // empty path is not persistent
+    void Initialize(const ComPtr<ID3D12Device> &device, const std::filesystem::path &path);
+    // desc is copied. pointers in desc are not used after return
+    std::shared_ptr<Pipeline> GetOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc);
+    // serialize library if new pipelines are stored
+    void Save();
+    Stats GetStats();
+};
+
+} // namespace d12u
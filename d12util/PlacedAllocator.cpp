@@ -0,0 +1,150 @@
+#include "PlacedAllocator.h"
+#include <algorithm>
+
+namespace d12u
+{
+
+PlacedAllocator &PlacedAllocator::Instance()
+{
+    static PlacedAllocator s_instance;
+    return s_instance;
+}
+
+ComPtr<ID3D12Resource> PlacedAllocator::Create(const ComPtr<ID3D12Device> &device, PlacedHeapType type,
+                                               D3D12_RESOURCE_DESC desc, D3D12_RESOURCE_STATES state,
+                                               PlacedAllocation *allocation)
+{
+    D3D12_RESOURCE_ALLOCATION_INFO info;
+    if (type == PlacedHeapType::DefaultTexture)
+    {
+        // try small alignment
+        desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        info = device->GetResourceAllocationInfo(0, 1, &desc);
+        if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+        {
+            desc.Alignment = 0;
+            info = device->GetResourceAllocationInfo(0, 1, &desc);
+        }
+    }
+    else
+    {
+        desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        info = device->GetResourceAllocationInfo(0, 1, &desc);
+    }
+    if (info.SizeInBytes == UINT64_MAX || info.SizeInBytes > PageSize)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &pages = m_pages[(size_t)type];
+    TlsfAllocator::Allocation sub;
+    uint32_t page = 0;
+    for (; page < pages.size(); ++page)
+    {
+        if (pages[page].Allocator->Allocate(info.SizeInBytes, info.Alignment, &sub))
+        {
+            break;
+        }
+    }
+    if (page == pages.size())
+    {
+        // new page
+        D3D12_HEAP_DESC heapDesc{
+            .SizeInBytes = PageSize,
+            .Properties = {
+                .Type = type == PlacedHeapType::UploadBuffer ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT,
+            },
+            .Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+            .Flags = type == PlacedHeapType::DefaultTexture ? D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES
+                                                            : D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,
+        };
+        Page newPage{
+            .Allocator = std::make_unique<TlsfAllocator>(PageSize, D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT),
+        };
+        ThrowIfFailed(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&newPage.Heap)));
+        pages.push_back(std::move(newPage));
+        if (!pages.back().Allocator->Allocate(info.SizeInBytes, info.Alignment, &sub))
+        {
+            return nullptr;
+        }
+    }
+
+    ComPtr<ID3D12Resource> resource;
+    auto hr = device->CreatePlacedResource(pages[page].Heap.Get(), sub.Offset, &desc, state, nullptr, IID_PPV_ARGS(&resource));
+    if (FAILED(hr))
+    {
+        pages[page].Allocator->Free(sub.Id);
+        return nullptr;
+    }
+
+    *allocation = {
+        .Type = type,
+        .Page = page,
+        .Id = sub.Id,
+    };
+    return resource;
+}
+
+void PlacedAllocator::Free(const PlacedAllocation &allocation, ComPtr<ID3D12Resource> resource)
+{
+    if (!allocation && !resource)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.push_back({
+        .FenceValue = 0,
+        .Allocation = allocation,
+        .Resource = std::move(resource),
+    });
+}
+
+void PlacedAllocator::Close(uint64_t fenceValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &pending : m_pending)
+    {
+        if (pending.FenceValue == 0)
+        {
+            pending.FenceValue = fenceValue;
+        }
+    }
+}
+
+void PlacedAllocator::Retire(uint64_t completedValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto end = std::remove_if(m_pending.begin(), m_pending.end(), [this, completedValue](const PendingFree &pending) {
+        if (pending.FenceValue == 0 || pending.FenceValue > completedValue)
+        {
+            return false;
+        }
+        if (pending.Allocation)
+        {
+            m_pages[(size_t)pending.Allocation.Type][pending.Allocation.Page].Allocator->Free(pending.Allocation.Id);
+        }
+        return true;
+    });
+    // release resources
+    m_pending.erase(end, m_pending.end());
+}
+
+PlacedAllocator::Stats PlacedAllocator::GetStats(PlacedHeapType type)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats{};
+    for (auto &page : m_pages[(size_t)type])
+    {
+        auto pageStats = page.Allocator->GetStats();
+        ++stats.Pages;
+        stats.Reserved += pageStats.Capacity;
+        stats.Used += pageStats.Used;
+        stats.Allocations += pageStats.Allocations;
+        stats.FreeBlocks += pageStats.FreeBlocks;
+        stats.LargestFree = std::max(stats.LargestFree, pageStats.LargestFree);
+    }
+    return stats;
+}
+
+} // namespace d12u
@@ -0,0 +1,86 @@
+#pragma once
+#include "Helper.h"
+#include "TlsfAllocator.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace d12u
+{
+// resource heap tier 1 requires separated heaps
+enum class PlacedHeapType
+{
+    DefaultBuffer,
+    UploadBuffer,
+    DefaultTexture,
+    COUNT,
+};
+
+struct PlacedAllocation
+{
+    PlacedHeapType Type = PlacedHeapType::DefaultBuffer;
+    uint32_t Page = TlsfAllocator::INVALID;
+    uint32_t Id = TlsfAllocator::INVALID;
+
+    explicit operator bool() const { return Page != TlsfAllocator::INVALID; }
+};
+
+///
+/// placed resources over PageSize ID3D12Heap pages
+///
+/// * TlsfAllocator per page. 64KB for buffers and textures, 4KB for small textures
+/// * resource larger than PageSize is not placed. use committed resource
+/// * Free is deferred. Close tags frees since last Close with the fence of the frame. Retire frees completed ones
+///
+class PlacedAllocator : NonCopyable
+{
+    struct Page
+    {
+        ComPtr<ID3D12Heap> Heap;
+        std::unique_ptr<TlsfAllocator> Allocator;
+    };
+    std::array<std::vector<Page>, (size_t)PlacedHeapType::COUNT> m_pages;
+
+    struct PendingFree
+    {
+        // 0 is not closed
+        uint64_t FenceValue;
+        PlacedAllocation Allocation;
+        // GPU may read it until FenceValue
+        ComPtr<ID3D12Resource> Resource;
+    };
+    std::vector<PendingFree> m_pending;
+    std::mutex m_mutex;
+
+    PlacedAllocator() = default;
+
+public:
+    UINT64 PageSize = 64 * 1024 * 1024;
+
+    static PlacedAllocator &Instance();
+
+    // nullptr if not placed
+    ComPtr<ID3D12Resource> Create(const ComPtr<ID3D12Device> &device, PlacedHeapType type,
+                                  D3D12_RESOURCE_DESC desc, D3D12_RESOURCE_STATES state,
+                                  PlacedAllocation *allocation);
+    // range and resource are kept until Retire passes the fence of next Close.
+    // invalid allocation only defers the resource
+    void Free(const PlacedAllocation &allocation, ComPtr<ID3D12Resource> resource = nullptr);
+    // fence value of the graphics queue submit. copy queue keeps ResourceItem by UploadCommand
+    void Close(uint64_t fenceValue);
+    void Retire(uint64_t completedValue);
+
+    struct Stats
+    {
+        UINT Pages = 0;
+        UINT64 Reserved = 0;
+        UINT64 Used = 0;
+        UINT Allocations = 0;
+        UINT FreeBlocks = 0;
+        UINT64 LargestFree = 0;
+    };
+    Stats GetStats(PlacedHeapType type);
+};
+
+} // namespace d12u
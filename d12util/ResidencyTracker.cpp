@@ -0,0 +1,115 @@
+#include "ResidencyTracker.h"
+
+namespace d12u
+{
+
+uint64_t ResidencyTracker::ResidentBytes() const
+{
+    uint64_t bytes = 0;
+    for (auto value : m_stats.Bytes)
+    {
+        bytes += value;
+    }
+    return bytes;
+}
+
+void ResidencyTracker::Add(const std::shared_ptr<const void> &owner, ResidencyCategory category, uint64_t bytes,
+                           ReleaseFunc &&release)
+{
+    auto key = owner.get();
+    auto found = m_entries.find(key);
+    if (found != m_entries.end())
+    {
+        // recreated by owner
+        Erase(found);
+    }
+
+    m_lru.push_back(key);
+    m_entries.insert(std::make_pair(key, Entry{
+                                             .Owner = owner,
+                                             .Category = category,
+                                             .Bytes = bytes,
+                                             .LastUsed = m_frame,
+                                             .Release = std::move(release),
+                                             .Position = std::prev(m_lru.end()),
+                                         }));
+    m_stats.Bytes[(size_t)category] += bytes;
+    ++m_stats.Resources[(size_t)category];
+}
+
+void ResidencyTracker::Touch(const void *owner)
+{
+    auto found = m_entries.find(owner);
+    if (found == m_entries.end())
+    {
+        return;
+    }
+    auto &entry = found->second;
+    if (entry.LastUsed == m_frame)
+    {
+        return;
+    }
+    entry.LastUsed = m_frame;
+    m_lru.splice(m_lru.end(), m_lru, entry.Position);
+}
+
+void ResidencyTracker::Erase(std::unordered_map<const void *, Entry>::iterator it)
+{
+    auto &entry = it->second;
+    m_stats.Bytes[(size_t)entry.Category] -= entry.Bytes;
+    --m_stats.Resources[(size_t)entry.Category];
+    m_lru.erase(entry.Position);
+    m_entries.erase(it);
+}
+
+void ResidencyTracker::Remove(const void *owner)
+{
+    auto found = m_entries.find(owner);
+    if (found != m_entries.end())
+    {
+        Erase(found);
+    }
+}
+
+size_t ResidencyTracker::Evict()
+{
+    auto resident = ResidentBytes();
+    size_t count = 0;
+    for (auto it = m_lru.begin(); it != m_lru.end();)
+    {
+        auto found = m_entries.find(*it);
+        ++it;
+        auto &entry = found->second;
+        if (entry.LastUsed + m_framesInFlight > m_frame)
+        {
+            // GPU may use this and all after
+            break;
+        }
+
+        // map holds the last reference
+        auto unreferenced = entry.Owner.use_count() <= 1;
+        if (!unreferenced && (resident <= m_budget || entry.Bytes == 0))
+        {
+            continue;
+        }
+
+        resident -= entry.Bytes;
+        ++m_stats.Evictions;
+        m_stats.EvictedBytes += entry.Bytes;
+        auto release = std::move(entry.Release);
+        Erase(found);
+        ++count;
+        // owner may call Remove. entry is already erased
+        release();
+    }
+    return count;
+}
+
+ResidencyTracker::Stats ResidencyTracker::GetStats() const
+{
+    auto stats = m_stats;
+    stats.Budget = m_budget;
+    return stats;
+}
+
+} // namespace d12u
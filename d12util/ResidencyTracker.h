@@ -0,0 +1,88 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace d12u
+{
+
+enum class ResidencyCategory
+{
+    Mesh,
+    Texture,
+    Material,
+    COUNT,
+};
+
+///
+/// GPU objects of scene objects in LRU order. no d3d12
+///
+/// * key is the scene object. owner map holds it. unreferenced if the map is the last owner
+/// * Touch stamps the frame. objects used in frames in flight are never evicted
+/// * Evict releases unreferenced objects, then least recently used objects while over budget
+///
+class ResidencyTracker
+{
+public:
+    struct Stats
+    {
+        uint64_t Budget = 0;
+        std::array<uint64_t, (size_t)ResidencyCategory::COUNT> Bytes{};
+        std::array<uint32_t, (size_t)ResidencyCategory::COUNT> Resources{};
+        // churn
+        uint64_t Evictions = 0;
+        uint64_t EvictedBytes = 0;
+    };
+
+    // erase from the owner map. called in Evict
+    using ReleaseFunc = std::function<void()>;
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<const void> Owner;
+        ResidencyCategory Category;
+        uint64_t Bytes;
+        uint64_t LastUsed;
+        ReleaseFunc Release;
+        std::list<const void *>::iterator Position;
+    };
+    std::unordered_map<const void *, Entry> m_entries;
+    // front is the least recently used
+    std::list<const void *> m_lru;
+
+    uint64_t m_budget;
+    uint32_t m_framesInFlight;
+    uint64_t m_frame = 0;
+    Stats m_stats;
+
+    void Erase(std::unordered_map<const void *, Entry>::iterator it);
+
+public:
+    ResidencyTracker(uint64_t budget, uint32_t framesInFlight)
+        : m_budget(budget), m_framesInFlight(framesInFlight ? framesInFlight : 1)
+    {
+    }
+    uint64_t Budget() const { return m_budget; }
+    void Budget(uint64_t budget) { m_budget = budget; }
+    uint64_t Frame() const { return m_frame; }
+    uint64_t ResidentBytes() const;
+
+    // after the fence of the oldest frame in flight completed
+    void NewFrame() { ++m_frame; }
+    // used in this frame
+    void Add(const std::shared_ptr<const void> &owner, ResidencyCategory category, uint64_t bytes,
+             ReleaseFunc &&release);
+    void Touch(const void *owner);
+    // released by owner. not call ReleaseFunc
+    void Remove(const void *owner);
+    // returns evicted count
+    size_t Evict();
+
+    Stats GetStats() const;
+};
+
+} // namespace d12u
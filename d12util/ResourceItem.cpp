@@ -1,210 +1,257 @@
-#include "ResourceItem.h"
-// #include "d3dx12.h"
-#include "CommandList.h"
-
-namespace d12u
-{
-ResourceItem::ResourceItem(
-    const ComPtr<ID3D12Resource> &resource,
-    D3D12_RESOURCE_STATES state,
-    LPCWSTR name)
-    : m_resource(resource)
-{
-    m_state.State = state;
-    m_state.Upload = UploadStates::None;
-    resource->SetName(name);
-}
-
-void ResourceItem::MapCopyUnmap(const void *p, UINT byteLength, UINT stride)
-{
-    // Copy the triangle data to the vertex buffer.
-    UINT8 *begin;
-    D3D12_RANGE readRange{0, 0}; // We do not intend to read from this resource on the CPU.
-    ThrowIfFailed(m_resource->Map(0, &readRange, reinterpret_cast<void **>(&begin)));
-    memcpy(begin, p, byteLength);
-    m_resource->Unmap(0, nullptr);
-
-    m_byteLength = byteLength;
-    m_stride = stride;
-    m_count = byteLength / stride;
-    m_state.Upload = UploadStates::Uploaded;
-}
-
-void ResourceItem::EnqueueTransition(CommandList *commandList, D3D12_RESOURCE_STATES state)
-{
-    m_state.Upload = UploadStates::Enqueued;
-    D3D12_RESOURCE_BARRIER barrier{
-        .Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-        .Transition = {
-            .pResource = m_resource.Get(),
-            .StateBefore = m_state.State,
-            .StateAfter = state,
-        },
-    };
-    commandList->Get()->ResourceBarrier(1, &barrier);
-
-    std::weak_ptr weak = shared_from_this();
-    auto callback = [weak, state]() {
-        auto shared = weak.lock();
-        if (shared)
-        {
-            shared->m_state.State = state;
-            shared->m_state.Upload = UploadStates::Uploaded;
-        }
-    };
-
-    commandList->AddOnCompleted(callback);
-}
-
-void ResourceItem::EnqueueUpload(CommandList *commandList,
-                                 const std::shared_ptr<ResourceItem> &upload,
-                                 const void *p, UINT byteLength, UINT stride)
-{
-    // upload
-    upload->MapCopyUnmap(p, byteLength, stride);
-
-    // copy command
-    auto desc = m_resource->GetDesc();
-    switch (desc.Dimension)
-    {
-    case D3D12_RESOURCE_DIMENSION_BUFFER:
-        // TODO: footprint, offset
-        commandList->Get()->CopyBufferRegion(m_resource.Get(), 0,
-                                             upload->Resource().Get(), 0, byteLength);
-        break;
-
-    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
-    {
-        D3D12_TEXTURE_COPY_LOCATION src{
-            .pResource = upload->Resource().Get(),
-            .Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT,
-            .PlacedFootprint = {
-                .Offset = 0,
-                .Footprint = {
-                    .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
-                    .Width = stride / 4,
-                    .Height = byteLength / stride,
-                    .Depth = 1,
-                    .RowPitch = stride,
-                }}};
-        D3D12_TEXTURE_COPY_LOCATION dst{
-            .pResource = m_resource.Get(),
-            .Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
-            .SubresourceIndex = 0};
-        commandList->Get()->CopyTextureRegion(&dst,
-                                              0, 0, 0, &src, nullptr);
-    }
-    break;
-
-    default:
-        // not implemented
-        throw;
-    }
-
-    std::weak_ptr weak = shared_from_this();
-    auto callback = [weak]() {
-        auto shared = weak.lock();
-        if (shared)
-        {
-            shared->m_state.Upload = UploadStates::Uploaded;
-        }
-    };
-
-    commandList->AddOnCompleted(callback);
-
-    m_byteLength = byteLength;
-    m_stride = stride;
-    m_count = byteLength / stride;
-}
-
-std::shared_ptr<ResourceItem> ResourceItem::CreateUpload(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name)
-{
-    D3D12_HEAP_PROPERTIES prop{
-        .Type = D3D12_HEAP_TYPE_UPLOAD,
-    };
-    D3D12_RESOURCE_DESC desc{
-        .Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
-        .Alignment = 0,
-        .Width = byteLength,
-        .Height = 1,
-        .DepthOrArraySize = 1,
-        .MipLevels = 1,
-        .Format = DXGI_FORMAT_UNKNOWN,
-        .SampleDesc = {1, 0},
-        .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
-        .Flags = D3D12_RESOURCE_FLAG_NONE,
-    };
-    ComPtr<ID3D12Resource> resource;
-    ThrowIfFailed(device->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(&resource)));
-
-    return std::shared_ptr<ResourceItem>(
-        new ResourceItem(resource, D3D12_RESOURCE_STATE_GENERIC_READ, name));
-}
-
-std::shared_ptr<ResourceItem> ResourceItem::CreateDefault(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name)
-{
-    D3D12_HEAP_PROPERTIES prop{
-        .Type = D3D12_HEAP_TYPE_DEFAULT,
-    };
-    D3D12_RESOURCE_DESC desc{
-        .Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
-        .Alignment = 0,
-        .Width = byteLength,
-        .Height = 1,
-        .DepthOrArraySize = 1,
-        .MipLevels = 1,
-        .Format = DXGI_FORMAT_UNKNOWN,
-        .SampleDesc = {1, 0},
-        .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
-        .Flags = D3D12_RESOURCE_FLAG_NONE,
-    };
-    ComPtr<ID3D12Resource> resource;
-    ThrowIfFailed(device->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        nullptr,
-        IID_PPV_ARGS(&resource)));
-
-    return std::shared_ptr<ResourceItem>(
-        new ResourceItem(resource, D3D12_RESOURCE_STATE_COPY_DEST, name));
-}
-
-std::shared_ptr<ResourceItem> ResourceItem::CreateDefaultImage(const ComPtr<ID3D12Device> &device, UINT width, UINT height, LPCWSTR name)
-{
-    D3D12_HEAP_PROPERTIES prop{
-        .Type = D3D12_HEAP_TYPE_DEFAULT,
-    };
-    D3D12_RESOURCE_DESC desc{
-        .Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D,
-        .Alignment = 0,
-        .Width = width,
-        .Height = height,
-        .DepthOrArraySize = 1,
-        .MipLevels = 1,
-        .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
-        .SampleDesc = {1, 0},
-        .Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN,
-        .Flags = D3D12_RESOURCE_FLAG_NONE,
-    };
-    ComPtr<ID3D12Resource> resource;
-    ThrowIfFailed(device->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        nullptr,
-        IID_PPV_ARGS(&resource)));
-
-    return std::shared_ptr<ResourceItem>(
-        new ResourceItem(resource, D3D12_RESOURCE_STATE_COPY_DEST, name));
-}
-
-} // namespace d12u
+#include "ResourceItem.h"
+// #include "d3dx12.h"
+#include "CommandList.h"
+
+namespace d12u
+{
+
+// bytes of texel or 4x4 block
+static UINT BlockBytes(DXGI_FORMAT format, UINT *blockSize)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+        *blockSize = 4;
+        return 8;
+
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        *blockSize = 4;
+        return 16;
+
+    default:
+        *blockSize = 1;
+        return 4;
+    }
+}
+
+ResourceItem::ResourceItem(
+    const ComPtr<ID3D12Resource> &resource,
+    D3D12_RESOURCE_STATES state,
+    LPCWSTR name,
+    const PlacedAllocation &allocation)
+    : m_resource(resource), m_allocation(allocation)
+{
+    m_state.State = state;
+    m_state.Upload = UploadStates::None;
+    resource->SetName(name);
+}
+
+ResourceItem::~ResourceItem()
+{
+    if (m_allocation)
+    {
+        // heap range may be used by frames in flight
+        PlacedAllocator::Instance().Free(m_allocation, std::move(m_resource));
+    }
+}
+
+void ResourceItem::MapCopyUnmap(const void *p, UINT byteLength, UINT stride)
+{
+    // Copy the triangle data to the vertex buffer.
+    UINT8 *begin;
+    D3D12_RANGE readRange{0, 0}; // We do not intend to read from this resource on the CPU.
+    ThrowIfFailed(m_resource->Map(0, &readRange, reinterpret_cast<void **>(&begin)));
+    memcpy(begin, p, byteLength);
+    m_resource->Unmap(0, nullptr);
+
+    m_byteLength = byteLength;
+    m_stride = stride;
+    m_count = byteLength / stride;
+    m_state.Upload = UploadStates::Uploaded;
+}
+
+void ResourceItem::MapCopyUnmap(UINT64 offset, const void *p, UINT64 byteLength)
+{
+    UINT8 *begin;
+    D3D12_RANGE readRange{0, 0};
+    ThrowIfFailed(m_resource->Map(0, &readRange, reinterpret_cast<void **>(&begin)));
+    memcpy(begin + offset, p, byteLength);
+    D3D12_RANGE writtenRange{offset, offset + byteLength};
+    m_resource->Unmap(0, &writtenRange);
+    m_state.Upload = UploadStates::Uploaded;
+}
+
+void ResourceItem::EnqueueTransition(CommandList *commandList, D3D12_RESOURCE_STATES state)
+{
+    m_state.Upload = UploadStates::Enqueued;
+    D3D12_RESOURCE_BARRIER barrier{
+        .Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
+        .Transition = {
+            .pResource = m_resource.Get(),
+            .StateBefore = m_state.State,
+            .StateAfter = state,
+        },
+    };
+    commandList->Get()->ResourceBarrier(1, &barrier);
+
+    std::weak_ptr weak = shared_from_this();
+    auto callback = [weak, state]() {
+        auto shared = weak.lock();
+        if (shared)
+        {
+            shared->m_state.State = state;
+            shared->m_state.Upload = UploadStates::Uploaded;
+        }
+    };
+
+    commandList->AddOnCompleted(callback);
+}
+
+void ResourceItem::EnqueueUpload(CommandList *commandList,
+                                 const std::shared_ptr<ResourceItem> &upload,
+                                 const void *p, UINT byteLength, UINT stride)
+{
+    // upload
+    upload->MapCopyUnmap(p, byteLength, stride);
+
+    EnqueueCopy(commandList, upload, 0, 0, byteLength, stride);
+    EnqueueUploaded(commandList, byteLength, stride);
+}
+
+void ResourceItem::EnqueueCopy(CommandList *commandList,
+                               const std::shared_ptr<ResourceItem> &upload, UINT64 srcOffset,
+                               UINT dstOffset, UINT byteLength, UINT stride, UINT subresource, UINT rowPitch)
+{
+    // copy command
+    auto desc = m_resource->GetDesc();
+    switch (desc.Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        commandList->Get()->CopyBufferRegion(m_resource.Get(), dstOffset,
+                                             upload->Resource().Get(), srcOffset, byteLength);
+        break;
+
+    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
+    {
+        // BC footprint is in texels of whole blocks
+        UINT blockSize;
+        auto blockBytes = BlockBytes(desc.Format, &blockSize);
+        auto pitch = rowPitch ? rowPitch : stride;
+        D3D12_TEXTURE_COPY_LOCATION src{
+            .pResource = upload->Resource().Get(),
+            .Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT,
+            .PlacedFootprint = {
+                .Offset = srcOffset,
+                .Footprint = {
+                    .Format = desc.Format,
+                    .Width = stride / blockBytes * blockSize,
+                    .Height = byteLength / pitch * blockSize,
+                    .Depth = 1,
+                    .RowPitch = pitch,
+                }}};
+        D3D12_TEXTURE_COPY_LOCATION dst{
+            .pResource = m_resource.Get(),
+            .Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
+            .SubresourceIndex = subresource};
+        // rows from dstOffset / pitch
+        commandList->Get()->CopyTextureRegion(&dst,
+                                              0, dstOffset / pitch * blockSize, 0, &src, nullptr);
+    }
+    break;
+
+    default:
+        // not implemented
+        throw;
+    }
+}
+
+void ResourceItem::EnqueueUploaded(CommandList *commandList, UINT byteLength, UINT stride)
+{
+    std::weak_ptr weak = shared_from_this();
+    auto callback = [weak]() {
+        auto shared = weak.lock();
+        if (shared)
+        {
+            shared->m_state.Upload = UploadStates::Uploaded;
+        }
+    };
+
+    commandList->AddOnCompleted(callback);
+
+    m_byteLength = byteLength;
+    m_stride = stride;
+    m_count = byteLength / stride;
+}
+
+std::shared_ptr<ResourceItem> ResourceItem::Create(const ComPtr<ID3D12Device> &device, PlacedHeapType type,
+                                                   const D3D12_RESOURCE_DESC &desc, D3D12_RESOURCE_STATES state, LPCWSTR name)
+{
+    PlacedAllocation allocation;
+    auto resource = PlacedAllocator::Instance().Create(device, type, desc, state, &allocation);
+    if (!resource)
+    {
+        D3D12_HEAP_PROPERTIES prop{
+            .Type = type == PlacedHeapType::UploadBuffer ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT,
+        };
+        ThrowIfFailed(device->CreateCommittedResource(
+            &prop,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            state,
+            nullptr,
+            IID_PPV_ARGS(&resource)));
+    }
+
+    auto item = std::shared_ptr<ResourceItem>(
+        new ResourceItem(resource, state, name, allocation));
+    item->m_allocatedBytes = device->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+    return item;
+}
+
+std::shared_ptr<ResourceItem> ResourceItem::CreateUpload(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name)
+{
+    D3D12_RESOURCE_DESC desc{
+        .Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
+        .Alignment = 0,
+        .Width = byteLength,
+        .Height = 1,
+        .DepthOrArraySize = 1,
+        .MipLevels = 1,
+        .Format = DXGI_FORMAT_UNKNOWN,
+        .SampleDesc = {1, 0},
+        .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+        .Flags = D3D12_RESOURCE_FLAG_NONE,
+    };
+    return Create(device, PlacedHeapType::UploadBuffer, desc, D3D12_RESOURCE_STATE_GENERIC_READ, name);
+}
+
+std::shared_ptr<ResourceItem> ResourceItem::CreateDefault(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name)
+{
+    D3D12_RESOURCE_DESC desc{
+        .Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
+        .Alignment = 0,
+        .Width = byteLength,
+        .Height = 1,
+        .DepthOrArraySize = 1,
+        .MipLevels = 1,
+        .Format = DXGI_FORMAT_UNKNOWN,
+        .SampleDesc = {1, 0},
+        .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+        .Flags = D3D12_RESOURCE_FLAG_NONE,
+    };
+    return Create(device, PlacedHeapType::DefaultBuffer, desc, D3D12_RESOURCE_STATE_COPY_DEST, name);
+}
+
+std::shared_ptr<ResourceItem> ResourceItem::CreateDefaultImage(const ComPtr<ID3D12Device> &device, UINT width, UINT height, LPCWSTR name,
+                                                               DXGI_FORMAT format, UINT16 mipLevels)
+{
+    D3D12_RESOURCE_DESC desc{
+        .Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D,
+        .Alignment = 0,
+        .Width = width,
+        .Height = height,
+        .DepthOrArraySize = 1,
+        .MipLevels = mipLevels,
+        .Format = format,
+        .SampleDesc = {1, 0},
+        .Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN,
+        .Flags = D3D12_RESOURCE_FLAG_NONE,
+    };
+    return Create(device, PlacedHeapType::DefaultTexture, desc, D3D12_RESOURCE_STATE_COPY_DEST, name);
+}
+
+} // namespace d12u
@@ -1,116 +1,140 @@
-#pragma once
-#include "Helper.h"
-#include <memory>
-
-namespace d12u
-{
-enum class UploadStates
-{
-    None,
-    Enqueued,
-    Uploaded,
-};
-
-/// ID3D12Resource helper
-///
-/// * State maintenance
-/// * Barrier helper
-///
-class ResourceItem : public std::enable_shared_from_this<ResourceItem>
-{
-    template <class T>
-    using ComPtr = Microsoft::WRL::ComPtr<T>;
-
-    ComPtr<ID3D12Resource> m_resource;
-
-    struct ItemState
-    {
-        D3D12_RESOURCE_STATES State = {};
-        UploadStates Upload = UploadStates::None;
-
-        bool Drawable()
-        {
-            if (Upload != UploadStates::Uploaded)
-            {
-                return false;
-            }
-
-            switch (State)
-            {
-            case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER:
-            case D3D12_RESOURCE_STATE_GENERIC_READ:
-            case D3D12_RESOURCE_STATE_INDEX_BUFFER:
-            case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:
-                return true;
-            }
-
-            return false;
-        }
-    };
-    ItemState m_state = {};
-
-    UINT m_byteLength = 0;
-    UINT m_stride = 0;
-    UINT m_count = 0;
-
-    ResourceItem(const ComPtr<ID3D12Resource> &resource,
-                 D3D12_RESOURCE_STATES state,
-                 LPCWSTR name);
-
-    // avoid copy
-    ResourceItem(const ResourceItem &src) = delete;
-    ResourceItem &operator=(const ResourceItem &src) = delete;
-
-public:
-    ItemState State() const { return m_state; }
-    const ComPtr<ID3D12Resource> &Resource() const { return m_resource; }
-    UINT Count() const { return m_count; }
-
-    D3D12_VERTEX_BUFFER_VIEW VertexBufferView() const
-    {
-        return D3D12_VERTEX_BUFFER_VIEW{
-            .BufferLocation = m_resource->GetGPUVirtualAddress(),
-            .SizeInBytes = m_byteLength,
-            .StrideInBytes = m_stride,
-        };
-    }
-
-    D3D12_INDEX_BUFFER_VIEW IndexBufferView() const
-    {
-        auto view = D3D12_INDEX_BUFFER_VIEW{
-            .BufferLocation = m_resource->GetGPUVirtualAddress(),
-            .SizeInBytes = m_byteLength,
-        };
-        switch (m_stride)
-        {
-        case 4:
-            view.Format = DXGI_FORMAT_R32_UINT;
-            break;
-
-        case 2:
-            view.Format = DXGI_FORMAT_R16_UINT;
-            break;
-
-        default:
-            throw;
-        }
-        return view;
-    }
-
-    D3D12_GPU_VIRTUAL_ADDRESS GpuAddress() const
-    {
-        return m_resource->GetGPUVirtualAddress();
-    }
-
-    void MapCopyUnmap(const void *p, UINT byteLength, UINT stride);
-    void EnqueueTransition(class CommandList *commandList, D3D12_RESOURCE_STATES state);
-    void EnqueueUpload(class CommandList *commandList, const std::shared_ptr<class ResourceItem> &upload,
-                       const void *p, UINT byteLength, UINT stride);
-    // dynamic
-    static std::shared_ptr<ResourceItem> CreateUpload(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name);
-    // static
-    static std::shared_ptr<ResourceItem> CreateDefault(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name);
-    // static image
-    static std::shared_ptr<ResourceItem> CreateDefaultImage(const ComPtr<ID3D12Device> &device, UINT width, UINT height, LPCWSTR name);
-};
+#pragma once
+#include "Helper.h"
+#include "PlacedAllocator.h"
+#include <memory>
+
+namespace d12u
+{
+enum class UploadStates
+{
+    None,
+    Enqueued,
+    Uploaded,
+};
+
+/// ID3D12Resource helper
+///
+/// * State maintenance
+/// * Barrier helper
+///
+class ResourceItem : public std::enable_shared_from_this<ResourceItem>
+{
+    template <class T>
+    using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    ComPtr<ID3D12Resource> m_resource;
+    // invalid if committed resource
+    PlacedAllocation m_allocation;
+
+    struct ItemState
+    {
+        D3D12_RESOURCE_STATES State = {};
+        UploadStates Upload = UploadStates::None;
+
+        bool Drawable()
+        {
+            if (Upload != UploadStates::Uploaded)
+            {
+                return false;
+            }
+
+            switch (State)
+            {
+            case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER:
+            case D3D12_RESOURCE_STATE_GENERIC_READ:
+            case D3D12_RESOURCE_STATE_INDEX_BUFFER:
+            case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:
+                return true;
+            }
+
+            return false;
+        }
+    };
+    ItemState m_state = {};
+
+    UINT m_byteLength = 0;
+    UINT m_stride = 0;
+    UINT m_count = 0;
+    // heap bytes. for residency
+    UINT64 m_allocatedBytes = 0;
+
+    ResourceItem(const ComPtr<ID3D12Resource> &resource,
+                 D3D12_RESOURCE_STATES state,
+                 LPCWSTR name,
+                 const PlacedAllocation &allocation = {});
+
+    // placed if fit to PlacedAllocator page. else committed
+    static std::shared_ptr<ResourceItem> Create(const ComPtr<ID3D12Device> &device, PlacedHeapType type,
+                                                const D3D12_RESOURCE_DESC &desc, D3D12_RESOURCE_STATES state, LPCWSTR name);
+
+    // avoid copy
+    ResourceItem(const ResourceItem &src) = delete;
+    ResourceItem &operator=(const ResourceItem &src) = delete;
+
+public:
+    ~ResourceItem();
+    ItemState State() const { return m_state; }
+    const ComPtr<ID3D12Resource> &Resource() const { return m_resource; }
+    UINT Count() const { return m_count; }
+    UINT ByteLength() const { return m_byteLength; }
+    UINT Stride() const { return m_stride; }
+    UINT64 AllocatedBytes() const { return m_allocatedBytes; }
+
+    D3D12_VERTEX_BUFFER_VIEW VertexBufferView() const
+    {
+        return D3D12_VERTEX_BUFFER_VIEW{
+            .BufferLocation = m_resource->GetGPUVirtualAddress(),
+            .SizeInBytes = m_byteLength,
+            .StrideInBytes = m_stride,
+        };
+    }
+
+    D3D12_INDEX_BUFFER_VIEW IndexBufferView() const
+    {
+        auto view = D3D12_INDEX_BUFFER_VIEW{
+            .BufferLocation = m_resource->GetGPUVirtualAddress(),
+            .SizeInBytes = m_byteLength,
+        };
+        switch (m_stride)
+        {
+        case 4:
+            view.Format = DXGI_FORMAT_R32_UINT;
+            break;
+
+        case 2:
+            view.Format = DXGI_FORMAT_R16_UINT;
+            break;
+
+        default:
+            throw;
+        }
+        return view;
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS GpuAddress() const
+    {
+        return m_resource->GetGPUVirtualAddress();
+    }
+
+    void MapCopyUnmap(const void *p, UINT byteLength, UINT stride);
+    // upload buffer range. views are not changed
+    void MapCopyUnmap(UINT64 offset, const void *p, UINT64 byteLength);
+    void EnqueueTransition(class CommandList *commandList, D3D12_RESOURCE_STATES state);
+    void EnqueueUpload(class CommandList *commandList, const std::shared_ptr<class ResourceItem> &upload,
+                       const void *p, UINT byteLength, UINT stride);
+    // copy from upload already written at srcOffset to [dstOffset, dstOffset + byteLength).
+    // texture requires D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT and whole rows.
+    // stride is bytes of texel row or 4x4 block row. offsets and length are in rowPitch. stride if 0
+    void EnqueueCopy(class CommandList *commandList, const std::shared_ptr<class ResourceItem> &upload, UINT64 srcOffset,
+                     UINT dstOffset, UINT byteLength, UINT stride, UINT subresource = 0, UINT rowPitch = 0);
+    // Uploaded when commandList completed
+    void EnqueueUploaded(class CommandList *commandList, UINT byteLength, UINT stride);
+    // dynamic
+    static std::shared_ptr<ResourceItem> CreateUpload(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name);
+    // static
+    static std::shared_ptr<ResourceItem> CreateDefault(const ComPtr<ID3D12Device> &device, UINT byteLength, LPCWSTR name);
+    // static image
+    static std::shared_ptr<ResourceItem> CreateDefaultImage(const ComPtr<ID3D12Device> &device, UINT width, UINT height, LPCWSTR name,
+                                                            DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM, UINT16 mipLevels = 1);
+};
 } // namespace d12u
\ No newline at end of file
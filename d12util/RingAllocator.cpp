@@ -0,0 +1,79 @@
+#include "RingAllocator.h"
+#include <algorithm>
+
+namespace d12u
+{
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint64_t RingAllocator::Allocate(uint64_t byteLength, uint64_t alignment)
+{
+    if (byteLength == 0 || byteLength > m_capacity)
+    {
+        return INVALID;
+    }
+
+    if (m_used == 0)
+    {
+        // empty. restart from top
+        m_head = m_tail = 0;
+    }
+
+    uint64_t offset = AlignUp(m_head, alignment);
+    uint64_t end = offset + byteLength;
+    if (m_used > 0 && m_head <= m_tail)
+    {
+        // free is [head, tail)
+        if (end > m_tail)
+        {
+            return INVALID;
+        }
+    }
+    else if (end > m_capacity)
+    {
+        // free is [head, capacity) + [0, tail). skip end of ring
+        offset = 0;
+        end = byteLength;
+        if (end > m_tail)
+        {
+            return INVALID;
+        }
+    }
+
+    auto size = end > m_head ? end - m_head : m_capacity - m_head + end;
+    m_head = end == m_capacity ? 0 : end;
+    m_used += size;
+    m_open += size;
+    m_peak = std::max(m_peak, m_used);
+    return offset;
+}
+
+void RingAllocator::Close(uint64_t fenceValue)
+{
+    if (m_open == 0)
+    {
+        return;
+    }
+    m_regions.push_back({
+        .FenceValue = fenceValue,
+        .End = m_head,
+        .Size = m_open,
+    });
+    m_open = 0;
+}
+
+void RingAllocator::Retire(uint64_t completedValue)
+{
+    while (!m_regions.empty() && m_regions.front().FenceValue <= completedValue)
+    {
+        auto &region = m_regions.front();
+        m_tail = region.End;
+        m_used -= region.Size;
+        m_regions.pop_front();
+    }
+}
+
+} // namespace d12u
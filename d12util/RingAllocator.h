@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+
+namespace d12u
+{
+
+///
+/// sub allocator of a staging ring. no d3d12
+///
+/// * Allocate returns offset in [0, Capacity). INVALID if not fit
+/// * Close tags allocations since last Close with fence value
+/// * Retire frees regions of completed fence values. oldest first
+///
+class RingAllocator
+{
+    uint64_t m_capacity = 0;
+    // next allocation
+    uint64_t m_head = 0;
+    // oldest allocation in use
+    uint64_t m_tail = 0;
+    uint64_t m_used = 0;
+    uint64_t m_peak = 0;
+    // bytes since last Close. includes padding and skipped end of ring
+    uint64_t m_open = 0;
+
+    struct Region
+    {
+        uint64_t FenceValue;
+        // m_head at Close
+        uint64_t End;
+        uint64_t Size;
+    };
+    std::deque<Region> m_regions;
+
+public:
+    static constexpr uint64_t INVALID = ~0ull;
+
+    RingAllocator(uint64_t capacity = 0)
+        : m_capacity(capacity)
+    {
+    }
+    uint64_t Capacity() const { return m_capacity; }
+    uint64_t Used() const { return m_used; }
+    uint64_t Peak() const { return m_peak; }
+    // fence values not retired
+    size_t InFlight() const { return m_regions.size(); }
+
+    // alignment is power of 2
+    uint64_t Allocate(uint64_t byteLength, uint64_t alignment = 1);
+    void Close(uint64_t fenceValue);
+    void Retire(uint64_t completedValue);
+};
+
+} // namespace d12u
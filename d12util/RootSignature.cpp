@@ -1,295 +1,471 @@
-#include "RootSignature.h"
-#include "Shader.h"
-#include "Material.h"
-#include "ResourceItem.h"
-#include "Texture.h"
-#include "Uploader.h"
-#include <d3dcompiler.h>
-#include <algorithm>
-
-// VIEW_SLOTS=1;
-const int DRAW_SLOTS = 1024;
-const int TEXTURE_SLOTS = 1024;
-
-namespace d12u
-{
-
-RootSignature::RootSignature()
-    : m_heap(new Heap)
-{
-}
-
-bool RootSignature::Initialize(const ComPtr<ID3D12Device> &device)
-{
-    // Create a root signature consisting of a descriptor table with a single CBV.
-    D3D12_FEATURE_DATA_ROOT_SIGNATURE featureData = {
-        // This is the highest version the sample supports. If CheckFeatureSupport succeeds, the HighestVersion returned will not be greater than this.
-        .HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_1,
-    };
-    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &featureData, sizeof(featureData))))
-    {
-        throw;
-    }
-
-    D3D12_DESCRIPTOR_RANGE1 ranges[] = {
-        {
-            .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV,
-            .NumDescriptors = 1,
-            .BaseShaderRegister = 0,
-            .RegisterSpace = 0,
-            .Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC,
-            // . OffsetInDescriptorsFromTableStart,
-        },
-        {
-            .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV,
-            .NumDescriptors = 1,
-            .BaseShaderRegister = 1,
-            .RegisterSpace = 0,
-            .Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC,
-            // . OffsetInDescriptorsFromTableStart,
-        },
-        {
-            .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV,
-            .NumDescriptors = 1,
-            .BaseShaderRegister = 0,
-            .RegisterSpace = 0,
-            // .Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC,
-        },
-    };
-
-    D3D12_ROOT_PARAMETER1 rootParameters[] = {
-        // scene
-        {
-            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
-            .DescriptorTable = {
-                .NumDescriptorRanges = 1,
-                .pDescriptorRanges = &ranges[0],
-            },
-            .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
-        },
-        // world
-        {
-            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
-            .DescriptorTable = {
-                .NumDescriptorRanges = 1,
-                .pDescriptorRanges = &ranges[1],
-            },
-            .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
-        },
-        // SRV
-        {
-            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
-            .DescriptorTable = {
-                .NumDescriptorRanges = 1,
-                .pDescriptorRanges = &ranges[2],
-            },
-            .ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL,
-        },
-    };
-
-    // Allow input layout and deny unecessary access to certain pipeline stages.
-    D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
-        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT //
-        | D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS     //
-        | D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS   //
-        | D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS //
-        // | D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS      //
-        ;
-
-    D3D12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc{
-        .Version = D3D_ROOT_SIGNATURE_VERSION_1_1,
-        .Desc_1_1{
-            .NumParameters = _countof(rootParameters),
-            .pParameters = rootParameters,
-            .Flags = rootSignatureFlags,
-        },
-    };
-
-    D3D12_STATIC_SAMPLER_DESC sampler = {
-        .Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR,
-        .AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
-        .AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
-        .AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
-        .ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER,
-        .MaxLOD = D3D12_FLOAT32_MAX,
-        .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
-    };
-    rootSignatureDesc.Desc_1_1.pStaticSamplers = &sampler;
-    rootSignatureDesc.Desc_1_1.NumStaticSamplers = 1;
-
-    ComPtr<ID3DBlob> signature;
-    ComPtr<ID3DBlob> error;
-    ThrowIfFailed(D3D12SerializeVersionedRootSignature(&rootSignatureDesc, &signature, &error));
-    ThrowIfFailed(device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&m_rootSignature)));
-
-    //
-    // buffers
-    //
-    m_viewConstantsBuffer.Initialize(device, 1);
-
-    m_drawConstantsBuffer.Initialize(device, DRAW_SLOTS);
-    auto count = 1 + DRAW_SLOTS + TEXTURE_SLOTS;
-    m_heap->Initialize(device, count);
-
-    {
-        auto [offset, size] = m_viewConstantsBuffer.Range(0);
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {
-            .BufferLocation = m_viewConstantsBuffer.Resource()->GetGPUVirtualAddress() + offset,
-            .SizeInBytes = size,
-        };
-        device->CreateConstantBufferView(&cbvDesc, m_heap->CpuHandle(0));
-    }
-
-    return true;
-}
-
-void RootSignature::Update(const ComPtr<ID3D12Device> &device)
-{
-    // update shader
-    // for (auto kv : m_shaderMap)
-    // {
-    //     auto [source, generation] = kv.first->source();
-    //     if (!source.empty())
-    //     {
-    //         if (!kv.second->Initialize(device, source, generation))
-    //         {
-    //             kv.first->clear();
-    //         }
-    //     }
-    // }
-
-    for (auto kv : m_materialMap)
-    {
-        kv.second->Initialize(device, kv.first);
-    }
-}
-
-void RootSignature::Begin(const ComPtr<ID3D12Device> &device, const ComPtr<ID3D12GraphicsCommandList> &commandList)
-{
-    commandList->SetGraphicsRootSignature(m_rootSignature.Get());
-    ID3D12DescriptorHeap *ppHeaps[] = {m_heap->Get()};
-    commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-    commandList->SetGraphicsRootDescriptorTable(0, m_heap->GpuHandle(0));
-}
-
-// std::shared_ptr<Shader> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::ShaderWatcherPtr &shader)
-// {
-//     auto found = m_shaderMap.find(shader);
-//     if (found != m_shaderMap.end())
-//     {
-//         return found->second;
-//     }
-
-//     auto gpuShader = std::make_shared<Shader>(shader->name());
-//     auto [source, generation] = shader->source();
-//     if (!source.empty())
-//     {
-//         if (!gpuShader->Initialize(device, source, generation))
-//         {
-//             shader->clear();
-//         }
-//     }
-
-//     m_shaderMap.insert(std::make_pair(shader, gpuShader));
-//     return gpuShader;
-// }
-
-std::shared_ptr<Material> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const std::shared_ptr<hierarchy::SceneMaterial> &sceneMaterial)
-{
-    auto found = m_materialMap.find(sceneMaterial);
-    if (found != m_materialMap.end())
-    {
-        return found->second;
-    }
-
-    // shader
-    // auto gpuShader = GetOrCreate(device, sceneMaterial->shader);
-    // if (!gpuShader)
-    // {
-    //     return nullptr;
-    // }
-
-    auto gpuMaterial = std::make_shared<Material>();
-    if (!gpuMaterial->Initialize(device, m_rootSignature, sceneMaterial))
-    {
-        throw;
-    }
-
-    m_materialMap.insert(std::make_pair(sceneMaterial, gpuMaterial));
-    return gpuMaterial;
-}
-
-std::pair<std::shared_ptr<class Texture>, UINT> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image,
-                                                                           Uploader *uploader)
-{
-    auto found = m_textureMap.find(image);
-    if (found != m_textureMap.end())
-    {
-        return std::make_pair(m_textures[found->second], found->second);
-    }
-
-    // create texture
-    auto gpuTexture = std::make_shared<Texture>();
-    {
-        auto resource = ResourceItem::CreateDefaultImage(device, image->width, image->height, image->name.c_str());
-        gpuTexture->ImageBuffer(resource);
-        uploader->EnqueueUpload(resource, image->buffer.data(), (UINT)image->buffer.size(), image->width * 4);
-    }
-
-    auto index = (UINT)m_textures.size();
-    m_textures.push_back(gpuTexture);
-    m_textureMap.insert(std::make_pair(image, index));
-
-    // create view
-    D3D12_SHADER_RESOURCE_VIEW_DESC desc{
-        .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
-        .ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D,
-        .Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING,
-        .Texture2D = {
-            .MostDetailedMip = 0,
-            .MipLevels = 1,
-        },
-    };
-    device->CreateShaderResourceView(gpuTexture->Resource().Get(), &desc, m_heap->CpuHandle(index + 1 + DRAW_SLOTS));
-
-    return std::make_pair(gpuTexture, index);
-}
-
-void RootSignature::SetDrawDescriptorTable(const ComPtr<ID3D12Device> &device,
-                                           const ComPtr<ID3D12GraphicsCommandList> &commandList, UINT nodeIndex)
-{
-    // m_heap->CreateView();
-    // void Heap::CreateView(const ComPtr<ID3D12Device> &device, UINT cbIndex)
-    // {
-
-    std::pair<uint32_t, uint32_t> view = {};
-    if (nodeIndex < m_viewList.size())
-    {
-        view = m_viewList[nodeIndex];
-    }
-    else
-    {
-        m_viewList.resize(nodeIndex + 1);
-    }
-
-    auto [offset, size] = m_drawConstantsBuffer.Range(nodeIndex);
-    if (view.first != offset || view.second != size)
-    {
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {
-            .BufferLocation = m_drawConstantsBuffer.Resource()->GetGPUVirtualAddress() + offset,
-            .SizeInBytes = size,
-        };
-        device->CreateConstantBufferView(&cbvDesc, m_heap->CpuHandle(1 + nodeIndex));
-        m_viewList[nodeIndex] = {offset, size};
-    }
-
-    commandList->SetGraphicsRootDescriptorTable(1, m_heap->GpuHandle(1 + nodeIndex));
-}
-
-void RootSignature::SetTextureDescriptorTable(const ComPtr<ID3D12Device> &device,
-                                              const ComPtr<ID3D12GraphicsCommandList> &commandList, UINT textureIndex)
-{
-    commandList->SetGraphicsRootDescriptorTable(2, m_heap->GpuHandle(1 + DRAW_SLOTS + textureIndex));
-}
-
+#include "RootSignature.h"
+#include "Shader.h"
+#include "Material.h"
+#include "ResourceItem.h"
+#include "Texture.h"
+#include "Uploader.h"
+#include "DescriptorAllocator.h"
+#include "PipelineCache.h"
+#include "ResidencyTracker.h"
+#include <d3dcompiler.h>
+#include <algorithm>
+
+namespace d12u
+{
+
+RootSignature::RootSignature(UINT frameCount, ResidencyTracker *residency)
+    : m_descriptors(new DescriptorAllocator), m_pipelines(new PipelineCache), m_residency(residency),
+      m_frameCount(std::max(frameCount, 1u))
+{
+}
+
+RootSignature::~RootSignature()
+{
+}
+
+bool RootSignature::Initialize(const ComPtr<ID3D12Device> &device, const std::filesystem::path &pipelineCache,
+                               const std::filesystem::path &textureCache)
+{
+    // Create a root signature consisting of a descriptor table with a single CBV.
+    D3D12_FEATURE_DATA_ROOT_SIGNATURE featureData = {
+        // This is the highest version the sample supports. If CheckFeatureSupport succeeds, the HighestVersion returned will not be greater than this.
+        .HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_1,
+    };
+    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &featureData, sizeof(featureData))))
+    {
+        throw;
+    }
+
+    D3D12_DESCRIPTOR_RANGE1 ranges[] = {
+        {
+            .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV,
+            .NumDescriptors = 1,
+            .BaseShaderRegister = 1,
+            .RegisterSpace = 0,
+            .Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC,
+            // . OffsetInDescriptorsFromTableStart,
+        },
+        {
+            .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV,
+            .NumDescriptors = 1,
+            .BaseShaderRegister = 0,
+            .RegisterSpace = 0,
+            // .Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC,
+        },
+    };
+
+    D3D12_ROOT_PARAMETER1 rootParameters[] = {
+        // scene. root CBV. independent of descriptor heap page
+        {
+            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV,
+            .Descriptor = {
+                .ShaderRegister = 0,
+                .RegisterSpace = 0,
+            },
+            .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
+        },
+        // world
+        {
+            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
+            .DescriptorTable = {
+                .NumDescriptorRanges = 1,
+                .pDescriptorRanges = &ranges[0],
+            },
+            .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
+        },
+        // SRV
+        {
+            .ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
+            .DescriptorTable = {
+                .NumDescriptorRanges = 1,
+                .pDescriptorRanges = &ranges[1],
+            },
+            .ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL,
+        },
+    };
+
+    // Allow input layout and deny unecessary access to certain pipeline stages.
+    D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
+        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT //
+        | D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS     //
+        | D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS   //
+        | D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS //
+        // | D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS      //
+        ;
+
+    D3D12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc{
+        .Version = D3D_ROOT_SIGNATURE_VERSION_1_1,
+        .Desc_1_1{
+            .NumParameters = _countof(rootParameters),
+            .pParameters = rootParameters,
+            .Flags = rootSignatureFlags,
+        },
+    };
+
+    D3D12_STATIC_SAMPLER_DESC sampler = {
+        .Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+        .AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
+        .AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
+        .AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
+        .ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER,
+        .MaxLOD = D3D12_FLOAT32_MAX,
+        .ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL,
+    };
+    rootSignatureDesc.Desc_1_1.pStaticSamplers = &sampler;
+    rootSignatureDesc.Desc_1_1.NumStaticSamplers = 1;
+
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+    ThrowIfFailed(D3D12SerializeVersionedRootSignature(&rootSignatureDesc, &signature, &error));
+    ThrowIfFailed(device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&m_rootSignature)));
+
+    //
+    // buffers
+    //
+    m_viewConstantsBuffer.Initialize(device, (int)m_frameCount);
+    m_descriptors->Initialize(device);
+    m_pipelines->Initialize(device, pipelineCache);
+    m_textures.reset(new hierarchy::TextureCache(textureCache));
+
+    return true;
+}
+
+void RootSignature::Update(const ComPtr<ID3D12Device> &device)
+{
+    // update shader
+    // for (auto kv : m_shaderMap)
+    // {
+    //     auto [source, generation] = kv.first->source();
+    //     if (!source.empty())
+    //     {
+    //         if (!kv.second->Initialize(device, source, generation))
+    //         {
+    //             kv.first->clear();
+    //         }
+    //     }
+    // }
+
+    for (auto kv : m_materialMap)
+    {
+        kv.second->Initialize(device, kv.first);
+    }
+
+    // worker does not read bytes any more
+    auto end = std::remove_if(m_releasedRequests.begin(), m_releasedRequests.end(), [](const auto &released) {
+        if (!released.second->IsReady())
+        {
+            return false;
+        }
+        released.first->payload.EndUpload(&released.first->Bytes());
+        return true;
+    });
+    m_releasedRequests.erase(end, m_releasedRequests.end());
+}
+
+void RootSignature::BeginFrame(UINT frameIndex, UINT64 completedValue)
+{
+    m_frameIndex = frameIndex % m_frameCount;
+    m_descriptors->BeginFrame(completedValue);
+}
+
+void RootSignature::EndFrame(UINT64 fenceValue)
+{
+    m_descriptors->EndFrame(fenceValue);
+}
+
+void RootSignature::Begin(const ComPtr<ID3D12Device> &device, const ComPtr<ID3D12GraphicsCommandList> &commandList)
+{
+    commandList->SetGraphicsRootSignature(m_rootSignature.Get());
+    // heap may be changed by others
+    m_descriptors->Unbind();
+    auto [offset, size] = m_viewConstantsBuffer.Range(m_frameIndex);
+    commandList->SetGraphicsRootConstantBufferView(0, m_viewConstantsBuffer.Resource()->GetGPUVirtualAddress() + offset);
+}
+
+// std::shared_ptr<Shader> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::ShaderWatcherPtr &shader)
+// {
+//     auto found = m_shaderMap.find(shader);
+//     if (found != m_shaderMap.end())
+//     {
+//         return found->second;
+//     }
+
+//     auto gpuShader = std::make_shared<Shader>(shader->name());
+//     auto [source, generation] = shader->source();
+//     if (!source.empty())
+//     {
+//         if (!gpuShader->Initialize(device, source, generation))
+//         {
+//             shader->clear();
+//         }
+//     }
+
+//     m_shaderMap.insert(std::make_pair(shader, gpuShader));
+//     return gpuShader;
+// }
+
+std::shared_ptr<Material> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const std::shared_ptr<hierarchy::SceneMaterial> &sceneMaterial)
+{
+    auto found = m_materialMap.find(sceneMaterial);
+    if (found != m_materialMap.end())
+    {
+        if (m_residency)
+        {
+            m_residency->Touch(sceneMaterial.get());
+        }
+        return found->second;
+    }
+
+    // shader
+    // auto gpuShader = GetOrCreate(device, sceneMaterial->shader);
+    // if (!gpuShader)
+    // {
+    //     return nullptr;
+    // }
+
+    auto gpuMaterial = std::make_shared<Material>();
+    if (!gpuMaterial->Initialize(device, m_rootSignature, m_pipelines.get(), sceneMaterial))
+    {
+        throw;
+    }
+
+    m_materialMap.insert(std::make_pair(sceneMaterial, gpuMaterial));
+    if (m_residency)
+    {
+        // pipeline state is owned by PipelineCache
+        std::weak_ptr<hierarchy::SceneMaterial> weak = sceneMaterial;
+        m_residency->Add(sceneMaterial, ResidencyCategory::Material, 0, [this, weak]() {
+            if (auto sceneMaterial = weak.lock())
+            {
+                Release(sceneMaterial);
+            }
+        });
+    }
+    return gpuMaterial;
+}
+
+void RootSignature::Release(const hierarchy::SceneMaterialPtr &material)
+{
+    if (m_residency)
+    {
+        m_residency->Remove(material.get());
+    }
+    m_materialMap.erase(material);
+}
+
+// levels are copied to staging as is
+static_assert(hierarchy::TEXTURE_PITCH_ALIGNMENT == D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+
+static DXGI_FORMAT ToDXGI(hierarchy::TextureFormat format)
+{
+    switch (format)
+    {
+    case hierarchy::TextureFormat::RGBA8:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case hierarchy::TextureFormat::BC1:
+        return DXGI_FORMAT_BC1_UNORM;
+    case hierarchy::TextureFormat::BC3:
+        return DXGI_FORMAT_BC3_UNORM;
+    case hierarchy::TextureFormat::BC7:
+        return DXGI_FORMAT_BC7_UNORM;
+    }
+    throw "unknown TextureFormat";
+}
+
+std::pair<std::shared_ptr<class Texture>, Slot> RootSignature::GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image,
+                                                                           Uploader *uploader)
+{
+    auto found = m_textureMap.find(image);
+    if (found != m_textureMap.end())
+    {
+        if (m_residency)
+        {
+            m_residency->Touch(image.get());
+        }
+        auto &entry = found->second;
+        if (!entry.Texture && entry.Request && entry.Request->IsReady())
+        {
+            // source bytes are no longer used
+            image->payload.EndUpload(&image->Bytes());
+            if (auto processed = entry.Request->Get())
+            {
+                CreateTexture(device, image, &entry, processed, uploader);
+            }
+            // broken image keeps placeholder
+            entry.Request.reset();
+        }
+        if (!entry.Texture)
+        {
+            return Placeholder(device, uploader);
+        }
+        return std::make_pair(entry.Texture, entry.SRV);
+    }
+
+    if (image->width <= 0 || image->height <= 0)
+    {
+        // broken image
+        return {};
+    }
+
+    // released after the previous upload
+    auto &bytes = image->Bytes();
+    if (!image->payload.Rematerialize(&bytes))
+    {
+        return {};
+    }
+
+    // keep bytes until processed. encoded image is decoded on worker
+    image->payload.BeginUpload();
+    auto request = image->type == hierarchy::ImageType::Encoded
+                       ? m_textures->EnqueueEncoded(image, bytes.data(), bytes.size(), image->width, image->height, TextureOptions)
+                       : m_textures->Enqueue(image, bytes.data(), image->width, image->height, TextureOptions);
+    m_textureMap.insert(std::make_pair(image, TextureEntry{.Request = request}));
+
+    if (m_residency)
+    {
+        // bytes after processed
+        std::weak_ptr<hierarchy::SceneImage> weak = image;
+        m_residency->Add(image, ResidencyCategory::Texture, 0, [this, weak]() {
+            if (auto image = weak.lock())
+            {
+                Release(image);
+            }
+        });
+    }
+    return Placeholder(device, uploader);
+}
+
+std::pair<std::shared_ptr<class Texture>, Slot> RootSignature::Placeholder(const ComPtr<ID3D12Device> &device, Uploader *uploader)
+{
+    if (!m_placeholder.Texture)
+    {
+        // multiplied by material color
+        static const uint8_t WHITE[] = {255, 255, 255, 255};
+        auto resource = ResourceItem::CreateDefaultImage(device, 1, 1, L"##placeholder##");
+        m_placeholder.Texture = std::make_shared<Texture>();
+        m_placeholder.Texture->ImageBuffer(resource);
+        uploader->EnqueueUpload(resource, WHITE, sizeof(WHITE), sizeof(WHITE), UploadPriority::Mesh);
+        m_placeholder.SRV = m_descriptors->AllocatePersistent();
+        CreateView(device, resource, DXGI_FORMAT_R8G8B8A8_UNORM, 1, m_placeholder.SRV);
+    }
+    return std::make_pair(m_placeholder.Texture, m_placeholder.SRV);
+}
+
+void RootSignature::CreateView(const ComPtr<ID3D12Device> &device, const std::shared_ptr<ResourceItem> &resource,
+                               DXGI_FORMAT format, UINT mipLevels, const Slot &slot)
+{
+    D3D12_SHADER_RESOURCE_VIEW_DESC desc{
+        .Format = format,
+        .ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D,
+        .Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING,
+        .Texture2D = {
+            .MostDetailedMip = 0,
+            .MipLevels = mipLevels,
+        },
+    };
+    device->CreateShaderResourceView(resource->Resource().Get(), &desc, m_descriptors->PersistentCpuHandle(slot));
+}
+
+void RootSignature::CreateTexture(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image, TextureEntry *entry,
+                                  const std::shared_ptr<const hierarchy::ProcessedTexture> &processed, Uploader *uploader)
+{
+    auto format = ToDXGI(processed->Format);
+    auto mipLevels = (UINT16)processed->Levels.size();
+
+    // create texture
+    auto gpuTexture = std::make_shared<Texture>();
+    auto resource = ResourceItem::CreateDefaultImage(device, image->width, image->height, image->name.c_str(), format, mipLevels);
+    gpuTexture->ImageBuffer(resource);
+    for (UINT i = 0; i < mipLevels; ++i)
+    {
+        auto &level = processed->Levels[i];
+        auto command = std::make_shared<UploadCommand>(resource, level.Bytes.data(), (UINT)level.Bytes.size(), level.RowBytes,
+                                                       UploadPriority::Texture);
+        command->Subresource = i;
+        command->RowPitch = level.RowPitch;
+        command->MarkUploaded = i + 1 == mipLevels;
+        if (command->MarkUploaded)
+        {
+            // keep levels until copied
+            command->OnUploaded = [processed]() {};
+        }
+        uploader->EnqueueUpload(command);
+    }
+    entry->Texture = gpuTexture;
+
+    // create view
+    entry->SRV = m_descriptors->AllocatePersistent();
+    CreateView(device, resource, format, mipLevels, entry->SRV);
+
+    if (m_residency)
+    {
+        std::weak_ptr<hierarchy::SceneImage> weak = image;
+        m_residency->Add(image, ResidencyCategory::Texture, resource->AllocatedBytes(), [this, weak]() {
+            if (auto image = weak.lock())
+            {
+                Release(image);
+            }
+        });
+    }
+}
+
+void RootSignature::Release(const hierarchy::SceneImagePtr &image)
+{
+    if (m_residency)
+    {
+        m_residency->Remove(image.get());
+    }
+    auto found = m_textureMap.find(image);
+    if (found == m_textureMap.end())
+    {
+        return;
+    }
+    if (auto &request = found->second.Request)
+    {
+        if (request->IsReady())
+        {
+            // processed but not created. worker does not read bytes any more
+            image->payload.EndUpload(&image->Bytes());
+        }
+        else
+        {
+            // Update calls EndUpload when processed
+            m_releasedRequests.push_back({image, request});
+        }
+    }
+    // frame slots have copies. persistent slot is free now
+    if (found->second.SRV)
+    {
+        m_descriptors->FreePersistent(found->second.SRV);
+    }
+    m_textureMap.erase(found);
+}
+
+void RootSignature::SetDrawDescriptorTable(const ComPtr<ID3D12Device> &device,
+                                           const ComPtr<ID3D12GraphicsCommandList> &commandList,
+                                           D3D12_GPU_VIRTUAL_ADDRESS drawConstants, UINT byteLength,
+                                           const Slot &texture)
+{
+    // [b1, t0] in same page
+    auto slot = m_descriptors->AllocateFrame(texture ? 2 : 1);
+
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {
+        .BufferLocation = drawConstants,
+        .SizeInBytes = byteLength,
+    };
+    device->CreateConstantBufferView(&cbvDesc, m_descriptors->FrameCpuHandle(slot));
+    Slot srv{slot.Page, slot.Index + 1};
+    if (texture)
+    {
+        m_descriptors->CopyToFrame(texture, srv);
+    }
+
+    m_descriptors->Bind(commandList, slot);
+    commandList->SetGraphicsRootDescriptorTable(1, m_descriptors->FrameGpuHandle(slot));
+    if (texture)
+    {
+        commandList->SetGraphicsRootDescriptorTable(2, m_descriptors->FrameGpuHandle(srv));
+    }
+}
+
 } // namespace d12u
\ No newline at end of file
@@ -1,77 +1,128 @@
-#pragma once
-#include "Helper.h"
-#include "Heap.h"
-#include "ConstantBuffer.h"
-#include <memory>
-#include <array>
-#include <unordered_map>
-#include <SceneMaterial.h>
-#include <DirectXMath.h>
-
-namespace d12u
-{
-
-/// Shader spec
-///
-/// * each ConstantBuffer type
-/// * manipulation of HeapDescriptor
-///
-class RootSignature : NonCopyable
-{
-    ComPtr<ID3D12RootSignature> m_rootSignature;
-    std::unique_ptr<Heap> m_heap;
-    std::vector<std::pair<uint32_t, uint32_t>> m_viewList;
-
-    // std::unordered_map<hierarchy::ShaderWatcherPtr, std::shared_ptr<class Shader>> m_shaderMap;
-    std::unordered_map<hierarchy::SceneMaterialPtr, std::shared_ptr<class Material>> m_materialMap;
-    std::vector<std::shared_ptr<class Texture>> m_textures;
-    std::unordered_map<hierarchy::SceneImagePtr, uint32_t> m_textureMap;
-
-public:
-    RootSignature();
-    bool Initialize(const ComPtr<ID3D12Device> &device);
-    // polling shader update
-    void Update(const ComPtr<ID3D12Device> &device);
-    void Begin(const ComPtr<ID3D12Device> &device, const ComPtr<ID3D12GraphicsCommandList> &commandList);
-    // std::shared_ptr<class Shader> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::ShaderWatcherPtr &shader);
-    std::shared_ptr<class Material> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneMaterialPtr &material);
-    std::pair<std::shared_ptr<class Texture>, UINT> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image, class Uploader *uploader);
-
-// each View
-// https://gamedev.stackexchange.com/questions/105572/c-struct-doesnt-align-correctly-to-a-pixel-shader-cbuffer
-#pragma pack(push)
-#pragma pack(16)
-    struct ViewConstants
-    {
-        std::array<float, 16> b0View;
-        std::array<float, 16> b0Projection;
-        std::array<float, 3> b0LightDir;
-        float _padding0;
-        std::array<float, 3> b0LightColor;
-        float _padding1;
-        std::array<float, 3> b0CameraPosition;
-        float _padding2;
-        std::array<float, 2> b0ScreenSize;
-        float fovY;
-        float _padding3;
-        // DirectX::XMFLOAT4X4 b0ViewInv;
-    };
-#pragma pack(pop)
-    static_assert(sizeof(ViewConstants) == 16 * 12, "sizeof ViewConstantsSize");
-
-    d12u::ConstantBuffer<ViewConstants> m_viewConstantsBuffer;
-    ViewConstants *GetViewConstantsBuffer(UINT index)
-    {
-        return m_viewConstantsBuffer.GetTyped(index);
-    }
-
-    // each DrawCall
-    d12u::SemanticsConstantBuffer m_drawConstantsBuffer{1024};
-
-    void SetDrawDescriptorTable(const ComPtr<ID3D12Device> &device,
-                                const ComPtr<ID3D12GraphicsCommandList> &commandList, UINT nodeIndex);
-    void SetTextureDescriptorTable(const ComPtr<ID3D12Device> &device,
-                                   const ComPtr<ID3D12GraphicsCommandList> &commandList, UINT textureIndex);
-};
-
-} // namespace d12u
+#pragma once
+#include "Helper.h"
+#include "ConstantBuffer.h"
+#include "SlotAllocator.h"
+#include <memory>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <SceneMaterial.h>
+#include <TextureCache.h>
+#include <DirectXMath.h>
+
+namespace d12u
+{
+
+/// Shader spec
+///
+/// * each ConstantBuffer type
+/// * b0: root CBV. b1, t0: descriptor tables in DescriptorAllocator frame slots
+/// * view constants for each frame in flight. BeginFrame selects the frame
+/// * textures are decoded and processed by TextureCache on workers. placeholder until ready
+///
+class RootSignature : NonCopyable
+{
+    ComPtr<ID3D12RootSignature> m_rootSignature;
+    std::unique_ptr<class DescriptorAllocator> m_descriptors;
+    std::unique_ptr<class PipelineCache> m_pipelines;
+    std::unique_ptr<hierarchy::TextureCache> m_textures;
+    // not owned. nullptr keeps materials and textures forever
+    class ResidencyTracker *m_residency;
+
+    // std::unordered_map<hierarchy::ShaderWatcherPtr, std::shared_ptr<class Shader>> m_shaderMap;
+    std::unordered_map<hierarchy::SceneMaterialPtr, std::shared_ptr<class Material>> m_materialMap;
+    struct TextureEntry
+    {
+        // nullptr while Request is processing
+        std::shared_ptr<class Texture> Texture;
+        // persistent SRV
+        Slot SRV;
+        std::shared_ptr<hierarchy::TextureCache::Request> Request;
+    };
+    std::unordered_map<hierarchy::SceneImagePtr, TextureEntry> m_textureMap;
+    // released while processing. EndUpload when ready
+    std::vector<std::pair<hierarchy::SceneImagePtr, std::shared_ptr<hierarchy::TextureCache::Request>>> m_releasedRequests;
+    // 1x1 white
+    TextureEntry m_placeholder;
+
+    UINT m_frameCount;
+    UINT m_frameIndex = 0;
+
+    std::pair<std::shared_ptr<class Texture>, Slot> Placeholder(const ComPtr<ID3D12Device> &device, class Uploader *uploader);
+    void CreateView(const ComPtr<ID3D12Device> &device, const std::shared_ptr<class ResourceItem> &resource,
+                    DXGI_FORMAT format, UINT mipLevels, const Slot &slot);
+    void CreateTexture(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image, TextureEntry *entry,
+                       const std::shared_ptr<const hierarchy::ProcessedTexture> &processed, class Uploader *uploader);
+
+public:
+    // mip chain and block compression of new textures
+    hierarchy::TextureOptions TextureOptions;
+
+    RootSignature(UINT frameCount = 1, class ResidencyTracker *residency = nullptr);
+    ~RootSignature();
+    // pipelineCache: file of ID3D12PipelineLibrary. textureCache: directory of processed textures.
+    // empty is not persistent
+    bool Initialize(const ComPtr<ID3D12Device> &device, const std::filesystem::path &pipelineCache = {},
+                    const std::filesystem::path &textureCache = {});
+    // polling shader update
+    void Update(const ComPtr<ID3D12Device> &device);
+    // frameIndex: slot of per frame buffers. completedValue: fence of the oldest frame in flight
+    void BeginFrame(UINT frameIndex, UINT64 completedValue);
+    void EndFrame(UINT64 fenceValue);
+    void Begin(const ComPtr<ID3D12Device> &device, const ComPtr<ID3D12GraphicsCommandList> &commandList);
+    // std::shared_ptr<class Shader> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::ShaderWatcherPtr &shader);
+    std::shared_ptr<class Material> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneMaterialPtr &material);
+    // placeholder until processed and enqueued. empty if bytes are lost
+    std::pair<std::shared_ptr<class Texture>, Slot> GetOrCreate(const ComPtr<ID3D12Device> &device, const hierarchy::SceneImagePtr &image, class Uploader *uploader);
+    // evict material. called by ResidencyTracker::Evict
+    void Release(const hierarchy::SceneMaterialPtr &material);
+    // evict texture. release SRV slot
+    void Release(const hierarchy::SceneImagePtr &image);
+
+    // stats of the owned allocators and caches. TextureCache is nullptr before Initialize
+    class DescriptorAllocator *Descriptors() { return m_descriptors.get(); }
+    class PipelineCache *Pipelines() { return m_pipelines.get(); }
+    hierarchy::TextureCache *Textures() { return m_textures.get(); }
+
+// each View
+// https://gamedev.stackexchange.com/questions/105572/c-struct-doesnt-align-correctly-to-a-pixel-shader-cbuffer
+#pragma pack(push)
+#pragma pack(16)
+    struct ViewConstants
+    {
+        std::array<float, 16> b0View;
+        std::array<float, 16> b0Projection;
+        std::array<float, 3> b0LightDir;
+        float _padding0;
+        std::array<float, 3> b0LightColor;
+        float _padding1;
+        std::array<float, 3> b0CameraPosition;
+        float _padding2;
+        std::array<float, 2> b0ScreenSize;
+        float fovY;
+        float _padding3;
+        // DirectX::XMFLOAT4X4 b0ViewInv;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(ViewConstants) == 16 * 12, "sizeof ViewConstantsSize");
+
+    // each frame in flight
+    d12u::ConstantBuffer<ViewConstants> m_viewConstantsBuffer;
+    ViewConstants *GetViewConstantsBuffer()
+    {
+        return m_viewConstantsBuffer.GetTyped(m_frameIndex);
+    }
+    void CopyViewConstantsToGpu()
+    {
+        m_viewConstantsBuffer.CopyToGpu(m_frameIndex);
+    }
+
+    // b1 and t0 if texture is valid. draw constants are in a Backend buffer
+    void SetDrawDescriptorTable(const ComPtr<ID3D12Device> &device,
+                                const ComPtr<ID3D12GraphicsCommandList> &commandList,
+                                D3D12_GPU_VIRTUAL_ADDRESS drawConstants, UINT byteLength,
+                                const Slot &texture = {});
+};
+
+} // namespace d12u
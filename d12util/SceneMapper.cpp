@@ -1,152 +1,209 @@
-#include "SceneMapper.h"
-#include "ResourceItem.h"
-#include "Mesh.h"
-#include "Texture.h"
-#include "Uploader.h"
-#include "RootSignature.h"
-#include "RenderTarget.h"
-#include <hierarchy.h>
-#include <DirectXMath.h>
-#include <plog/Log.h>
-
-namespace d12u
-{
-SceneMapper::SceneMapper()
-    : m_uploader(new Uploader)
-{
-}
-
-void SceneMapper::Initialize(const ComPtr<ID3D12Device> &device)
-{
-    m_uploader->Initialize(device);
-}
-
-void SceneMapper::Update(const ComPtr<ID3D12Device> &device)
-{
-    m_uploader->Update(device);
-}
-
-static int GetStride(DXGI_FORMAT format)
-{
-    switch (format)
-    {
-    case DXGI_FORMAT_B8G8R8A8_UNORM:
-        return 4;
-
-    case DXGI_FORMAT_R32G32_FLOAT:
-        return 8;
-
-    case DXGI_FORMAT_R32G32B32_FLOAT:
-        return 12;
-
-    case DXGI_FORMAT_R32G32B32A32_FLOAT:
-        return 16;
-    }
-
-    throw;
-}
-
-std::shared_ptr<Mesh> SceneMapper::GetOrCreate(const ComPtr<ID3D12Device> &device,
-                                               const std::shared_ptr<hierarchy::SceneMesh> &sceneMesh,
-                                               RootSignature *rootSignature)
-{
-    auto found = m_meshMap.find(sceneMesh);
-    if (found != m_meshMap.end())
-    {
-        return found->second;
-    }
-
-    if (!rootSignature)
-    {
-        return nullptr;
-    }
-
-    if (sceneMesh->submeshes.empty())
-    {
-        return nullptr;
-    }
-
-    auto gpuMesh = std::make_shared<Mesh>();
-
-    // vertices
-    {
-        // first material's shader for input layout
-        auto shader = sceneMesh->submeshes[0].material->shader->Compiled();
-        // auto resource = CreateResourceItem(device, m_uploader, sceneMesh, shader->inputLayout(), shader->inputLayoutCount());
-        auto dstStride = 0;
-        int inputLayoutCount;
-        auto inputLayout = shader->inputLayout(&inputLayoutCount);
-        for (int i = 0; i < inputLayoutCount; ++i)
-        {
-            dstStride += GetStride(inputLayout[i].Format);
-        }
-
-        // vertices
-        auto vertices = sceneMesh->vertices;
-        if (vertices->stride != dstStride)
-        {
-            LOGE << "buffer stride difference with shader stride";
-            return nullptr;
-        }
-
-        std::shared_ptr<ResourceItem> resource;
-        if (vertices->isDynamic)
-        {
-            resource = ResourceItem::CreateUpload(device, (UINT)vertices->buffer.size(), sceneMesh->name.c_str());
-            // not enqueue
-        }
-        else if (sceneMesh->skin)
-        {
-            resource = ResourceItem::CreateUpload(device, (UINT)vertices->buffer.size(), sceneMesh->name.c_str());
-            // not enqueue
-        }
-        else
-        {
-            resource = ResourceItem::CreateDefault(device, (UINT)vertices->buffer.size(), sceneMesh->name.c_str());
-            m_uploader->EnqueueUpload(resource, vertices->buffer.data(), (UINT)vertices->buffer.size(), vertices->stride);
-        }
-
-        if (!resource)
-        {
-            // fail
-            return nullptr;
-        }
-        gpuMesh->VertexBuffer(resource);
-    }
-
-    // indices
-    auto indices = sceneMesh->indices;
-    if (indices)
-    {
-        if (indices->isDynamic)
-        {
-            auto resource = ResourceItem::CreateUpload(device, (UINT)indices->buffer.size(), sceneMesh->name.c_str());
-            gpuMesh->IndexBuffer(resource);
-            // not enqueue
-        }
-        else
-        {
-            auto resource = ResourceItem::CreateDefault(device, (UINT)indices->buffer.size(), sceneMesh->name.c_str());
-            gpuMesh->IndexBuffer(resource);
-            m_uploader->EnqueueUpload(resource, indices->buffer.data(), (UINT)indices->buffer.size(), indices->stride);
-        }
-    }
-
-    m_meshMap.insert(std::make_pair(sceneMesh, gpuMesh));
-    return gpuMesh;
-}
-
-std::shared_ptr<RenderTargetChain> SceneMapper::GetOrCreate(const hierarchy::SceneViewPtr &view)
-{
-    auto found = m_renderTargetMap.find(view);
-    if (found != m_renderTargetMap.end())
-    {
-        return found->second;
-    }
-
-    auto renderTarget = std::make_shared<RenderTargetChain>();
-    m_renderTargetMap.insert(std::make_pair(view, renderTarget));
-    return renderTarget;
-}
-
-} // namespace d12u
+#include "SceneMapper.h"
+#include "ResourceItem.h"
+#include "Mesh.h"
+#include "Texture.h"
+#include "Uploader.h"
+#include "RootSignature.h"
+#include "RenderTarget.h"
+#include "ResidencyTracker.h"
+#include <hierarchy.h>
+#include <DirectXMath.h>
+#include <plog/Log.h>
+
+namespace d12u
+{
+SceneMapper::SceneMapper(UINT frameCount, ResidencyTracker *residency)
+    : m_uploader(new Uploader), m_residency(residency), m_frameCount(frameCount ? frameCount : 1)
+{
+}
+
+void SceneMapper::Initialize(const ComPtr<ID3D12Device> &device)
+{
+    m_uploader->Initialize(device);
+}
+
+void SceneMapper::Update(const ComPtr<ID3D12Device> &device)
+{
+    m_uploader->Update(device);
+}
+
+static int GetStride(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+        return 4;
+
+    case DXGI_FORMAT_R32G32_FLOAT:
+        return 8;
+
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+        return 12;
+
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    }
+
+    throw;
+}
+
+std::vector<std::shared_ptr<ResourceItem>> SceneMapper::CreateFrameBuffers(const ComPtr<ID3D12Device> &device,
+                                                                          UINT byteLength, LPCWSTR name)
+{
+    // one for each frame in flight. the GPU may read previous frames
+    std::vector<std::shared_ptr<ResourceItem>> buffers;
+    for (UINT i = 0; i < m_frameCount; ++i)
+    {
+        buffers.push_back(ResourceItem::CreateUpload(device, byteLength, name));
+    }
+    return buffers;
+}
+
+// CPU copy is kept alive until the copy completes. then released if Payload::ReleaseAfterUpload
+static void EnqueueUpload(Uploader *uploader, const std::shared_ptr<ResourceItem> &resource,
+                          const std::shared_ptr<hierarchy::VertexBuffer> &buffer)
+{
+    buffer->payload.BeginUpload();
+    uploader->EnqueueUpload(resource, buffer->buffer.data(), (UINT)buffer->buffer.size(), buffer->stride,
+                            UploadPriority::Mesh, [buffer]() { buffer->payload.EndUpload(&buffer->buffer); });
+}
+
+std::shared_ptr<Mesh> SceneMapper::GetOrCreate(const ComPtr<ID3D12Device> &device,
+                                               const std::shared_ptr<hierarchy::SceneMesh> &sceneMesh,
+                                               RootSignature *rootSignature)
+{
+    auto found = m_meshMap.find(sceneMesh);
+    if (found != m_meshMap.end())
+    {
+        if (m_residency)
+        {
+            m_residency->Touch(sceneMesh.get());
+        }
+        return found->second;
+    }
+
+    if (!rootSignature)
+    {
+        return nullptr;
+    }
+
+    if (sceneMesh->submeshes.empty())
+    {
+        return nullptr;
+    }
+
+    auto gpuMesh = std::make_shared<Mesh>();
+
+    // vertices
+    {
+        // first material's shader for input layout
+        auto shader = sceneMesh->submeshes[0].material->shader()->Compiled();
+        if (!shader)
+        {
+            // compiling
+            return nullptr;
+        }
+        // auto resource = CreateResourceItem(device, m_uploader, sceneMesh, shader->inputLayout(), shader->inputLayoutCount());
+        auto dstStride = 0;
+        for (auto &input : shader->Inputs())
+        {
+            if (input.PerInstance())
+            {
+                // instance stream
+                continue;
+            }
+            dstStride += GetStride((DXGI_FORMAT)input.Format);
+        }
+
+        // vertices
+        auto vertices = sceneMesh->vertices;
+        if (vertices->stride != dstStride)
+        {
+            LOGE << "buffer stride difference with shader stride";
+            return nullptr;
+        }
+
+        if (vertices->isDynamic || sceneMesh->skin)
+        {
+            // write each frame. not enqueue
+            gpuMesh->VertexBuffers(CreateFrameBuffers(device, (UINT)vertices->buffer.size(), sceneMesh->name.c_str()));
+        }
+        else
+        {
+            // released after the previous upload
+            if (!vertices->payload.Rematerialize(&vertices->buffer))
+            {
+                LOGE << "fail to rematerialize vertices";
+                return nullptr;
+            }
+            auto resource = ResourceItem::CreateDefault(device, (UINT)vertices->buffer.size(), sceneMesh->name.c_str());
+            if (!resource)
+            {
+                // fail
+                return nullptr;
+            }
+            EnqueueUpload(m_uploader.get(), resource, vertices);
+            gpuMesh->VertexBuffer(resource);
+        }
+    }
+
+    // indices
+    auto indices = sceneMesh->indices;
+    if (indices)
+    {
+        if (indices->isDynamic)
+        {
+            // write each frame. not enqueue
+            gpuMesh->IndexBuffers(CreateFrameBuffers(device, (UINT)indices->buffer.size(), sceneMesh->name.c_str()));
+        }
+        else
+        {
+            if (!indices->payload.Rematerialize(&indices->buffer))
+            {
+                LOGE << "fail to rematerialize indices";
+                return nullptr;
+            }
+            auto resource = ResourceItem::CreateDefault(device, (UINT)indices->buffer.size(), sceneMesh->name.c_str());
+            gpuMesh->IndexBuffer(resource);
+            EnqueueUpload(m_uploader.get(), resource, indices);
+        }
+    }
+
+    m_meshMap.insert(std::make_pair(sceneMesh, gpuMesh));
+    if (m_residency)
+    {
+        std::weak_ptr<hierarchy::SceneMesh> weak = sceneMesh;
+        m_residency->Add(sceneMesh, ResidencyCategory::Mesh, gpuMesh->AllocatedBytes(), [this, weak]() {
+            if (auto sceneMesh = weak.lock())
+            {
+                Release(sceneMesh);
+            }
+        });
+    }
+    return gpuMesh;
+}
+
+void SceneMapper::Release(const hierarchy::SceneMeshPtr &sceneMesh)
+{
+    if (m_residency)
+    {
+        m_residency->Remove(sceneMesh.get());
+    }
+    // pending uploads hold the buffers until completed
+    m_meshMap.erase(sceneMesh);
+}
+
+std::shared_ptr<RenderTargetChain> SceneMapper::GetOrCreate(const hierarchy::SceneViewPtr &view)
+{
+    auto found = m_renderTargetMap.find(view);
+    if (found != m_renderTargetMap.end())
+    {
+        return found->second;
+    }
+
+    auto renderTarget = std::make_shared<RenderTargetChain>();
+    m_renderTargetMap.insert(std::make_pair(view, renderTarget));
+    return renderTarget;
+}
+
+} // namespace d12u
@@ -0,0 +1,105 @@
+#include "SlotAllocator.h"
+#include <algorithm>
+
+namespace d12u
+{
+
+Slot FreeListSlotAllocator::Allocate(bool *newPage)
+{
+    *newPage = false;
+    if (m_free.empty())
+    {
+        // new page. lower index first
+        auto page = m_counters.Pages++;
+        for (uint32_t i = m_pageSize; i > 0; --i)
+        {
+            m_free.push_back({page, i - 1});
+        }
+        m_allocated.resize(m_allocated.size() + m_pageSize);
+        *newPage = true;
+    }
+
+    auto slot = m_free.back();
+    m_free.pop_back();
+    m_allocated[(size_t)slot.Page * m_pageSize + slot.Index] = true;
+    ++m_counters.Allocations;
+    ++m_counters.Used;
+    m_counters.Peak = std::max(m_counters.Peak, m_counters.Used);
+    return slot;
+}
+
+void FreeListSlotAllocator::Free(const Slot &slot)
+{
+    if (!slot || slot.Page >= m_counters.Pages || slot.Index >= m_pageSize)
+    {
+        throw "FreeListSlotAllocator: invalid slot";
+    }
+    auto index = (size_t)slot.Page * m_pageSize + slot.Index;
+    if (!m_allocated[index])
+    {
+        throw "FreeListSlotAllocator: slot freed twice";
+    }
+    m_allocated[index] = false;
+    m_free.push_back(slot);
+    ++m_counters.Frees;
+    --m_counters.Used;
+}
+
+Slot LinearSlotAllocator::Allocate(uint32_t count, bool *newPage)
+{
+    *newPage = false;
+    if (count > m_pageSize)
+    {
+        return {};
+    }
+
+    if (m_current == Slot::INVALID || m_next + count > m_pageSize)
+    {
+        if (m_freePages.empty())
+        {
+            m_current = m_counters.Pages++;
+            *newPage = true;
+        }
+        else
+        {
+            m_current = m_freePages.back();
+            m_freePages.pop_back();
+        }
+        m_next = 0;
+        m_framePages.push_back(m_current);
+        ++m_counters.FramePages;
+    }
+
+    Slot slot{m_current, m_next};
+    m_next += count;
+    m_counters.Used += count;
+    m_counters.Peak = std::max(m_counters.Peak, m_counters.Used);
+    return slot;
+}
+
+void LinearSlotAllocator::Close(uint64_t fenceValue)
+{
+    if (!m_framePages.empty())
+    {
+        m_frames.push_back({fenceValue, std::move(m_framePages)});
+        m_framePages.clear();
+    }
+    m_current = Slot::INVALID;
+    m_next = 0;
+    m_counters.LastUsed = m_counters.Used;
+    m_counters.LastFramePages = m_counters.FramePages;
+    m_counters.Used = 0;
+    m_counters.FramePages = 0;
+}
+
+void LinearSlotAllocator::Retire(uint64_t completedValue)
+{
+    while (!m_frames.empty() && m_frames.front().FenceValue <= completedValue)
+    {
+        auto &pages = m_frames.front().Pages;
+        m_freePages.insert(m_freePages.end(), pages.begin(), pages.end());
+        m_frames.pop_front();
+    }
+}
+
+} // namespace d12u
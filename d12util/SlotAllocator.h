@@ -0,0 +1,106 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+namespace d12u
+{
+
+// index in a page. for descriptor heaps
+struct Slot
+{
+    static constexpr uint32_t INVALID = ~0u;
+
+    uint32_t Page = INVALID;
+    uint32_t Index = 0;
+
+    explicit operator bool() const { return Page != INVALID; }
+    bool operator==(const Slot &rhs) const { return Page == rhs.Page && Index == rhs.Index; }
+};
+
+///
+/// persistent slots. released slots are reused. pages are added when full
+///
+class FreeListSlotAllocator
+{
+public:
+    struct Counters
+    {
+        uint32_t Pages = 0;
+        uint32_t Used = 0;
+        uint32_t Peak = 0;
+        // churn
+        uint64_t Allocations = 0;
+        uint64_t Frees = 0;
+    };
+
+private:
+    uint32_t m_pageSize;
+    std::vector<Slot> m_free;
+    // Page * PageSize + Index. Free of a free slot throws
+    std::vector<bool> m_allocated;
+    Counters m_counters;
+
+public:
+    FreeListSlotAllocator(uint32_t pageSize)
+        : m_pageSize(pageSize)
+    {
+    }
+    uint32_t PageSize() const { return m_pageSize; }
+    const Counters &GetCounters() const { return m_counters; }
+
+    // Page == GetCounters().Pages - 1 after new page
+    Slot Allocate(bool *newPage);
+    void Free(const Slot &slot);
+};
+
+///
+/// per frame slots. contiguous in a page
+///
+/// * pages used in a frame are closed with the fence value and reused after Retire
+///
+class LinearSlotAllocator
+{
+public:
+    struct Counters
+    {
+        uint32_t Pages = 0;
+        // open frame
+        uint32_t Used = 0;
+        uint32_t FramePages = 0;
+        uint32_t Peak = 0;
+        // last closed frame
+        uint32_t LastUsed = 0;
+        uint32_t LastFramePages = 0;
+    };
+
+private:
+    uint32_t m_pageSize;
+    std::vector<uint32_t> m_freePages;
+    uint32_t m_current = Slot::INVALID;
+    uint32_t m_next = 0;
+    std::vector<uint32_t> m_framePages;
+    struct Frame
+    {
+        uint64_t FenceValue;
+        std::vector<uint32_t> Pages;
+    };
+    std::deque<Frame> m_frames;
+    Counters m_counters;
+
+public:
+    LinearSlotAllocator(uint32_t pageSize)
+        : m_pageSize(pageSize)
+    {
+    }
+    uint32_t PageSize() const { return m_pageSize; }
+    const Counters &GetCounters() const { return m_counters; }
+
+    // count <= PageSize
+    Slot Allocate(uint32_t count, bool *newPage);
+    void Close(uint64_t fenceValue);
+    void Retire(uint64_t completedValue);
+};
+
+} // namespace d12u
@@ -0,0 +1,392 @@
+#include "TlsfAllocator.h"
+#include <algorithm>
+#include <bit>
+
+namespace d12u
+{
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+TlsfAllocator::TlsfAllocator(uint64_t capacity, uint64_t granularity)
+    : m_capacity(capacity & ~(granularity - 1)), m_granularity(granularity)
+{
+    for (auto &sl : m_freeLists)
+    {
+        sl.fill(INVALID);
+    }
+    if (m_capacity)
+    {
+        auto block = NewBlock();
+        m_blocks[block].Offset = 0;
+        m_blocks[block].Size = m_capacity;
+        InsertFree(block);
+    }
+}
+
+void TlsfAllocator::Mapping(uint64_t size, int *fl, uint32_t *sl) const
+{
+    auto units = size / m_granularity;
+    if (units < SL_COUNT)
+    {
+        *fl = 0;
+        *sl = (uint32_t)units;
+        return;
+    }
+    int msb = std::bit_width(units) - 1;
+    *fl = msb - SL_LOG2 + 1;
+    *sl = (uint32_t)(units >> (msb - SL_LOG2)) - SL_COUNT;
+}
+
+uint32_t TlsfAllocator::NewBlock()
+{
+    if (m_unusedBlock != INVALID)
+    {
+        auto block = m_unusedBlock;
+        m_unusedBlock = m_blocks[block].NextFree;
+        m_blocks[block] = {.Prev = INVALID, .Next = INVALID, .PrevFree = INVALID, .NextFree = INVALID, .Id = INVALID};
+        return block;
+    }
+    m_blocks.push_back({.Prev = INVALID, .Next = INVALID, .PrevFree = INVALID, .NextFree = INVALID, .Id = INVALID});
+    return (uint32_t)m_blocks.size() - 1;
+}
+
+void TlsfAllocator::DeleteBlock(uint32_t block)
+{
+    m_blocks[block].Size = 0;
+    m_blocks[block].NextFree = m_unusedBlock;
+    m_unusedBlock = block;
+}
+
+void TlsfAllocator::InsertFree(uint32_t block)
+{
+    int fl;
+    uint32_t sl;
+    Mapping(m_blocks[block].Size, &fl, &sl);
+    auto &head = m_freeLists[fl][sl];
+    m_blocks[block].PrevFree = INVALID;
+    m_blocks[block].NextFree = head;
+    if (head != INVALID)
+    {
+        m_blocks[head].PrevFree = block;
+    }
+    head = block;
+    m_slBitmap[fl] |= 1u << sl;
+    m_flBitmap |= 1ull << fl;
+}
+
+void TlsfAllocator::RemoveFree(uint32_t block)
+{
+    auto &b = m_blocks[block];
+    if (b.PrevFree != INVALID)
+    {
+        m_blocks[b.PrevFree].NextFree = b.NextFree;
+    }
+    else
+    {
+        int fl;
+        uint32_t sl;
+        Mapping(b.Size, &fl, &sl);
+        m_freeLists[fl][sl] = b.NextFree;
+        if (b.NextFree == INVALID)
+        {
+            m_slBitmap[fl] &= ~(1u << sl);
+            if (!m_slBitmap[fl])
+            {
+                m_flBitmap &= ~(1ull << fl);
+            }
+        }
+    }
+    if (b.NextFree != INVALID)
+    {
+        m_blocks[b.NextFree].PrevFree = b.PrevFree;
+    }
+    b.PrevFree = b.NextFree = INVALID;
+}
+
+uint32_t TlsfAllocator::FindFree(uint64_t size) const
+{
+    // round up to next class. every block of the class fits
+    auto units = size / m_granularity;
+    if (units >= SL_COUNT)
+    {
+        int msb = std::bit_width(units) - 1;
+        size += ((1ull << (msb - SL_LOG2)) - 1) * m_granularity;
+    }
+    int fl;
+    uint32_t sl;
+    Mapping(size, &fl, &sl);
+    if (fl >= FL_COUNT)
+    {
+        return INVALID;
+    }
+
+    auto slBitmap = m_slBitmap[fl] & (~0u << sl);
+    if (!slBitmap)
+    {
+        auto flBitmap = fl + 1 < FL_COUNT ? m_flBitmap & (~0ull << (fl + 1)) : 0;
+        if (!flBitmap)
+        {
+            return INVALID;
+        }
+        fl = std::countr_zero(flBitmap);
+        slBitmap = m_slBitmap[fl];
+    }
+    return m_freeLists[fl][std::countr_zero(slBitmap)];
+}
+
+uint32_t TlsfAllocator::Use(uint32_t block, uint64_t offset, uint64_t size)
+{
+    RemoveFree(block);
+
+    if (offset > m_blocks[block].Offset)
+    {
+        // front padding
+        auto pre = NewBlock();
+        auto &b = m_blocks[block];
+        auto &p = m_blocks[pre];
+        p.Offset = b.Offset;
+        p.Size = offset - b.Offset;
+        p.Prev = b.Prev;
+        p.Next = block;
+        if (b.Prev != INVALID)
+        {
+            m_blocks[b.Prev].Next = pre;
+        }
+        b.Prev = pre;
+        b.Offset = offset;
+        b.Size -= p.Size;
+        InsertFree(pre);
+    }
+
+    if (m_blocks[block].Size > size)
+    {
+        // remainder
+        auto post = NewBlock();
+        auto &b = m_blocks[block];
+        auto &p = m_blocks[post];
+        p.Offset = offset + size;
+        p.Size = b.Size - size;
+        p.Prev = block;
+        p.Next = b.Next;
+        if (b.Next != INVALID)
+        {
+            m_blocks[b.Next].Prev = post;
+        }
+        b.Next = post;
+        b.Size = size;
+        InsertFree(post);
+    }
+
+    m_used += size;
+    ++m_allocations;
+    return block;
+}
+
+uint32_t TlsfAllocator::Release(uint32_t block)
+{
+    m_used -= m_blocks[block].Size;
+    --m_allocations;
+    m_blocks[block].Id = INVALID;
+
+    auto prev = m_blocks[block].Prev;
+    if (prev != INVALID && m_blocks[prev].Id == INVALID)
+    {
+        // merge to prev
+        RemoveFree(prev);
+        auto &p = m_blocks[prev];
+        p.Size += m_blocks[block].Size;
+        p.Next = m_blocks[block].Next;
+        if (p.Next != INVALID)
+        {
+            m_blocks[p.Next].Prev = prev;
+        }
+        DeleteBlock(block);
+        block = prev;
+    }
+
+    auto next = m_blocks[block].Next;
+    if (next != INVALID && m_blocks[next].Id == INVALID)
+    {
+        // merge next
+        RemoveFree(next);
+        auto &b = m_blocks[block];
+        b.Size += m_blocks[next].Size;
+        b.Next = m_blocks[next].Next;
+        if (b.Next != INVALID)
+        {
+            m_blocks[b.Next].Prev = block;
+        }
+        DeleteBlock(next);
+    }
+
+    InsertFree(block);
+    return block;
+}
+
+bool TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, Allocation *allocation)
+{
+    alignment = std::max(alignment, m_granularity);
+    size = AlignUp(std::max(size, (uint64_t)1), m_granularity);
+    auto block = FindFree(size + alignment - m_granularity);
+    if (block == INVALID)
+    {
+        return false;
+    }
+
+    auto offset = AlignUp(m_blocks[block].Offset, alignment);
+    block = Use(block, offset, size);
+
+    uint32_t id;
+    if (m_unusedIds.empty())
+    {
+        id = (uint32_t)m_ids.size();
+        m_ids.push_back(block);
+    }
+    else
+    {
+        id = m_unusedIds.back();
+        m_unusedIds.pop_back();
+        m_ids[id] = block;
+    }
+    m_blocks[block].Id = id;
+    m_blocks[block].Alignment = alignment;
+
+    *allocation = {
+        .Id = id,
+        .Offset = offset,
+        .Size = size,
+    };
+    return true;
+}
+
+void TlsfAllocator::Free(uint32_t id)
+{
+    if (id >= m_ids.size() || m_ids[id] == INVALID)
+    {
+        throw "TlsfAllocator: invalid id";
+    }
+    Release(m_ids[id]);
+    m_ids[id] = INVALID;
+    m_unusedIds.push_back(id);
+}
+
+TlsfAllocator::Allocation TlsfAllocator::Get(uint32_t id) const
+{
+    if (id >= m_ids.size() || m_ids[id] == INVALID)
+    {
+        return {};
+    }
+    auto &b = m_blocks[m_ids[id]];
+    return {
+        .Id = id,
+        .Offset = b.Offset,
+        .Size = b.Size,
+    };
+}
+
+TlsfAllocator::Stats TlsfAllocator::GetStats() const
+{
+    Stats stats{
+        .Capacity = m_capacity,
+        .Used = m_used,
+        .Allocations = m_allocations,
+    };
+    for (int fl = 0; fl < FL_COUNT; ++fl)
+    {
+        for (uint32_t sl = 0; sl < SL_COUNT; ++sl)
+        {
+            for (auto block = m_freeLists[fl][sl]; block != INVALID; block = m_blocks[block].NextFree)
+            {
+                ++stats.FreeBlocks;
+                stats.LargestFree = std::max(stats.LargestFree, m_blocks[block].Size);
+            }
+        }
+    }
+    return stats;
+}
+
+size_t TlsfAllocator::Defragment(size_t maxMoves, const std::function<void(const Move &)> &onMove)
+{
+    if (m_allocations == 0)
+    {
+        return 0;
+    }
+
+    // physical order
+    std::vector<uint32_t> blocks;
+    for (auto id : m_ids)
+    {
+        if (id != INVALID)
+        {
+            blocks.push_back(id);
+        }
+    }
+    auto head = blocks.front();
+    while (m_blocks[head].Prev != INVALID)
+    {
+        head = m_blocks[head].Prev;
+    }
+    // highest offset first
+    std::sort(blocks.begin(), blocks.end(), [this](auto a, auto b) {
+        return m_blocks[a].Offset > m_blocks[b].Offset;
+    });
+
+    size_t moves = 0;
+    for (auto block : blocks)
+    {
+        if (moves >= maxMoves)
+        {
+            break;
+        }
+        auto size = m_blocks[block].Size;
+        auto alignment = m_blocks[block].Alignment;
+        auto from = m_blocks[block].Offset;
+
+        // lowest free block that fits
+        uint32_t found = INVALID;
+        uint64_t to = 0;
+        for (auto b = head; b != INVALID && m_blocks[b].Offset < from; b = m_blocks[b].Next)
+        {
+            if (m_blocks[b].Id != INVALID)
+            {
+                continue;
+            }
+            auto offset = AlignUp(m_blocks[b].Offset, alignment);
+            if (offset + size <= m_blocks[b].Offset + m_blocks[b].Size)
+            {
+                found = b;
+                to = offset;
+                break;
+            }
+        }
+        if (found == INVALID)
+        {
+            continue;
+        }
+
+        auto id = m_blocks[block].Id;
+        auto moved = Use(found, to, size);
+        m_blocks[moved].Id = id;
+        m_blocks[moved].Alignment = alignment;
+        m_ids[id] = moved;
+        Release(block);
+        if (m_blocks[head].Prev != INVALID)
+        {
+            head = m_blocks[head].Prev;
+        }
+        ++moves;
+
+        onMove({
+            .Id = id,
+            .From = from,
+            .To = to,
+            .Size = size,
+        });
+    }
+    return moves;
+}
+
+} // namespace d12u
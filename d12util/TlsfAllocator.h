@@ -0,0 +1,111 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <vector>
+#include <functional>
+
+namespace d12u
+{
+
+///
+/// two level segregated fit allocator of offset ranges. no d3d12
+///
+/// * O(1) Allocate and Free. merges neighbour free blocks
+/// * offsets and sizes are multiple of granularity
+/// * Id is stable while allocated. Defragment moves allocations, not Ids
+///
+class TlsfAllocator
+{
+public:
+    static constexpr uint32_t INVALID = ~0u;
+
+    struct Allocation
+    {
+        uint32_t Id = INVALID;
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+    };
+
+    struct Stats
+    {
+        uint64_t Capacity = 0;
+        uint64_t Used = 0;
+        uint32_t Allocations = 0;
+        uint32_t FreeBlocks = 0;
+        uint64_t LargestFree = 0;
+    };
+
+    struct Move
+    {
+        uint32_t Id;
+        uint64_t From;
+        uint64_t To;
+        uint64_t Size;
+    };
+
+private:
+    static constexpr int SL_LOG2 = 4;
+    static constexpr uint32_t SL_COUNT = 1 << SL_LOG2;
+    static constexpr int FL_COUNT = 48;
+
+    struct Block
+    {
+        uint64_t Offset;
+        uint64_t Size;
+        // physical neighbours
+        uint32_t Prev;
+        uint32_t Next;
+        // free list. or unused Blocks
+        uint32_t PrevFree;
+        uint32_t NextFree;
+        // INVALID if free
+        uint32_t Id;
+        uint64_t Alignment;
+    };
+    std::vector<Block> m_blocks;
+    uint32_t m_unusedBlock = INVALID;
+
+    uint64_t m_flBitmap = 0;
+    std::array<uint32_t, FL_COUNT> m_slBitmap{};
+    std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> m_freeLists;
+
+    // Id to block
+    std::vector<uint32_t> m_ids;
+    std::vector<uint32_t> m_unusedIds;
+
+    uint64_t m_capacity;
+    uint64_t m_granularity;
+    uint64_t m_used = 0;
+    uint32_t m_allocations = 0;
+
+    TlsfAllocator(const TlsfAllocator &) = delete;
+    TlsfAllocator &operator=(const TlsfAllocator &) = delete;
+
+    void Mapping(uint64_t size, int *fl, uint32_t *sl) const;
+    uint32_t NewBlock();
+    void DeleteBlock(uint32_t block);
+    void InsertFree(uint32_t block);
+    void RemoveFree(uint32_t block);
+    uint32_t FindFree(uint64_t size) const;
+    // split free block at [offset, offset + size). return allocated block
+    uint32_t Use(uint32_t block, uint64_t offset, uint64_t size);
+    // return merged free block
+    uint32_t Release(uint32_t block);
+
+public:
+    // granularity is power of 2
+    TlsfAllocator(uint64_t capacity, uint64_t granularity = 256);
+
+    // alignment is power of 2
+    bool Allocate(uint64_t size, uint64_t alignment, Allocation *allocation);
+    void Free(uint32_t id);
+    Allocation Get(uint32_t id) const;
+    Stats GetStats() const;
+
+    // move allocations from the end to lower free blocks.
+    // onMove is called after each move. caller copies contents From -> To
+    size_t Defragment(size_t maxMoves, const std::function<void(const Move &)> &onMove);
+};
+
+} // namespace d12u
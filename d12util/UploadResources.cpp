@@ -0,0 +1,206 @@
+#include "UploadResources.h"
+#include <SceneMesh.h>
+#include <SceneMeshSkin.h>
+#include <SceneMaterial.h>
+#include <SceneImage.h>
+#include <ShaderWatcher.h>
+#include <VertexBuffer.h>
+#include <algorithm>
+
+namespace d12u
+{
+
+UploadResources::UploadResources(NullBackend *backend, uint32_t frameCount)
+    : m_backend(backend), m_frameCount(std::max(frameCount, 1u))
+{
+}
+
+UploadResources::~UploadResources()
+{
+    for (auto &[mesh, buffers] : m_meshMap)
+    {
+        for (auto buffer : buffers.Vertices)
+        {
+            m_backend->DestroyBuffer(buffer);
+        }
+        for (auto buffer : buffers.Indices)
+        {
+            m_backend->DestroyBuffer(buffer);
+        }
+    }
+    for (auto &[image, texture] : m_textureMap)
+    {
+        m_backend->DestroyTexture(texture);
+    }
+    for (auto &[fence, staging] : m_staging)
+    {
+        m_backend->DestroyBuffer(staging);
+    }
+}
+
+BufferHandle UploadResources::Upload(const void *p, uint32_t byteLength, const wchar_t *name)
+{
+    auto buffer = m_backend->CreateBuffer(BufferUsage::Default, byteLength, name);
+    auto staging = m_backend->CreateBuffer(BufferUsage::Upload, byteLength, L"##staging##");
+    m_backend->WriteBuffer(staging, 0, p, byteLength);
+    m_backend->CopyBuffer(buffer, 0, staging, 0, byteLength);
+    m_staging.push_back({0, staging});
+    return buffer;
+}
+
+// buffer of the frame slot. 0 if empty
+static BufferHandle FrameBuffer(const std::vector<BufferHandle> &buffers, uint32_t frameIndex)
+{
+    if (buffers.empty())
+    {
+        return 0;
+    }
+    return buffers[frameIndex % buffers.size()];
+}
+
+bool UploadResources::Mesh(const hierarchy::DrawList::DrawItem &item, uint32_t frameIndex, MeshBinding *binding)
+{
+    auto &mesh = item.Mesh;
+    auto found = m_meshMap.find(mesh.get());
+    if (found == m_meshMap.end())
+    {
+        MeshBuffers buffers{};
+        auto &vertices = mesh->vertices;
+        auto &indices = mesh->indices;
+        buffers.Dynamic = mesh->skin || item.Vertices.Ptr || item.Indices.Ptr || (vertices && vertices->isDynamic);
+        if (vertices)
+        {
+            buffers.VerticesBytes = std::max((uint32_t)vertices->buffer.size(), item.Vertices.Size);
+            buffers.VertexStride = vertices->stride;
+            if (buffers.Dynamic)
+            {
+                for (uint32_t i = 0; i < m_frameCount; ++i)
+                {
+                    buffers.Vertices.push_back(m_backend->CreateBuffer(BufferUsage::Upload, buffers.VerticesBytes, mesh->name));
+                }
+            }
+            else
+            {
+                buffers.Vertices.push_back(Upload(vertices->buffer.data(), buffers.VerticesBytes, mesh->name.c_str()));
+            }
+        }
+        if (indices)
+        {
+            buffers.IndicesBytes = std::max((uint32_t)indices->buffer.size(), item.Indices.Size);
+            buffers.IndexStride = indices->stride;
+            if (buffers.Dynamic)
+            {
+                for (uint32_t i = 0; i < m_frameCount; ++i)
+                {
+                    buffers.Indices.push_back(m_backend->CreateBuffer(BufferUsage::Upload, buffers.IndicesBytes, mesh->name));
+                }
+            }
+            else
+            {
+                buffers.Indices.push_back(Upload(indices->buffer.data(), buffers.IndicesBytes, mesh->name.c_str()));
+            }
+        }
+        found = m_meshMap.insert(std::make_pair(mesh.get(), buffers)).first;
+    }
+
+    auto &buffers = found->second;
+    // buffers of this frame slot. previous use is completed
+    auto vertexBuffer = FrameBuffer(buffers.Vertices, frameIndex);
+    auto indexBuffer = FrameBuffer(buffers.Indices, frameIndex);
+    if (buffers.Dynamic)
+    {
+        // skins
+        auto skin = mesh->skin;
+        if (skin && !skin->cpuSkiningBuffer.empty())
+        {
+            m_backend->WriteBuffer(vertexBuffer, 0, skin->cpuSkiningBuffer.data(),
+                                   std::min((uint32_t)skin->cpuSkiningBuffer.size(), buffers.VerticesBytes));
+        }
+        if (item.Vertices.Ptr)
+        {
+            m_backend->WriteBuffer(vertexBuffer, 0, item.Vertices.Ptr, std::min(item.Vertices.Size, buffers.VerticesBytes));
+            buffers.VertexStride = item.Vertices.Stride;
+        }
+        if (item.Indices.Ptr)
+        {
+            m_backend->WriteBuffer(indexBuffer, 0, item.Indices.Ptr, std::min(item.Indices.Size, buffers.IndicesBytes));
+            buffers.IndexStride = item.Indices.Stride;
+        }
+    }
+
+    *binding = {
+        .Vertices = vertexBuffer,
+        .VerticesBytes = buffers.VerticesBytes,
+        .VertexStride = buffers.VertexStride,
+        .Indices = indexBuffer,
+        .IndicesBytes = buffers.IndicesBytes,
+        .IndexStride = buffers.IndexStride,
+    };
+    return true;
+}
+
+PipelineHandle UploadResources::Pipeline(const std::shared_ptr<hierarchy::SceneMaterial> &material)
+{
+    auto found = m_pipelineMap.find(material.get());
+    if (found != m_pipelineMap.end())
+    {
+        return found->second;
+    }
+
+    PipelineDesc desc{
+        .Shader = ShaderName            ? ShaderName(material.get())
+                  : material->shader()  ? material->shader()->name()
+                                        : std::string(),
+        .AlphaMode = (int)material->alphaMode(),
+    };
+    auto pipeline = m_backend->CreatePipeline(desc);
+    m_pipelineMap.insert(std::make_pair(material.get(), pipeline));
+    return pipeline;
+}
+
+TextureHandle UploadResources::Texture(const std::shared_ptr<hierarchy::SceneImage> &image)
+{
+    auto found = m_textureMap.find(image.get());
+    if (found != m_textureMap.end())
+    {
+        return found->second;
+    }
+
+    auto texture = m_backend->CreateTexture(image->width, image->height, image->name);
+    auto byteLength = image->size();
+    auto staging = m_backend->CreateBuffer(BufferUsage::Upload, byteLength, L"##staging##");
+    if (image->buffer.size() >= byteLength)
+    {
+        m_backend->WriteBuffer(staging, 0, image->buffer.data(), byteLength);
+    }
+    m_backend->CopyBufferToTexture(texture, staging, 0);
+    m_staging.push_back({0, staging});
+    m_textureMap.insert(std::make_pair(image.get(), texture));
+    return texture;
+}
+
+void UploadResources::Close(uint64_t fenceValue)
+{
+    for (auto &staging : m_staging)
+    {
+        if (staging.first == 0)
+        {
+            staging.first = fenceValue;
+        }
+    }
+}
+
+void UploadResources::Retire(uint64_t completedValue)
+{
+    auto end = std::remove_if(m_staging.begin(), m_staging.end(), [this, completedValue](const auto &staging) {
+        if (staging.first == 0 || staging.first > completedValue)
+        {
+            return false;
+        }
+        m_backend->DestroyBuffer(staging.second);
+        return true;
+    });
+    m_staging.erase(end, m_staging.end());
+}
+
+} // namespace d12u
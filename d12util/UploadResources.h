@@ -0,0 +1,60 @@
+#pragma once
+#include "DrawListResources.h"
+#include "NullBackend.h"
+#include <unordered_map>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace d12u
+{
+
+///
+/// DrawListResources by NullBackend commands. headless
+///
+/// * mesh and texture are uploaded at first draw through a staging buffer
+/// * dynamic mesh has an Upload buffer for each frame in flight
+/// * one pipeline per SceneMaterial
+///
+class UploadResources : public DrawListResources
+{
+    NullBackend *m_backend;
+    uint32_t m_frameCount;
+
+    struct MeshBuffers
+    {
+        // Dynamic has a buffer for each frame in flight
+        std::vector<BufferHandle> Vertices;
+        uint32_t VerticesBytes = 0;
+        uint32_t VertexStride = 0;
+        std::vector<BufferHandle> Indices;
+        uint32_t IndicesBytes = 0;
+        uint32_t IndexStride = 0;
+        // Upload buffer. write each frame
+        bool Dynamic = false;
+    };
+    std::unordered_map<const hierarchy::SceneMesh *, MeshBuffers> m_meshMap;
+    std::unordered_map<const hierarchy::SceneMaterial *, PipelineHandle> m_pipelineMap;
+    std::unordered_map<const hierarchy::SceneImage *, TextureHandle> m_textureMap;
+
+    // fence value and staging buffer. 0 is not submitted
+    std::vector<std::pair<uint64_t, BufferHandle>> m_staging;
+
+    BufferHandle Upload(const void *p, uint32_t byteLength, const wchar_t *name);
+
+public:
+    UploadResources(NullBackend *backend, uint32_t frameCount);
+    // after the last fence completed
+    ~UploadResources();
+
+    // shader name of material. default is SceneMaterial::shader->name()
+    std::function<std::string(const hierarchy::SceneMaterial *)> ShaderName;
+
+    bool Mesh(const hierarchy::DrawList::DrawItem &item, uint32_t frameIndex, MeshBinding *binding) override;
+    PipelineHandle Pipeline(const std::shared_ptr<hierarchy::SceneMaterial> &material) override;
+    TextureHandle Texture(const std::shared_ptr<hierarchy::SceneImage> &image) override;
+    void Close(uint64_t fenceValue) override;
+    void Retire(uint64_t completedValue) override;
+};
+
+} // namespace d12u
@@ -1,77 +1,217 @@
-#include "Uploader.h"
-#include "CommandQueue.h"
-#include "CommandList.h"
-#include "ResourceItem.h"
-
-namespace d12u
-{
-Uploader::Uploader()
-    : m_queue(new CommandQueue), m_commandList(new CommandList)
-{
-}
-
-Uploader::~Uploader()
-{
-    m_queue->SyncFence();
-    delete m_commandList;
-    delete m_queue;
-}
-
-void Uploader::Initialize(const ComPtr<ID3D12Device> &device)
-{
-    m_queue->Initialize(device, D3D12_COMMAND_LIST_TYPE_COPY);
-    m_commandList->Initialize(device, nullptr, D3D12_COMMAND_LIST_TYPE_COPY);
-}
-
-void Uploader::Update(const ComPtr<ID3D12Device> &device)
-{
-    if (!m_callback)
-    {
-        if (m_commands.empty())
-        {
-            return;
-        }
-
-        // dequeue -> execute
-        auto command = std::move(m_commands.front());
-        m_commands.pop();
-
-        if (m_upload)
-        {
-            auto desc = m_upload->Resource()->GetDesc();
-            if (desc.Width * desc.Height < command->ByteLength)
-            {
-                // clear
-                m_upload.reset();
-            }
-        }
-        if (!m_upload)
-        {
-            m_upload = ResourceItem::CreateUpload(device, command->ByteLength, L"##uploader##");
-        }
-
-        m_commandList->Reset(nullptr);
-        command->Item->EnqueueUpload(m_commandList, m_upload, command->Data, command->ByteLength, command->Stride);
-        auto callbacks = m_commandList->CloseAndGetCallbacks();
-        m_queue->Execute(m_commandList->Get());
-        m_callbackFenceValue = m_queue->Signal();
-        m_callback = [callbacks]() {
-            for (auto &callback : callbacks)
-            {
-                callback();
-            }
-        };
-    }
-    else
-    {
-        // wait fence
-        if (m_callbackFenceValue <= m_queue->CurrentValue())
-        {
-            // callback is done
-            m_callback();
-            // clear
-            m_callback = OnCompletedFunc();
-        }
-    }
-}
-} // namespace d12u
\ No newline at end of file
+#include "Uploader.h"
+#include "CommandQueue.h"
+#include "CommandList.h"
+#include "ResourceItem.h"
+#include <algorithm>
+#include <chrono>
+
+namespace d12u
+{
+Uploader::Uploader(UINT64 ringSize)
+    : m_queue(new CommandQueue), m_ringSize(ringSize), m_ring(ringSize)
+{
+}
+
+Uploader::~Uploader()
+{
+    m_queue->SyncFence();
+    Retire();
+    if (m_mapped)
+    {
+        m_upload->Resource()->Unmap(0, nullptr);
+    }
+    delete m_queue;
+}
+
+void Uploader::Initialize(const ComPtr<ID3D12Device> &device)
+{
+    m_queue->Initialize(device, D3D12_COMMAND_LIST_TYPE_COPY);
+
+    // keep mapped. upload heap is write combined
+    m_upload = ResourceItem::CreateUpload(device, (UINT)m_ringSize, L"##uploader##");
+    D3D12_RANGE readRange{0, 0};
+    ThrowIfFailed(m_upload->Resource()->Map(0, &readRange, reinterpret_cast<void **>(&m_mapped)));
+}
+
+void Uploader::Retire()
+{
+    auto completed = m_queue->CurrentValue();
+    while (!m_submissions.empty() && m_submissions.front().FenceValue <= completed)
+    {
+        auto &submission = m_submissions.front();
+        for (auto &callback : submission.Callbacks)
+        {
+            callback();
+        }
+        m_freeCommandLists.push_back(std::move(submission.List));
+        m_submissions.pop();
+    }
+    m_ring.Retire(completed);
+}
+
+bool Uploader::Record(const ComPtr<ID3D12Device> &device, Submission *submission, UploadCommand *command)
+{
+    auto isTexture = command->Item->Resource()->GetDesc().Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    // row pitch of Data and staging
+    auto srcPitch = command->RowPitch ? command->RowPitch : command->Stride;
+    auto rowPitch = isTexture ? (command->Stride + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1)
+                              : srcPitch;
+
+    // chunk
+    auto byteLength = command->ByteLength - command->Offset;
+    if (byteLength > ChunkBytes)
+    {
+        if (isTexture)
+        {
+            auto rows = std::max(ChunkBytes / rowPitch, 1u);
+            byteLength = std::min(byteLength, rows * srcPitch);
+        }
+        else
+        {
+            byteLength = ChunkBytes;
+        }
+    }
+    auto stagingLength = isTexture ? byteLength / srcPitch * rowPitch : byteLength;
+    auto dstOffset = isTexture ? command->Offset / srcPitch * rowPitch : command->Offset;
+    auto copy = [command, srcPitch, rowPitch](uint8_t *dst, const uint8_t *src, UINT byteLength) {
+        if (srcPitch == rowPitch)
+        {
+            // one memcpy
+            memcpy(dst, src, byteLength);
+            return;
+        }
+        for (UINT row = 0; row < byteLength / srcPitch; ++row)
+        {
+            memcpy(dst + row * rowPitch, src + row * srcPitch, command->Stride);
+        }
+    };
+
+    auto commandList = submission->List.get();
+    auto src = (const uint8_t *)command->Data + command->Offset;
+    auto offset = m_ring.Allocate(stagingLength, isTexture ? D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT : 16);
+    if (offset != RingAllocator::INVALID)
+    {
+        copy(m_mapped + offset, src, byteLength);
+        command->Item->EnqueueCopy(commandList, m_upload, offset, dstOffset, stagingLength, command->Stride,
+                                   command->Subresource, rowPitch);
+    }
+    else if (stagingLength > m_ring.Capacity() && m_stats.Chunks == 0)
+    {
+        // larger than ring. alone in this submission
+        submission->Dedicated = ResourceItem::CreateUpload(device, stagingLength, L"##uploader.dedicated##");
+        uint8_t *mapped;
+        D3D12_RANGE readRange{0, 0};
+        ThrowIfFailed(submission->Dedicated->Resource()->Map(0, &readRange, reinterpret_cast<void **>(&mapped)));
+        copy(mapped, src, byteLength);
+        submission->Dedicated->Resource()->Unmap(0, nullptr);
+        command->Item->EnqueueCopy(commandList, submission->Dedicated, 0, dstOffset, stagingLength, command->Stride,
+                                   command->Subresource, rowPitch);
+    }
+    else
+    {
+        // ring is full. next frame
+        return false;
+    }
+
+    command->Offset += byteLength;
+    if (command->Offset == command->ByteLength)
+    {
+        if (command->MarkUploaded)
+        {
+            command->Item->EnqueueUploaded(commandList, command->ByteLength, command->Stride);
+        }
+        if (command->OnUploaded)
+        {
+            commandList->AddOnCompleted(command->OnUploaded);
+        }
+        ++m_stats.Commands;
+    }
+    ++m_stats.Chunks;
+    m_stats.Bytes += byteLength;
+    m_pendingBytes -= byteLength;
+    return true;
+}
+
+void Uploader::Update(const ComPtr<ID3D12Device> &device)
+{
+    using clock = std::chrono::high_resolution_clock;
+    auto start = clock::now();
+    auto elapsed = [start]() {
+        return std::chrono::duration<float, std::milli>(clock::now() - start).count();
+    };
+
+    Retire();
+
+    m_stats = {};
+    UINT pending = 0;
+    for (auto &commands : m_commands)
+    {
+        pending += (UINT)commands.size();
+    }
+    if (pending)
+    {
+        Submission submission;
+        if (m_freeCommandLists.empty())
+        {
+            submission.List.reset(new CommandList);
+            submission.List->Initialize(device, nullptr, D3D12_COMMAND_LIST_TYPE_COPY);
+        }
+        else
+        {
+            submission.List = std::move(m_freeCommandLists.back());
+            m_freeCommandLists.pop_back();
+        }
+        submission.List->Reset(nullptr);
+
+        // higher priority first. at least one chunk per frame
+        bool full = false;
+        for (auto &commands : m_commands)
+        {
+            while (!full && !commands.empty())
+            {
+                if (m_stats.Chunks > 0 && (m_stats.Bytes >= BytesPerFrame || elapsed() >= MillisecondsPerFrame))
+                {
+                    full = true;
+                    break;
+                }
+
+                auto command = commands.front().get();
+                if (!Record(device, &submission, command))
+                {
+                    full = true;
+                    break;
+                }
+                if (command->Offset == command->ByteLength)
+                {
+                    commands.pop();
+                    --pending;
+                }
+                if (submission.Dedicated)
+                {
+                    full = true;
+                }
+            }
+        }
+
+        submission.Callbacks = submission.List->CloseAndGetCallbacks();
+        if (m_stats.Chunks == 0)
+        {
+            // nothing recorded. ring is waiting for fence
+            m_freeCommandLists.push_back(std::move(submission.List));
+        }
+        else
+        {
+            m_queue->Execute(submission.List->Get());
+            submission.FenceValue = m_queue->Signal();
+            m_ring.Close(submission.FenceValue);
+            m_submissions.push(std::move(submission));
+        }
+    }
+
+    m_stats.Milliseconds = elapsed();
+    m_stats.Pending = pending;
+    m_stats.PendingBytes = m_pendingBytes;
+    m_stats.InFlight = (UINT)m_submissions.size();
+    m_stats.StagingUsed = m_ring.Used();
+}
+} // namespace d12u
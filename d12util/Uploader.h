@@ -1,67 +1,145 @@
-#pragma
-#include "Helper.h"
-#include <queue>
-#include <functional>
-
-namespace d12u
-{
-struct UploadCommand
-{
-    std::shared_ptr<class ResourceItem> Item;
-    const void *Data = nullptr;
-    UINT ByteLength = 0;
-    UINT Stride = 0;
-    std::vector<uint8_t> Payload;
-
-    UploadCommand(const UploadCommand &rhs) = delete;
-    UploadCommand &operator=(const UploadCommand &rhs) = delete;
-    UploadCommand() {}
-    UploadCommand(const std::shared_ptr<class ResourceItem> &item,
-                  const void *data, UINT byteLength, UINT stride)
-        : Item(item), Data(data), ByteLength(byteLength), Stride(stride)
-    {
-    }
-
-    void UsePayload(const std::shared_ptr<class ResourceItem> &item, UINT stride)
-    {
-        Item = item;
-        Stride = stride;
-        // refer payload. payload has lifetime while MapCopyUnmap
-        Data = Payload.data();
-        ByteLength = (UINT)Payload.size();
-    }
-};
-
-class Uploader : NonCopyable
-{
-    template <class T>
-    using ComPtr = Microsoft::WRL::ComPtr<T>;
-
-    class CommandQueue *m_queue = nullptr;
-    class CommandList *m_commandList = nullptr;
-
-    std::queue<std::shared_ptr<UploadCommand>> m_commands;
-    using OnCompletedFunc = std::function<void()>;
-    OnCompletedFunc m_callback;
-    UINT64 m_callbackFenceValue = 0;
-
-    // for upload staging
-    std::shared_ptr<class ResourceItem> m_upload;
-
-public:
-    Uploader();
-    ~Uploader();
-    void Initialize(const ComPtr<ID3D12Device> &device);
-    void Update(const ComPtr<ID3D12Device> &device);
-    void EnqueueUpload(const std::shared_ptr<class ResourceItem> &item,
-                       const void *p, UINT byteLength, UINT stride)
-    {
-        auto command = std::make_shared<UploadCommand>(item, p, byteLength, stride);
-        EnqueueUpload(command);
-    }
-    void EnqueueUpload(const std::shared_ptr<UploadCommand> &command)
-    {
-        m_commands.push(command);
-    }
-};
-} // namespace d12u
\ No newline at end of file
+#pragma once
+#include "Helper.h"
+#include "RingAllocator.h"
+#include <queue>
+#include <list>
+#include <array>
+#include <functional>
+
+namespace d12u
+{
+enum class UploadPriority
+{
+    // visible meshes
+    Mesh,
+    Texture,
+    COUNT,
+};
+
+struct UploadCommand
+{
+    std::shared_ptr<class ResourceItem> Item;
+    const void *Data = nullptr;
+    UINT ByteLength = 0;
+    UINT Stride = 0;
+    UploadPriority Priority = UploadPriority::Mesh;
+    // bytes already copied. large command is split to chunks
+    UINT Offset = 0;
+    std::vector<uint8_t> Payload;
+    // after the copy of the last chunk completed. Data may be released
+    std::function<void()> OnUploaded;
+    // mip level. Stride is bytes of texel row or 4x4 block row
+    UINT Subresource = 0;
+    // row pitch of Data. Stride if 0. aligned pitch is copied as is
+    UINT RowPitch = 0;
+    // false except the last level of a texture
+    bool MarkUploaded = true;
+
+    UploadCommand(const UploadCommand &rhs) = delete;
+    UploadCommand &operator=(const UploadCommand &rhs) = delete;
+    UploadCommand() {}
+    UploadCommand(const std::shared_ptr<class ResourceItem> &item,
+                  const void *data, UINT byteLength, UINT stride,
+                  UploadPriority priority = UploadPriority::Mesh)
+        : Item(item), Data(data), ByteLength(byteLength), Stride(stride), Priority(priority)
+    {
+    }
+
+    void UsePayload(const std::shared_ptr<class ResourceItem> &item, UINT stride)
+    {
+        Item = item;
+        Stride = stride;
+        // refer payload. payload has lifetime while MapCopyUnmap
+        Data = Payload.data();
+        ByteLength = (UINT)Payload.size();
+    }
+};
+
+///
+/// copy queue uploader
+///
+/// * packs enqueued commands into one submission per Update
+/// * commands are written to a persistently mapped staging ring
+/// * ring regions and command lists are retired by fence value
+/// * higher UploadPriority first, within BytesPerFrame and MillisecondsPerFrame
+/// * command larger than ChunkBytes is split. texture by rows
+/// * texture rows are repacked to D3D12_TEXTURE_DATA_PITCH_ALIGNMENT unless Data is already pitched
+///
+class Uploader : NonCopyable
+{
+    template <class T>
+    using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    class CommandQueue *m_queue = nullptr;
+
+    std::array<std::queue<std::shared_ptr<UploadCommand>>, (size_t)UploadPriority::COUNT> m_commands;
+    UINT64 m_pendingBytes = 0;
+    using OnCompletedFunc = std::function<void()>;
+
+    // for upload staging
+    UINT64 m_ringSize;
+    RingAllocator m_ring;
+    std::shared_ptr<class ResourceItem> m_upload;
+    uint8_t *m_mapped = nullptr;
+
+    struct Submission
+    {
+        UINT64 FenceValue = 0;
+        std::unique_ptr<class CommandList> List;
+        std::list<OnCompletedFunc> Callbacks;
+        // for chunk larger than ring
+        std::shared_ptr<class ResourceItem> Dedicated;
+    };
+    std::queue<Submission> m_submissions;
+    std::vector<std::unique_ptr<class CommandList>> m_freeCommandLists;
+
+public:
+    struct Stats
+    {
+        // completed commands
+        UINT Commands = 0;
+        UINT Chunks = 0;
+        UINT64 Bytes = 0;
+        float Milliseconds = 0;
+        UINT Pending = 0;
+        UINT64 PendingBytes = 0;
+        UINT InFlight = 0;
+        UINT64 StagingUsed = 0;
+    };
+
+private:
+    Stats m_stats;
+
+    void Retire();
+    // return false if ring is full
+    bool Record(const ComPtr<ID3D12Device> &device, Submission *submission, UploadCommand *command);
+
+public:
+    UINT64 BytesPerFrame = 32 * 1024 * 1024;
+    float MillisecondsPerFrame = 2.0f;
+    UINT ChunkBytes = 4 * 1024 * 1024;
+
+    Uploader(UINT64 ringSize = 64 * 1024 * 1024);
+    ~Uploader();
+    void Initialize(const ComPtr<ID3D12Device> &device);
+    void Update(const ComPtr<ID3D12Device> &device);
+    void EnqueueUpload(const std::shared_ptr<class ResourceItem> &item,
+                       const void *p, UINT byteLength, UINT stride,
+                       UploadPriority priority = UploadPriority::Mesh,
+                       std::function<void()> &&onUploaded = {})
+    {
+        auto command = std::make_shared<UploadCommand>(item, p, byteLength, stride, priority);
+        command->OnUploaded = std::move(onUploaded);
+        EnqueueUpload(command);
+    }
+    void EnqueueUpload(const std::shared_ptr<UploadCommand> &command)
+    {
+        m_commands[(size_t)command->Priority].push(command);
+        m_pendingBytes += command->ByteLength - command->Offset;
+    }
+
+    // last Update
+    const Stats &LastStats() const { return m_stats; }
+    const RingAllocator &Ring() const { return m_ring; }
+};
+} // namespace d12u
@@ -1,17 +1,24 @@
-#pragma once
-
-#include "Helper.h"
-#include "CommandQueue.h"
-#include "RenderTarget.h"
-#include "SwapChain.h"
-#include "CommandList.h"
-#include "ResourceItem.h"
-#include "Uploader.h"
-#include "Mesh.h"
-#include "ConstantBuffer.h"
-#include "RootSignature.h"
-#include "Heap.h"
-#include "SceneMapper.h"
-#include "Material.h"
-#include "Texture.h"
-#include "Shader.h"
\ No newline at end of file
+#pragma once
+
+#include "Helper.h"
+#include "CommandQueue.h"
+#include "RenderTarget.h"
+#include "SwapChain.h"
+#include "CommandList.h"
+#include "FrameRing.h"
+#include "ResidencyTracker.h"
+#include "ResourceItem.h"
+#include "Uploader.h"
+#include "Mesh.h"
+#include "ConstantBuffer.h"
+#include "RootSignature.h"
+#include "Heap.h"
+#include "PipelineCache.h"
+#include "DescriptorAllocator.h"
+#include "SceneMapper.h"
+#include "Material.h"
+#include "Texture.h"
+#include "Shader.h"
+#include "D3D12Backend.h"
+#include "D3D12SceneResources.h"
+#include "DrawListSubmitter.h"
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "ConstantSemanticParser.h"
+#include <algorithm>
+#include <vector>
+
+namespace hierarchy
+{
+
+ConstantSemantics ToConstantSemantics(std::string_view name)
+{
+    static const std::pair<std::string_view, ConstantSemantics> SEMANTICS[] = {
+        {"RENDERTARGET_SIZE", ConstantSemantics::RENDERTARGET_SIZE},
+        {"CAMERA_VIEW", ConstantSemantics::CAMERA_VIEW},
+        {"CAMERA_PROJECTION", ConstantSemantics::CAMERA_PROJECTION},
+        {"CAMERA_POSITION", ConstantSemantics::CAMERA_POSITION},
+        {"CAMERA_FOVY", ConstantSemantics::CAMERA_FOVY},
+        {"LIGHT_DIRECTION", ConstantSemantics::LIGHT_DIRECTION},
+        {"LIGHT_COLOR", ConstantSemantics::LIGHT_COLOR},
+        {"NODE_WORLD", ConstantSemantics::NODE_WORLD},
+    };
+    for (auto &[symbol, semantic] : SEMANTICS)
+    {
+        if (symbol == name)
+        {
+            return semantic;
+        }
+    }
+    return ConstantSemantics::UNKNOWN;
+}
+
+static bool IsIdentifierHead(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static bool IsIdentifier(char c)
+{
+    return IsIdentifierHead(c) || (c >= '0' && c <= '9');
+}
+
+class Tokenizer
+{
+    const char *m_p;
+    const char *m_end;
+    // only whitespace since line head
+    bool m_lineHead = true;
+
+    void SkipToLineEnd()
+    {
+        for (; m_p < m_end && *m_p != '\n'; ++m_p)
+        {
+            if (*m_p == '\\' && m_p + 1 < m_end && (m_p[1] == '\n' || m_p[1] == '\r'))
+            {
+                // continued line
+                m_p += (m_p[1] == '\r' && m_p + 2 < m_end && m_p[2] == '\n') ? 2 : 1;
+            }
+        }
+    }
+
+    void SkipSpaceAndComment()
+    {
+        while (m_p < m_end)
+        {
+            auto c = *m_p;
+            if (c == '\n')
+            {
+                m_lineHead = true;
+                ++m_p;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v')
+            {
+                ++m_p;
+            }
+            else if (c == '/' && m_p + 1 < m_end && m_p[1] == '/')
+            {
+                SkipToLineEnd();
+            }
+            else if (c == '/' && m_p + 1 < m_end && m_p[1] == '*')
+            {
+                m_p += 2;
+                for (; m_p < m_end && !(*m_p == '*' && m_p + 1 < m_end && m_p[1] == '/'); ++m_p)
+                {
+                    if (*m_p == '\n')
+                    {
+                        m_lineHead = true;
+                    }
+                }
+                m_p = std::min(m_p + 2, m_end);
+            }
+            else if (c == '#' && m_lineHead)
+            {
+                // #define, #if, #line...
+                SkipToLineEnd();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+public:
+    Tokenizer(std::string_view source)
+        : m_p(source.data()), m_end(source.data() + source.size())
+    {
+    }
+
+    // identifier, number, string or one punctuation. empty at end
+    std::string_view Next()
+    {
+        SkipSpaceAndComment();
+        if (m_p >= m_end)
+        {
+            return {};
+        }
+        m_lineHead = false;
+
+        auto begin = m_p;
+        if (IsIdentifier(*m_p))
+        {
+            // number is an identifier too
+            for (; m_p < m_end && (IsIdentifier(*m_p) || *m_p == '.'); ++m_p)
+            {
+            }
+        }
+        else if (*m_p == '"')
+        {
+            for (++m_p; m_p < m_end && *m_p != '"' && *m_p != '\n'; ++m_p)
+            {
+                if (*m_p == '\\')
+                {
+                    ++m_p;
+                }
+            }
+            m_p = std::min(m_p + 1, m_end);
+        }
+        else
+        {
+            ++m_p;
+        }
+        return std::string_view(begin, m_p - begin);
+    }
+};
+
+// [type] name [array] [: semantic] [: register] [= init] {, name ...}
+static void ParseDeclaration(const std::vector<std::string_view> &tokens, ConstantSemanticMap *map)
+{
+    std::string_view name;
+    bool declarator = true;
+    int depth = 0;
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        auto token = tokens[i];
+        if (token == "(" || token == "[" || token == "{" || token == "<")
+        {
+            if (depth == 0 && token == "[")
+            {
+                declarator = false;
+            }
+            ++depth;
+        }
+        else if (token == ")" || token == "]" || token == "}" || token == ">")
+        {
+            --depth;
+        }
+        else if (depth > 0)
+        {
+        }
+        else if (token == ",")
+        {
+            // next declarator
+            name = {};
+            declarator = true;
+        }
+        else if (token == "=")
+        {
+            declarator = false;
+        }
+        else if (token == ":")
+        {
+            declarator = false;
+            if (i + 1 < tokens.size() && !name.empty())
+            {
+                auto semantic = ToConstantSemantics(tokens[i + 1]);
+                if (semantic != ConstantSemantics::UNKNOWN)
+                {
+                    // first declaration wins
+                    map->emplace(std::string(name), semantic);
+                }
+            }
+        }
+        else if (declarator && IsIdentifierHead(token[0]))
+        {
+            // last identifier before : [ = is the name
+            name = token;
+        }
+    }
+}
+
+ConstantSemanticMap ParseConstantSemantics(std::string_view source)
+{
+    ConstantSemanticMap map;
+    Tokenizer tokenizer(source);
+
+    // global scope or directly in cbuffer
+    std::vector<std::string_view> statement;
+    bool inBuffer = false;
+    while (true)
+    {
+        auto token = tokenizer.Next();
+        if (token.empty())
+        {
+            break;
+        }
+
+        if (token == ";")
+        {
+            ParseDeclaration(statement, &map);
+            statement.clear();
+        }
+        else if (token == "{")
+        {
+            if (!inBuffer && !statement.empty() && (statement[0] == "cbuffer" || statement[0] == "tbuffer"))
+            {
+                inBuffer = true;
+            }
+            else
+            {
+                // struct, function or initializer. skip body
+                for (int depth = 1; depth > 0;)
+                {
+                    token = tokenizer.Next();
+                    if (token.empty())
+                    {
+                        return map;
+                    }
+                    if (token == "{")
+                    {
+                        ++depth;
+                    }
+                    else if (token == "}")
+                    {
+                        --depth;
+                    }
+                }
+                if (!statement.empty() && statement.back() == "=")
+                {
+                    // initializer. until ;
+                    continue;
+                }
+            }
+            // function or struct
+            statement.clear();
+        }
+        else if (token == "}")
+        {
+            // end of cbuffer
+            inBuffer = false;
+            statement.clear();
+        }
+        else
+        {
+            statement.push_back(token);
+        }
+    }
+    return map;
+}
+
+} // namespace hierarchy
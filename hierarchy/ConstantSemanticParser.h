@@ -0,0 +1,20 @@
+#pragma once
+#include "ShaderConstantVariable.h"
+#include <string_view>
+
+namespace hierarchy
+{
+
+// UNKNOWN if not a ConstantSemantics name
+ConstantSemantics ToConstantSemantics(std::string_view name);
+
+///
+/// one pass tokenizer of HLSL source. no d3d12
+///
+/// * declarations in cbuffer/tbuffer and at global scope ($Globals)
+/// * skips comments, preprocessor lines, strings, struct and function bodies
+/// * register and packoffset are not semantics
+///
+ConstantSemanticMap ParseConstantSemantics(std::string_view source);
+
+} // namespace hierarchy
@@ -0,0 +1,265 @@
+#include "D3DShaderCompiler.h"
+#include "ConstantSemanticParser.h"
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <d3dcompiler.h>
+#include <filesystem>
+#include <list>
+#include <unordered_map>
+
+template <typename T>
+using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+namespace hierarchy
+{
+
+#if defined(_DEBUG)
+// Enable better shader debugging with the graphics debugging tools.
+static const UINT COMPILE_FLAGS = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+static const UINT COMPILE_FLAGS = 0;
+#endif
+
+static std::string ToString(const ComPtr<ID3DBlob> &blob)
+{
+    if (!blob)
+    {
+        return {};
+    }
+    auto p = (const char *)blob->GetBufferPointer();
+    return std::string(p, p + blob->GetBufferSize());
+}
+
+///
+/// ID3DInclude over ShaderIncludeFunc
+///
+/// * nested include is relative to the including file, then to the shader directory
+///
+class IncludeHandler : public ID3DInclude
+{
+    const ShaderIncludeFunc &m_include;
+    // alive until D3DPreprocess returns
+    std::list<std::string> m_sources;
+    // opened data to its directory
+    std::unordered_map<const void *, std::filesystem::path> m_directories;
+
+public:
+    IncludeHandler(const ShaderIncludeFunc &include)
+        : m_include(include)
+    {
+    }
+
+    HRESULT STDMETHODCALLTYPE Open(D3D_INCLUDE_TYPE includeType, LPCSTR pFileName, LPCVOID pParentData,
+                                   LPCVOID *ppData, UINT *pBytes) override
+    {
+        std::filesystem::path parent;
+        auto found = m_directories.find(pParentData);
+        if (found != m_directories.end())
+        {
+            parent = found->second;
+        }
+
+        std::string source;
+        auto path = (parent / pFileName).lexically_normal();
+        if (!m_include(path.generic_string(), &source))
+        {
+            if (parent.empty())
+            {
+                return E_FAIL;
+            }
+            path = std::filesystem::path(pFileName).lexically_normal();
+            if (!m_include(path.generic_string(), &source))
+            {
+                return E_FAIL;
+            }
+        }
+
+        auto &data = m_sources.emplace_back(std::move(source));
+        m_directories[data.data()] = path.parent_path();
+        *ppData = data.data();
+        *pBytes = (UINT)data.size();
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE Close(LPCVOID pData) override
+    {
+        // released with the handler
+        return S_OK;
+    }
+};
+
+static DXGI_FORMAT GetFormat(const D3D12_SIGNATURE_PARAMETER_DESC &desc)
+{
+    static const DXGI_FORMAT formats[][3] = {
+        // UINT32, SINT32, FLOAT32
+        {DXGI_FORMAT_R32_UINT, DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32_FLOAT},
+        {DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32_FLOAT},
+        {DXGI_FORMAT_R32G32B32_UINT, DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32_FLOAT},
+        {DXGI_FORMAT_R32G32B32A32_UINT, DXGI_FORMAT_R32G32B32A32_SINT, DXGI_FORMAT_R32G32B32A32_FLOAT},
+    };
+    int components;
+    if (desc.Mask == 1)
+    {
+        components = 0;
+    }
+    else if (desc.Mask <= 3)
+    {
+        components = 1;
+    }
+    else if (desc.Mask <= 7)
+    {
+        components = 2;
+    }
+    else if (desc.Mask <= 15)
+    {
+        components = 3;
+    }
+    else
+    {
+        throw "unknown";
+    }
+
+    switch (desc.ComponentType)
+    {
+    case D3D_REGISTER_COMPONENT_UINT32:
+        return formats[components][0];
+    case D3D_REGISTER_COMPONENT_SINT32:
+        return formats[components][1];
+    case D3D_REGISTER_COMPONENT_FLOAT32:
+        return formats[components][2];
+    default:
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+static void GetVariables(ID3D12ShaderReflection *pReflection, ID3D12ShaderReflectionConstantBuffer *cb,
+                         const ConstantSemanticMap &semantics, ConstantBuffer *buffer)
+{
+    D3D12_SHADER_BUFFER_DESC cbDesc;
+    cb->GetDesc(&cbDesc);
+    for (unsigned j = 0; j < cbDesc.Variables; ++j)
+    {
+        auto cbVariable = cb->GetVariableByIndex(j);
+        D3D12_SHADER_VARIABLE_DESC variableDesc;
+        cbVariable->GetDesc(&variableDesc);
+        buffer->Variables.push_back(ConstantVariable{
+            .Name = variableDesc.Name,
+            .Semantic = ConstantSemantics::UNKNOWN,
+            .Offset = variableDesc.StartOffset,
+            .Size = variableDesc.Size,
+        });
+        auto found = semantics.find(buffer->Variables.back().Name);
+        if (found != semantics.end())
+        {
+            buffer->Variables.back().Semantic = found->second;
+        }
+    }
+
+    D3D12_SHADER_INPUT_BIND_DESC bindDesc;
+    pReflection->GetResourceBindingDescByName(cbDesc.Name, &bindDesc);
+    buffer->reg = bindDesc.BindPoint;
+}
+
+static void GetConstants(const ComPtr<ID3D12ShaderReflection> &reflection, const ConstantSemanticMap &semantics,
+                         std::vector<ConstantBuffer> *buffers)
+{
+    D3D12_SHADER_DESC desc;
+    reflection->GetDesc(&desc);
+    for (unsigned i = 0; i < desc.ConstantBuffers; ++i)
+    {
+        auto cb = reflection->GetConstantBufferByIndex(i);
+        buffers->push_back({});
+        GetVariables(reflection.Get(), cb, semantics, &buffers->back());
+    }
+}
+
+static bool CompileStage(const std::string &name, const std::string &source, const char *entryPoint, const char *target,
+                         std::vector<uint8_t> *bytecode, ComPtr<ID3D12ShaderReflection> *reflection, std::string *error)
+{
+    ComPtr<ID3DBlob> compiled;
+    ComPtr<ID3DBlob> errorBlob;
+    if (FAILED(D3DCompile(source.data(), source.size(), name.c_str(), nullptr, nullptr, entryPoint, target,
+                          COMPILE_FLAGS, 0, &compiled, &errorBlob)))
+    {
+        *error = ToString(errorBlob);
+        return false;
+    }
+    auto p = (const uint8_t *)compiled->GetBufferPointer();
+    bytecode->assign(p, p + compiled->GetBufferSize());
+
+    if (FAILED(D3DReflect(bytecode->data(), bytecode->size(), IID_PPV_ARGS(&*reflection))))
+    {
+        *error = name + ": D3DReflect failed";
+        return false;
+    }
+    return true;
+}
+
+std::string D3DShaderCompiler::Version() const
+{
+    return "d3dcompiler_" + std::to_string(D3D_COMPILER_VERSION) + " vs_5_0 ps_5_0 " + std::to_string(COMPILE_FLAGS);
+}
+
+bool D3DShaderCompiler::Preprocess(const std::string &name, const std::string &source, const ShaderIncludeFunc &include,
+                                   std::string *preprocessed, std::string *error)
+{
+    IncludeHandler handler(include);
+    ComPtr<ID3DBlob> blob;
+    ComPtr<ID3DBlob> errorBlob;
+    if (FAILED(D3DPreprocess(source.data(), source.size(), name.c_str(), nullptr, include ? &handler : nullptr,
+                             &blob, &errorBlob)))
+    {
+        *error = ToString(errorBlob);
+        return false;
+    }
+    *preprocessed = ToString(blob);
+    return true;
+}
+
+bool D3DShaderCompiler::Compile(const std::string &name, const std::string &preprocessed,
+                                ShaderBinary *binary, std::string *error)
+{
+    // once for both stages
+    auto semantics = ParseConstantSemantics(preprocessed);
+
+    //
+    // VS
+    //
+    {
+        ComPtr<ID3D12ShaderReflection> reflection;
+        if (!CompileStage(name, preprocessed, "VSMain", "vs_5_0", &binary->VS, &reflection, error))
+        {
+            return false;
+        }
+
+        D3D12_SHADER_DESC desc;
+        reflection->GetDesc(&desc);
+        for (unsigned i = 0; i < desc.InputParameters; ++i)
+        {
+            D3D12_SIGNATURE_PARAMETER_DESC paramDesc;
+            reflection->GetInputParameterDesc(i, &paramDesc);
+            binary->Inputs.push_back({
+                .Semantic = paramDesc.SemanticName,
+                .SemanticIndex = paramDesc.SemanticIndex,
+                .Format = (uint32_t)GetFormat(paramDesc),
+            });
+        }
+        GetConstants(reflection, semantics, &binary->VSConstants);
+    }
+
+    //
+    // PS
+    //
+    {
+        ComPtr<ID3D12ShaderReflection> reflection;
+        if (!CompileStage(name, preprocessed, "PSMain", "ps_5_0", &binary->PS, &reflection, error))
+        {
+            return false;
+        }
+        GetConstants(reflection, semantics, &binary->PSConstants);
+    }
+
+    return true;
+}
+
+} // namespace hierarchy
@@ -0,0 +1,20 @@
+#pragma once
+#include "ShaderCompiler.h"
+
+namespace hierarchy
+{
+
+///
+/// D3DCompile vs_5_0 VSMain and ps_5_0 PSMain. input layout and constant buffers by D3DReflect
+///
+class D3DShaderCompiler : public ShaderCompiler
+{
+public:
+    std::string Version() const override;
+    bool Preprocess(const std::string &name, const std::string &source, const ShaderIncludeFunc &include,
+                    std::string *preprocessed, std::string *error) override;
+    bool Compile(const std::string &name, const std::string &preprocessed,
+                 ShaderBinary *binary, std::string *error) override;
+};
+
+} // namespace hierarchy
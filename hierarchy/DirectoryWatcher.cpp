@@ -0,0 +1,408 @@
+#include "DirectoryWatcher.h"
+#include <plog/Log.h>
+#include <algorithm>
+#include <vector>
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <unordered_map>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace hierarchy
+{
+
+#if defined(_WIN32)
+
+struct DirectoryWatcher::Backend
+{
+    static const DWORD FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+    HANDLE Dir = INVALID_HANDLE_VALUE;
+    HANDLE Stop = NULL;
+    OVERLAPPED Overlapped = {};
+    // DWORD aligned. 64KB is the limit over network
+    std::vector<DWORD> Buffer = std::vector<DWORD>(64 * 1024 / sizeof(DWORD));
+    bool Reading = false;
+
+    Backend(const std::filesystem::path &path)
+    {
+        Dir = CreateFileW(path.c_str(),
+                          FILE_LIST_DIRECTORY,
+                          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                          NULL,
+                          OPEN_EXISTING,
+                          FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                          NULL);
+        if (Dir == INVALID_HANDLE_VALUE)
+        {
+            throw "CreateFile failed.";
+        }
+        Stop = CreateEventW(NULL, TRUE, FALSE, NULL);
+        Overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+    }
+
+    ~Backend()
+    {
+        if (Reading)
+        {
+            CancelIoEx(Dir, &Overlapped);
+            DWORD bytes;
+            GetOverlappedResult(Dir, &Overlapped, &bytes, TRUE);
+        }
+        CloseHandle(Overlapped.hEvent);
+        CloseHandle(Stop);
+        CloseHandle(Dir);
+    }
+
+    void Wake()
+    {
+        SetEvent(Stop);
+    }
+
+    // false if woken
+    bool Wait(DirectoryWatcher *watcher, int timeout)
+    {
+        if (!Reading)
+        {
+            ResetEvent(Overlapped.hEvent);
+            if (!ReadDirectoryChangesW(Dir, Buffer.data(), (DWORD)(Buffer.size() * sizeof(DWORD)), TRUE, FILTER,
+                                       NULL, &Overlapped, NULL))
+            {
+                throw "ReadDirectoryChangesW failed.";
+            }
+            Reading = true;
+        }
+
+        HANDLE handles[] = {Overlapped.hEvent, Stop};
+        auto result = WaitForMultipleObjects(_countof(handles), handles, FALSE, timeout < 0 ? INFINITE : (DWORD)timeout);
+        if (result == WAIT_OBJECT_0 + 1)
+        {
+            return false;
+        }
+        if (result != WAIT_OBJECT_0)
+        {
+            // timeout
+            return true;
+        }
+
+        Reading = false;
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(Dir, &Overlapped, &bytes, FALSE) || bytes == 0)
+        {
+            // ERROR_NOTIFY_ENUM_DIR. events are lost
+            LOGW << "overflow: " << watcher->m_path;
+            watcher->Rescan(true);
+            return true;
+        }
+        for (DWORD offset = 0;;)
+        {
+            auto p = (const FILE_NOTIFY_INFORMATION *)((const uint8_t *)Buffer.data() + offset);
+            if (p->Action != FILE_ACTION_REMOVED && p->Action != FILE_ACTION_RENAMED_OLD_NAME)
+            {
+                watcher->Notify(std::wstring(p->FileName, p->FileNameLength / sizeof(WCHAR)));
+            }
+            if (!p->NextEntryOffset)
+            {
+                break;
+            }
+            offset += p->NextEntryOffset;
+        }
+        return true;
+    }
+};
+
+#elif defined(__linux__)
+
+struct DirectoryWatcher::Backend
+{
+    static const uint32_t MASK = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_ONLYDIR;
+
+    int Fd = -1;
+    int WakeFd = -1;
+    std::filesystem::path Root;
+    // watch descriptor to relative directory. not recursive
+    std::unordered_map<int, std::filesystem::path> Dirs;
+
+    Backend(const std::filesystem::path &path)
+        : Root(path)
+    {
+        Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (Fd < 0)
+        {
+            throw "inotify_init1 failed.";
+        }
+        WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (WakeFd < 0)
+        {
+            close(Fd);
+            throw "eventfd failed.";
+        }
+        AddTree({});
+    }
+
+    ~Backend()
+    {
+        close(WakeFd);
+        close(Fd);
+    }
+
+    void Add(const std::filesystem::path &relative)
+    {
+        auto wd = inotify_add_watch(Fd, (Root / relative).c_str(), MASK);
+        if (wd >= 0)
+        {
+            Dirs[wd] = relative;
+        }
+    }
+
+    void AddTree(const std::filesystem::path &relative)
+    {
+        Add(relative);
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(Root / relative, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_directory(ec))
+            {
+                Add(it->path().lexically_relative(Root));
+            }
+        }
+    }
+
+    void Wake()
+    {
+        uint64_t value = 1;
+        while (write(WakeFd, &value, sizeof(value)) < 0)
+        {
+            if (errno == EAGAIN)
+            {
+                // counter is full. already readable
+                break;
+            }
+            if (errno != EINTR)
+            {
+                LOGE << "eventfd write failed: " << errno;
+                break;
+            }
+        }
+    }
+
+    // false if woken
+    bool Wait(DirectoryWatcher *watcher, int timeout)
+    {
+        pollfd fds[] = {
+            {.fd = Fd, .events = POLLIN, .revents = 0},
+            {.fd = WakeFd, .events = POLLIN, .revents = 0},
+        };
+        if (poll(fds, 2, timeout) < 0)
+        {
+            // EINTR
+            return true;
+        }
+        if (fds[1].revents & POLLIN)
+        {
+            return false;
+        }
+
+        bool overflow = false;
+        bool rescan = false;
+        alignas(inotify_event) char buffer[64 * 1024];
+        while (true)
+        {
+            auto size = read(Fd, buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                // EAGAIN
+                break;
+            }
+            for (ssize_t offset = 0; offset < size;)
+            {
+                auto event = (const inotify_event *)(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    overflow = true;
+                    continue;
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    // directory removed
+                    Dirs.erase(event->wd);
+                    continue;
+                }
+                auto found = Dirs.find(event->wd);
+                if (found == Dirs.end() || event->len == 0)
+                {
+                    continue;
+                }
+                auto relative = found->second / event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        // files may be in it already
+                        AddTree(relative);
+                        rescan = true;
+                    }
+                    continue;
+                }
+                watcher->Notify(relative);
+            }
+        }
+        if (overflow)
+        {
+            // events are lost
+            LOGW << "overflow: " << watcher->m_path;
+        }
+        if (overflow || rescan)
+        {
+            watcher->Rescan(true);
+        }
+        return true;
+    }
+};
+
+#else
+
+// polling
+struct DirectoryWatcher::Backend
+{
+    std::mutex Mutex;
+    std::condition_variable Cv;
+    bool Stop = false;
+
+    // Rescan lists the directory
+    Backend(const std::filesystem::path &)
+    {
+    }
+
+    void Wake()
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Stop = true;
+        Cv.notify_all();
+    }
+
+    // false if woken
+    bool Wait(DirectoryWatcher *watcher, int timeout)
+    {
+        {
+            std::unique_lock<std::mutex> lock(Mutex);
+            auto interval = std::chrono::milliseconds(timeout < 0 ? 500 : std::min(timeout, 500));
+            if (Cv.wait_for(lock, interval, [this] { return Stop; }))
+            {
+                return false;
+            }
+        }
+        watcher->Rescan(true);
+        return true;
+    }
+};
+
+#endif
+
+DirectoryWatcher::DirectoryWatcher(const std::filesystem::path &path, const OnChangedFunc &onChanged,
+                                   Clock::duration debounce)
+    : m_path(path), m_onChanged(onChanged), m_debounce(debounce), m_backend(new Backend(path))
+{
+    // baseline for overflow
+    Rescan(false);
+    m_thread = std::thread(&DirectoryWatcher::Run, this);
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    m_backend->Wake();
+    m_thread.join();
+}
+
+void DirectoryWatcher::Run()
+{
+    while (m_backend->Wait(this, NextTimeout()))
+    {
+        Flush();
+    }
+}
+
+void DirectoryWatcher::Notify(const std::filesystem::path &relative)
+{
+    // restart
+    m_pending[relative] = Clock::now() + m_debounce;
+}
+
+void DirectoryWatcher::Rescan(bool notify)
+{
+    std::map<std::filesystem::path, FileState> snapshot;
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(m_path, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (!it->is_regular_file(ec))
+        {
+            continue;
+        }
+        auto relative = it->path().lexically_relative(m_path);
+        FileState state{it->last_write_time(ec), it->file_size(ec)};
+        if (notify)
+        {
+            auto found = m_snapshot.find(relative);
+            if (found == m_snapshot.end() || found->second.LastWrite != state.LastWrite || found->second.Size != state.Size)
+            {
+                Notify(relative);
+            }
+        }
+        snapshot.emplace(relative, state);
+    }
+    m_snapshot.swap(snapshot);
+}
+
+void DirectoryWatcher::Flush()
+{
+    auto now = Clock::now();
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        if (it->second > now)
+        {
+            ++it;
+            continue;
+        }
+        auto relative = it->first;
+        it = m_pending.erase(it);
+
+        std::error_code ec;
+        auto path = m_path / relative;
+        if (!std::filesystem::is_regular_file(path, ec))
+        {
+            // removed
+            continue;
+        }
+        m_snapshot[relative] = {std::filesystem::last_write_time(path, ec), std::filesystem::file_size(path, ec)};
+        m_onChanged(relative);
+    }
+}
+
+int DirectoryWatcher::NextTimeout() const
+{
+    if (m_pending.empty())
+    {
+        return -1;
+    }
+    auto next = Clock::time_point::max();
+    for (auto &[relative, deadline] : m_pending)
+    {
+        next = std::min(next, deadline);
+    }
+    auto ms = std::chrono::ceil<std::chrono::milliseconds>(next - Clock::now()).count();
+    return (int)std::max<decltype(ms)>(ms, 0);
+}
+
+} // namespace hierarchy
@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+///
+/// recursive file change notification on a thread
+///
+/// * ReadDirectoryChangesW on Windows, inotify on Linux, polling otherwise
+/// * events of a file are coalesced. OnChanged once after Debounce without events
+/// * overflow of the event queue rescans the directory
+/// * destructor wakes the thread. no dummy file
+///
+class DirectoryWatcher
+{
+public:
+    // relative path of a modified or created file. on the watcher thread
+    using OnChangedFunc = std::function<void(const std::filesystem::path &)>;
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::filesystem::path m_path;
+    OnChangedFunc m_onChanged;
+    Clock::duration m_debounce;
+
+    // platform handles
+    struct Backend;
+    std::unique_ptr<Backend> m_backend;
+    std::thread m_thread;
+
+    // watcher thread only
+    struct FileState
+    {
+        std::filesystem::file_time_type LastWrite;
+        uintmax_t Size;
+    };
+    std::map<std::filesystem::path, FileState> m_snapshot;
+    std::map<std::filesystem::path, Clock::time_point> m_pending;
+
+    // avoid copy
+    DirectoryWatcher(const DirectoryWatcher &) = delete;
+    DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+    void Run();
+    void Notify(const std::filesystem::path &relative);
+    // notify files changed since last scan
+    void Rescan(bool notify);
+    // OnChanged for settled files
+    void Flush();
+    // milliseconds until the next settled file. -1 if none
+    int NextTimeout() const;
+
+public:
+    DirectoryWatcher(const std::filesystem::path &path, const OnChangedFunc &onChanged,
+                     Clock::duration debounce = std::chrono::milliseconds(100));
+    ~DirectoryWatcher();
+
+    const std::filesystem::path &Path() const { return m_path; }
+    std::filesystem::path GetPath(const std::filesystem::path &relative) const { return m_path / relative; }
+};
+
+} // namespace hierarchy
@@ -1,39 +1,364 @@
-#include "DrawList.h"
-#include "SceneNode.h"
-#include "SceneMesh.h"
-#include "SceneMeshSkin.h"
-#include "VertexBuffer.h"
-
-namespace hierarchy
-{
-
-std::pair<uint32_t, uint32_t> DrawList::PushCB(const ConstantBuffer *cb, const CBValue *value, int count)
-{
-    auto offset = (uint32_t)CB.size();
-    if (cb)
-    {
-        CBRanges.push_back({offset, cb->End()});
-        CB.resize(CB.size() + CBRanges.back().second);
-        auto p = CB.data() + offset;
-        for (int i = 0; i < count; ++i, ++value)
-        {
-            for (auto &var : cb->Variables)
-            {
-                if (var.Semantic == value->semantic)
-                {
-                    // copy value
-                    memcpy(p + var.Offset, value->p, value->size);
-                    break;
-                }
-            }
-        }
-    }
-    else
-    {
-        CBRanges.push_back({offset, 256});
-    }
-
-    return CBRanges.back();
-} // namespace hierarchy
-
-} // namespace hierarchy
+#include "DrawList.h"
+#include "SceneNode.h"
+#include "SceneMesh.h"
+#include "SceneMeshSkin.h"
+#include "VertexBuffer.h"
+#include "FrameArena.h"
+#include <unordered_map>
+#include <algorithm>
+
+namespace hierarchy
+{
+
+std::pair<uint32_t, uint32_t> DrawList::PushCB(const ConstantBuffer *cb, const CBValue *value, int count)
+{
+    auto offset = (uint32_t)CB.size();
+    if (cb)
+    {
+        CBRanges.push_back({offset, cb->End()});
+        CB.resize(CB.size() + CBRanges.back().second);
+        auto p = CB.data() + offset;
+        for (int i = 0; i < count; ++i, ++value)
+        {
+            for (auto &var : cb->Variables)
+            {
+                if (var.Semantic == value->semantic)
+                {
+                    // copy value
+                    memcpy(p + var.Offset, value->p, value->size);
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        // keep CBRanges and CB same length for SemanticsConstantBuffer::Assign
+        CBRanges.push_back({offset, 256});
+        CB.resize(CB.size() + CBRanges.back().second);
+    }
+
+    return CBRanges.back();
+} // namespace hierarchy
+
+void DrawList::PushInstance(const std::array<float, 16> &world)
+{
+    auto &item = Items.back();
+    item.InstanceOffset = (uint32_t)Instances.size();
+    item.InstanceCount = 1;
+    Instances.push_back(world);
+}
+
+void DrawList::PushWorldPatch(const SceneNode *node, const ConstantBuffer *cb)
+{
+    WorldPatch patch{
+        .Node = node,
+        .Item = (uint32_t)Items.size() - 1,
+        .CBOffset = NO_PATCH,
+        .Instance = NO_PATCH,
+    };
+    if (cb)
+    {
+        for (auto &var : cb->Variables)
+        {
+            if (var.Semantic == ConstantSemantics::NODE_WORLD)
+            {
+                patch.CBOffset = CBRanges.back().first + var.Offset;
+                break;
+            }
+        }
+    }
+    auto &item = Items.back();
+    if (item.InstanceCount)
+    {
+        patch.Instance = item.InstanceOffset;
+    }
+    if (patch.CBOffset == NO_PATCH && patch.Instance == NO_PATCH)
+    {
+        return;
+    }
+    WorldPatches.push_back(patch);
+}
+
+void DrawList::SortWorldPatches()
+{
+    std::sort(WorldPatches.begin(), WorldPatches.end(), [](const WorldPatch &lhs, const WorldPatch &rhs) {
+        return lhs.Node < rhs.Node;
+    });
+}
+
+static void Patch(DrawList *dst, const DrawList::Mark &base, const DrawList::WorldPatch &patch,
+                  const std::array<float, 16> &m)
+{
+    if (patch.CBOffset != DrawList::NO_PATCH)
+    {
+        memcpy(dst->CB.data() + base.CB + patch.CBOffset, &m, sizeof(m));
+    }
+    if (patch.Instance != DrawList::NO_PATCH)
+    {
+        dst->Instances[base.Instances + patch.Instance] = m;
+    }
+}
+
+void DrawList::PatchWorld(const SceneNode *node, DrawList *dst, const Mark &base) const
+{
+    auto [begin, end] = std::equal_range(WorldPatches.begin(), WorldPatches.end(), WorldPatch{.Node = node},
+                                         [](const WorldPatch &lhs, const WorldPatch &rhs) {
+                                             return lhs.Node < rhs.Node;
+                                         });
+    if (begin == end)
+    {
+        // not drawn
+        return;
+    }
+    std::array<float, 16> m = node->World().RowMatrix();
+    for (auto it = begin; it != end; ++it)
+    {
+        Patch(dst, base, *it, m);
+    }
+}
+
+void DrawList::PatchAllWorlds(DrawList *dst, const Mark &base) const
+{
+    const SceneNode *node = nullptr;
+    std::array<float, 16> m;
+    for (auto &patch : WorldPatches)
+    {
+        if (patch.Node != node)
+        {
+            node = patch.Node;
+            m = node->World().RowMatrix();
+        }
+        Patch(dst, base, patch, m);
+    }
+}
+
+void DrawList::Rewind(const Mark &mark)
+{
+    // shrink only
+    CB.resize(std::min(CB.size(), mark.CB));
+    CBRanges.resize(std::min(CBRanges.size(), mark.CBRanges));
+    Instances.resize(std::min(Instances.size(), mark.Instances));
+    if (Items.size() > mark.Items)
+    {
+        Items.erase(Items.begin() + mark.Items, Items.end());
+    }
+    WorldPatches.resize(std::min(WorldPatches.size(), mark.WorldPatches));
+}
+
+void DrawList::Append(const DrawList &src)
+{
+    auto itemOffset = (uint32_t)Items.size();
+    auto cbOffset = (uint32_t)CB.size();
+    CB.insert(CB.end(), src.CB.begin(), src.CB.end());
+    for (auto [offset, size] : src.CBRanges)
+    {
+        CBRanges.push_back({cbOffset + offset, size});
+    }
+
+    auto instanceOffset = (uint32_t)Instances.size();
+    Instances.insert(Instances.end(), src.Instances.begin(), src.Instances.end());
+    for (auto &item : src.Items)
+    {
+        Items.push_back(item);
+        Items.back().InstanceOffset += instanceOffset;
+    }
+
+    for (auto patch : src.WorldPatches)
+    {
+        patch.Item += itemOffset;
+        if (patch.CBOffset != NO_PATCH)
+        {
+            patch.CBOffset += cbOffset;
+        }
+        if (patch.Instance != NO_PATCH)
+        {
+            patch.Instance += instanceOffset;
+        }
+        WorldPatches.push_back(patch);
+    }
+}
+
+// resize [offset, offset + count) to srcCount. the following elements are moved once
+template <typename T>
+static void Resize(std::vector<T> *values, size_t offset, size_t count, size_t srcCount)
+{
+    if (srcCount > count)
+    {
+        values->insert(values->begin() + offset + count, srcCount - count, T{});
+    }
+    else if (srcCount < count)
+    {
+        values->erase(values->begin() + offset + srcCount, values->begin() + offset + count);
+    }
+}
+
+void DrawList::Splice(const Mark &begin, const Mark &size, const DrawList &src)
+{
+    Resize(&CB, begin.CB, size.CB, src.CB.size());
+    std::copy(src.CB.begin(), src.CB.end(), CB.begin() + begin.CB);
+    auto cbDelta = (uint32_t)(src.CB.size() - size.CB);
+
+    Resize(&CBRanges, begin.CBRanges, size.CBRanges, src.CBRanges.size());
+    for (size_t i = 0; i < src.CBRanges.size(); ++i)
+    {
+        auto [offset, bytes] = src.CBRanges[i];
+        CBRanges[begin.CBRanges + i] = {(uint32_t)begin.CB + offset, bytes};
+    }
+    for (auto i = begin.CBRanges + src.CBRanges.size(); i < CBRanges.size(); ++i)
+    {
+        // wraps for shrink
+        CBRanges[i].first += cbDelta;
+    }
+
+    Resize(&Instances, begin.Instances, size.Instances, src.Instances.size());
+    std::copy(src.Instances.begin(), src.Instances.end(), Instances.begin() + begin.Instances);
+    auto instanceDelta = (uint32_t)(src.Instances.size() - size.Instances);
+
+    Resize(&Items, begin.Items, size.Items, src.Items.size());
+    for (size_t i = 0; i < src.Items.size(); ++i)
+    {
+        auto &item = Items[begin.Items + i];
+        item = src.Items[i];
+        item.InstanceOffset += (uint32_t)begin.Instances;
+    }
+    for (auto i = begin.Items + src.Items.size(); i < Items.size(); ++i)
+    {
+        Items[i].InstanceOffset += instanceDelta;
+    }
+}
+
+struct InstanceKey
+{
+    const SceneMesh *Mesh;
+    int SubmeshIndex;
+
+    bool operator==(const InstanceKey &rhs) const
+    {
+        return Mesh == rhs.Mesh && SubmeshIndex == rhs.SubmeshIndex;
+    }
+};
+
+struct InstanceKeyHash
+{
+    size_t operator()(const InstanceKey &key) const
+    {
+        return std::hash<const void *>()(key.Mesh) ^ ((size_t)key.SubmeshIndex << 1);
+    }
+};
+
+static bool IsInstancable(const DrawList::DrawItem &item)
+{
+    // dynamic buffer(gizmo) is not shared by other item
+    return item.InstanceCount == 1 && !item.Vertices.Ptr && !item.Indices.Ptr;
+}
+
+void DrawList::MergeInstances()
+{
+    //
+    // group items. first item of group keeps draw order
+    //
+    FrameHashMap<InstanceKey, uint32_t, InstanceKeyHash> groupMap;
+    FrameVector<uint32_t> groups(Items.size());
+    FrameVector<uint32_t> heads;
+    heads.reserve(Items.size());
+    for (uint32_t i = 0; i < (uint32_t)Items.size(); ++i)
+    {
+        auto &item = Items[i];
+        if (IsInstancable(item))
+        {
+            auto [found, inserted] = groupMap.insert(std::make_pair(
+                InstanceKey{item.Mesh.get(), item.SubmeshIndex}, (uint32_t)heads.size()));
+            if (!inserted)
+            {
+                groups[i] = found->second;
+                continue;
+            }
+        }
+        groups[i] = (uint32_t)heads.size();
+        heads.push_back(i);
+    }
+    if (heads.size() == Items.size())
+    {
+        // nothing to merge
+        return;
+    }
+
+    //
+    // make each group instances contiguous
+    //
+    FrameVector<uint32_t> offsets(heads.size());
+    for (uint32_t i = 0; i < (uint32_t)Items.size(); ++i)
+    {
+        offsets[groups[i]] += Items[i].InstanceCount;
+    }
+    uint32_t total = 0;
+    for (auto &offset : offsets)
+    {
+        auto count = offset;
+        offset = total;
+        total += count;
+    }
+    FrameVector<std::array<float, 16>> instances(total);
+    FrameVector<uint32_t> instanceMap(Instances.size());
+    auto cursors = offsets;
+    for (uint32_t i = 0; i < (uint32_t)Items.size(); ++i)
+    {
+        auto &item = Items[i];
+        auto &cursor = cursors[groups[i]];
+        for (uint32_t j = 0; j < item.InstanceCount; ++j)
+        {
+            instanceMap[item.InstanceOffset + j] = cursor;
+            instances[cursor++] = Instances[item.InstanceOffset + j];
+        }
+    }
+
+    //
+    // keep group head items and CB
+    //
+    FrameVector<DrawItem> items;
+    items.reserve(heads.size());
+    FrameVector<uint8_t> cb;
+    cb.reserve(CB.size());
+    FrameVector<std::pair<uint32_t, uint32_t>> ranges;
+    ranges.reserve(heads.size());
+    for (uint32_t g = 0; g < (uint32_t)heads.size(); ++g)
+    {
+        auto head = heads[g];
+        items.push_back(std::move(Items[head]));
+        auto &item = items.back();
+        item.InstanceOffset = offsets[g];
+        item.InstanceCount = cursors[g] - offsets[g];
+
+        auto [offset, size] = CBRanges[head];
+        ranges.push_back({(uint32_t)cb.size(), size});
+        cb.insert(cb.end(), CB.begin() + offset, CB.begin() + offset + size);
+    }
+
+    //
+    // patch destinations. CB of merged item is dropped
+    //
+    for (auto &patch : WorldPatches)
+    {
+        auto g = groups[patch.Item];
+        if (patch.CBOffset != NO_PATCH)
+        {
+            patch.CBOffset = heads[g] == patch.Item
+                                 ? ranges[g].first + (patch.CBOffset - CBRanges[patch.Item].first)
+                                 : NO_PATCH;
+        }
+        if (patch.Instance != NO_PATCH)
+        {
+            patch.Instance = instanceMap[patch.Instance];
+        }
+        patch.Item = g;
+    }
+
+    // keep capacity
+    Items.assign(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    CB.assign(cb.begin(), cb.end());
+    CBRanges.assign(ranges.begin(), ranges.end());
+    Instances.assign(instances.begin(), instances.end());
+}
+
+} // namespace hierarchy
@@ -1,55 +1,118 @@
-#pragma once
-#include <array>
-#include <vector>
-#include <memory>
-#include "ShaderConstantVariable.h"
-
-namespace hierarchy
-{
-
-class SceneMesh;
-class SceneNode;
-
-struct CBValue
-{
-    ConstantSemantics semantic;
-    const void *p;
-    uint32_t size;
-};
-
-struct DrawList
-{
-    //
-    // 可変サイズのCBバッファの配列
-    // TODO: 16byte(256?) alignment
-    //
-    std::vector<uint8_t> CB;
-    std::vector<std::pair<uint32_t, uint32_t>> CBRanges;
-
-    std::pair<uint32_t, uint32_t> PushCB(const ConstantBuffer *cb, const CBValue *value, int count);
-
-    struct Buffer
-    {
-        uint8_t *Ptr;
-        uint32_t Size;
-        uint32_t Stride;
-    };
-    struct DrawItem
-    {
-        // mesh
-        std::shared_ptr<SceneMesh> Mesh;
-        Buffer Vertices{};
-        Buffer Indices{};
-        int SubmeshIndex;
-    };
-    std::vector<DrawItem> Items;
-
-    void Clear()
-    {
-        CB.clear();
-        Items.clear();
-    }
-    // void Traverse(const std::shared_ptr<SceneNode> &node);
-};
-
-} // namespace hierarchy
+#pragma once
+#include <array>
+#include <vector>
+#include <memory>
+#include "ShaderConstantVariable.h"
+
+namespace hierarchy
+{
+
+class SceneMesh;
+class SceneNode;
+
+struct CBValue
+{
+    ConstantSemantics semantic;
+    const void *p;
+    uint32_t size;
+};
+
+struct DrawList
+{
+    //
+    // 可変サイズのCBバッファの配列
+    // TODO: 16byte(256?) alignment
+    //
+    std::vector<uint8_t> CB;
+    std::vector<std::pair<uint32_t, uint32_t>> CBRanges;
+
+    std::pair<uint32_t, uint32_t> PushCB(const ConstantBuffer *cb, const CBValue *value, int count);
+
+    //
+    // per instance world matrix. vertex stream slot 1(INSTANCE_WORLD)
+    //
+    std::vector<std::array<float, 16>> Instances;
+
+    struct Buffer
+    {
+        uint8_t *Ptr;
+        uint32_t Size;
+        uint32_t Stride;
+    };
+    struct DrawItem
+    {
+        // mesh
+        std::shared_ptr<SceneMesh> Mesh;
+        Buffer Vertices{};
+        Buffer Indices{};
+        int SubmeshIndex;
+        // Instances[InstanceOffset, InstanceOffset + InstanceCount).
+        // InstanceCount == 0 is not instanced draw(world from CB)
+        uint32_t InstanceOffset = 0;
+        uint32_t InstanceCount = 0;
+    };
+    std::vector<DrawItem> Items;
+
+    // add instance to Items.back()
+    void PushInstance(const std::array<float, 16> &world);
+
+    //
+    // where node world is written. for retained DrawList
+    //
+    static constexpr uint32_t NO_PATCH = UINT32_MAX;
+    struct WorldPatch
+    {
+        const SceneNode *Node;
+        uint32_t Item;
+        // NODE_WORLD in CB
+        uint32_t CBOffset;
+        // Instances index
+        uint32_t Instance;
+    };
+    std::vector<WorldPatch> WorldPatches;
+
+    // Items.back() and CBRanges.back() world of node
+    void PushWorldPatch(const SceneNode *node, const ConstantBuffer *cb);
+    // sort by Node for PatchWorld
+    void SortWorldPatches();
+
+    // merge same Mesh and SubmeshIndex items to one instanced draw
+    void MergeInstances();
+
+    // append src items. rebase CB and instance offsets
+    void Append(const DrawList &src);
+
+    void Clear()
+    {
+        CB.clear();
+        CBRanges.clear();
+        Instances.clear();
+        Items.clear();
+        WorldPatches.clear();
+    }
+
+    // rewind transient items pushed after GetMark
+    struct Mark
+    {
+        size_t CB = 0;
+        size_t CBRanges = 0;
+        size_t Instances = 0;
+        size_t Items = 0;
+        size_t WorldPatches = 0;
+    };
+    Mark GetMark() const
+    {
+        return {CB.size(), CBRanges.size(), Instances.size(), Items.size(), WorldPatches.size()};
+    }
+    void Rewind(const Mark &mark);
+
+    // replace the size range at begin with src. rebase src and the following items. WorldPatches are not kept
+    void Splice(const Mark &begin, const Mark &size, const DrawList &src);
+
+    // write node world to dst, where this is placed at base. require SortWorldPatches
+    void PatchWorld(const SceneNode *node, DrawList *dst, const Mark &base) const;
+    void PatchAllWorlds(DrawList *dst, const Mark &base) const;
+    // void Traverse(const std::shared_ptr<SceneNode> &node);
+};
+
+} // namespace hierarchy
@@ -0,0 +1,431 @@
+#include "DrawListCapture.h"
+#include "SceneMesh.h"
+#include "VertexBuffer.h"
+#include <unordered_map>
+#include <fstream>
+#include <string.h>
+#include <plog/Log.h>
+
+namespace hierarchy
+{
+
+class CaptureWriter
+{
+    std::ofstream &m_os;
+
+public:
+    CaptureWriter(std::ofstream &os)
+        : m_os(os)
+    {
+    }
+
+    template <typename T>
+    void Write(const T &value)
+    {
+        m_os.write((const char *)&value, sizeof(T));
+    }
+
+    void WriteBytes(const void *p, uint32_t size)
+    {
+        Write(size);
+        if (size)
+        {
+            m_os.write((const char *)p, size);
+        }
+    }
+
+    template <typename T>
+    void WriteVector(const std::vector<T> &values)
+    {
+        WriteBytes(values.data(), (uint32_t)(values.size() * sizeof(T)));
+    }
+
+    void WriteString(const std::string &src)
+    {
+        WriteBytes(src.data(), (uint32_t)src.size());
+    }
+
+    // utf-16
+    void WriteString(const std::wstring &src)
+    {
+        std::vector<uint16_t> dst(src.begin(), src.end());
+        WriteVector(dst);
+    }
+
+    void WriteVertexBuffer(const std::shared_ptr<VertexBuffer> &vb)
+    {
+        if (!vb)
+        {
+            Write((uint32_t)0);
+            return;
+        }
+        Write(vb->stride);
+        Write((uint8_t)vb->semantic);
+        Write((uint8_t)vb->isDynamic);
+        // released after upload
+        vb->payload.Rematerialize(&vb->buffer);
+        WriteVector(vb->buffer);
+    }
+};
+
+class CaptureReader
+{
+    const uint8_t *m_p;
+    const uint8_t *m_end;
+
+public:
+    CaptureReader(const std::vector<uint8_t> &bytes)
+        : m_p(bytes.data()), m_end(bytes.data() + bytes.size())
+    {
+    }
+
+    uint32_t Remaining() const
+    {
+        return (uint32_t)(m_end - m_p);
+    }
+
+    const uint8_t *Skip(uint32_t size)
+    {
+        if (size > (uint32_t)(m_end - m_p))
+        {
+            throw "capture: unexpected end";
+        }
+        auto p = m_p;
+        m_p += size;
+        return p;
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T value;
+        memcpy(&value, Skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void ReadVector(std::vector<T> *values)
+    {
+        auto size = Read<uint32_t>();
+        if (size % sizeof(T))
+        {
+            throw "capture: invalid size";
+        }
+        auto p = Skip(size);
+        values->resize(size / sizeof(T));
+        if (size)
+        {
+            memcpy(values->data(), p, size);
+        }
+    }
+
+    // std::pair is not trivially copyable
+    template <typename T, typename U>
+    void ReadVector(std::vector<std::pair<T, U>> *values)
+    {
+        static_assert(sizeof(std::pair<T, U>) == sizeof(T) + sizeof(U));
+        auto size = Read<uint32_t>();
+        if (size % sizeof(std::pair<T, U>))
+        {
+            throw "capture: invalid size";
+        }
+        auto p = Skip(size);
+        values->resize(size / sizeof(std::pair<T, U>));
+        for (auto &value : *values)
+        {
+            memcpy(&value.first, p, sizeof(T));
+            p += sizeof(T);
+            memcpy(&value.second, p, sizeof(U));
+            p += sizeof(U);
+        }
+    }
+
+    std::string ReadString()
+    {
+        auto size = Read<uint32_t>();
+        auto p = Skip(size);
+        return std::string((const char *)p, (const char *)p + size);
+    }
+
+    std::wstring ReadWString()
+    {
+        std::vector<uint16_t> src;
+        ReadVector(&src);
+        return std::wstring(src.begin(), src.end());
+    }
+
+    std::shared_ptr<VertexBuffer> ReadVertexBuffer()
+    {
+        auto stride = Read<uint32_t>();
+        if (!stride)
+        {
+            return nullptr;
+        }
+        auto vb = std::make_shared<VertexBuffer>();
+        vb->stride = stride;
+        vb->semantic = (Semantics)Read<uint8_t>();
+        vb->isDynamic = Read<uint8_t>() != 0;
+        ReadVector(&vb->buffer);
+        return vb;
+    }
+};
+
+bool DrawListCapture::Save(const std::filesystem::path &path, const DrawList &drawlist)
+{
+    //
+    // tables
+    //
+    std::vector<const SceneMesh *> meshes;
+    std::unordered_map<const SceneMesh *, uint32_t> meshMap;
+    std::vector<const SceneMaterial *> materials;
+    std::unordered_map<const SceneMaterial *, uint32_t> materialMap;
+    for (auto &item : drawlist.Items)
+    {
+        auto mesh = item.Mesh.get();
+        if (!meshMap.insert(std::make_pair(mesh, (uint32_t)meshes.size())).second)
+        {
+            continue;
+        }
+        meshes.push_back(mesh);
+        for (auto &submesh : mesh->submeshes)
+        {
+            auto material = submesh.material.get();
+            if (materialMap.insert(std::make_pair(material, (uint32_t)materials.size())).second)
+            {
+                materials.push_back(material);
+            }
+        }
+    }
+
+    std::ofstream os(path, std::ios::binary);
+    if (!os)
+    {
+        LOGW << "fail to open: " << path.filename().c_str();
+        return false;
+    }
+    CaptureWriter w(os);
+    w.Write(MAGIC);
+    w.Write(VERSION);
+
+    w.Write((uint32_t)materials.size());
+    for (auto material : materials)
+    {
+        w.WriteString(material->name);
+        w.WriteString(material->shader() ? material->shader()->name() : std::string());
+        w.Write((uint32_t)material->alphaMode());
+        w.Write(material->alphaCutoff);
+        auto &image = material->colorImage();
+        w.Write((uint8_t)(image ? 1 : 0));
+        if (image)
+        {
+            w.WriteString(image->name);
+            w.Write(image->width);
+            w.Write(image->height);
+        }
+    }
+
+    w.Write((uint32_t)meshes.size());
+    for (auto mesh : meshes)
+    {
+        w.WriteString(mesh->name);
+        w.WriteVertexBuffer(mesh->vertices);
+        w.WriteVertexBuffer(mesh->indices);
+        w.Write((uint32_t)mesh->submeshes.size());
+        for (auto &submesh : mesh->submeshes)
+        {
+            w.Write(submesh.drawOffset);
+            w.Write(submesh.drawCount);
+            w.Write(materialMap[submesh.material.get()]);
+        }
+    }
+
+    w.Write((uint32_t)drawlist.Items.size());
+    for (auto &item : drawlist.Items)
+    {
+        w.Write(meshMap[item.Mesh.get()]);
+        w.Write(item.SubmeshIndex);
+        w.Write(item.InstanceOffset);
+        w.Write(item.InstanceCount);
+        w.Write(item.Vertices.Stride);
+        w.WriteBytes(item.Vertices.Ptr, item.Vertices.Ptr ? item.Vertices.Size : 0);
+        w.Write(item.Indices.Stride);
+        w.WriteBytes(item.Indices.Ptr, item.Indices.Ptr ? item.Indices.Size : 0);
+    }
+
+    w.WriteVector(drawlist.CB);
+    w.WriteVector(drawlist.CBRanges);
+    w.WriteVector(drawlist.Instances);
+
+    if (!os)
+    {
+        LOGW << "fail to write: " << path.filename().c_str();
+        return false;
+    }
+    LOGI << "capture: " << path.filename().c_str() << ": " << drawlist.Items.size() << "items";
+    return true;
+}
+
+static std::vector<uint8_t> ReadAllBytes(const std::filesystem::path &path)
+{
+    std::vector<uint8_t> result;
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (ifs)
+    {
+        auto pos = ifs.tellg();
+        result.resize(pos);
+        ifs.seekg(0, std::ios::beg);
+        ifs.read((char *)result.data(), pos);
+    }
+    return result;
+}
+
+static void Load(DrawListCapture *capture, const std::vector<uint8_t> &bytes)
+{
+    CaptureReader r(bytes);
+    if (r.Read<uint32_t>() != DrawListCapture::MAGIC)
+    {
+        throw "capture: invalid magic";
+    }
+    if (r.Read<uint32_t>() != DrawListCapture::VERSION)
+    {
+        throw "capture: unknown version";
+    }
+
+    auto materialCount = r.Read<uint32_t>();
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        // without ShaderManager
+        auto material = std::make_shared<SceneMaterial>();
+        material->name = r.ReadString();
+        capture->MaterialShaders.push_back(r.ReadString());
+        material->alphaMode((AlphaMode)r.Read<uint32_t>());
+        material->alphaCutoff = r.Read<float>();
+        if (r.Read<uint8_t>())
+        {
+            auto image = SceneImage::Create();
+            image->name = r.ReadWString();
+            image->width = r.Read<int>();
+            image->height = r.Read<int>();
+            material->colorImage(image);
+        }
+        capture->Materials.push_back(material);
+    }
+
+    auto meshCount = r.Read<uint32_t>();
+    for (uint32_t i = 0; i < meshCount; ++i)
+    {
+        auto mesh = SceneMesh::Create();
+        mesh->name = r.ReadWString();
+        mesh->vertices = r.ReadVertexBuffer();
+        mesh->indices = r.ReadVertexBuffer();
+        auto submeshCount = r.Read<uint32_t>();
+        for (uint32_t j = 0; j < submeshCount; ++j)
+        {
+            SceneSubmesh submesh;
+            submesh.drawOffset = r.Read<uint32_t>();
+            submesh.drawCount = r.Read<uint32_t>();
+            auto material = r.Read<uint32_t>();
+            if (material >= capture->Materials.size())
+            {
+                throw "capture: invalid material index";
+            }
+            submesh.material = capture->Materials[material];
+            mesh->submeshes.push_back(submesh);
+        }
+        capture->Meshes.push_back(mesh);
+    }
+
+    auto &drawlist = capture->Drawlist;
+    auto itemCount = r.Read<uint32_t>();
+    // mesh, submesh, instance offset and count, 2 x (stride, size)
+    if (itemCount > r.Remaining() / 32)
+    {
+        throw "capture: invalid item count";
+    }
+    // keep DynamicBuffers address
+    capture->DynamicBuffers.reserve(itemCount * 2);
+    for (uint32_t i = 0; i < itemCount; ++i)
+    {
+        DrawList::DrawItem item{};
+        auto mesh = r.Read<uint32_t>();
+        if (mesh >= capture->Meshes.size())
+        {
+            throw "capture: invalid mesh index";
+        }
+        item.Mesh = capture->Meshes[mesh];
+        item.SubmeshIndex = r.Read<int>();
+        if (item.SubmeshIndex < 0 || item.SubmeshIndex >= (int)item.Mesh->submeshes.size())
+        {
+            throw "capture: invalid submesh index";
+        }
+        item.InstanceOffset = r.Read<uint32_t>();
+        item.InstanceCount = r.Read<uint32_t>();
+        for (auto buffer : {&item.Vertices, &item.Indices})
+        {
+            buffer->Stride = r.Read<uint32_t>();
+            auto &bytes = capture->DynamicBuffers.emplace_back();
+            r.ReadVector(&bytes);
+            if (!bytes.empty())
+            {
+                buffer->Ptr = bytes.data();
+                buffer->Size = (uint32_t)bytes.size();
+            }
+        }
+        drawlist.Items.push_back(item);
+    }
+
+    r.ReadVector(&drawlist.CB);
+    r.ReadVector(&drawlist.CBRanges);
+    r.ReadVector(&drawlist.Instances);
+
+    // replay indexes these without checks
+    if (drawlist.CBRanges.size() != drawlist.Items.size())
+    {
+        throw "capture: CBRanges and items mismatch";
+    }
+    for (auto [offset, size] : drawlist.CBRanges)
+    {
+        if ((uint64_t)offset + size > drawlist.CB.size())
+        {
+            throw "capture: CB range out of CB";
+        }
+    }
+    for (auto &item : drawlist.Items)
+    {
+        if ((uint64_t)item.InstanceOffset + item.InstanceCount > drawlist.Instances.size())
+        {
+            throw "capture: instance range out of Instances";
+        }
+    }
+}
+
+DrawListCapturePtr DrawListCapture::LoadFromPath(const std::filesystem::path &path)
+{
+    auto bytes = ReadAllBytes(path);
+    if (bytes.empty())
+    {
+        LOGW << "fail to read bytes: " << path.filename().c_str();
+        return nullptr;
+    }
+
+    auto capture = std::make_shared<DrawListCapture>();
+    try
+    {
+        Load(capture.get(), bytes);
+    }
+    catch (const char *msg)
+    {
+        LOGW << path.filename().c_str() << ": " << msg;
+        return nullptr;
+    }
+    catch (const std::exception &e)
+    {
+        LOGW << path.filename().c_str() << ": " << e.what();
+        return nullptr;
+    }
+
+    LOGI << "load: " << path.filename().c_str();
+    return capture;
+}
+
+} // namespace hierarchy
@@ -0,0 +1,39 @@
+#pragma once
+#include "DrawList.h"
+#include "SceneMaterial.h"
+#include "SceneMesh.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace hierarchy
+{
+
+///
+/// binary snapshot of a frame DrawList for offline replay
+///
+/// header | materials | meshes | items | CB | CBRanges | Instances
+///
+/// * meshes are stored once with vertex/index bytes
+/// * images are stored by name and size. pixels are not stored
+/// * dynamic Vertices/Indices(gizmo) are stored per item
+///
+struct DrawListCapture
+{
+    static constexpr uint32_t MAGIC = 0x50434C44; // DLCP
+    static constexpr uint32_t VERSION = 1;
+
+    DrawList Drawlist;
+    std::vector<SceneMaterialPtr> Materials;
+    // shader name of each Materials. SceneMaterial::shader is not restored
+    std::vector<std::string> MaterialShaders;
+    std::vector<SceneMeshPtr> Meshes;
+    // storage of DrawItem::Vertices.Ptr and Indices.Ptr
+    std::vector<std::vector<uint8_t>> DynamicBuffers;
+
+    static bool Save(const std::filesystem::path &path, const DrawList &drawlist);
+    static std::shared_ptr<DrawListCapture> LoadFromPath(const std::filesystem::path &path);
+};
+using DrawListCapturePtr = std::shared_ptr<DrawListCapture>;
+
+} // namespace hierarchy
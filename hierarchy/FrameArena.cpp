@@ -0,0 +1,80 @@
+#include "FrameArena.h"
+#include <atomic>
+#include <algorithm>
+
+// per thread
+const size_t BLOCK_SIZE = 1024 * 1024;
+
+namespace hierarchy
+{
+
+static std::atomic<uint32_t> g_frame = 1;
+static std::atomic<uint64_t> g_frameBytes = 0;
+static std::atomic<uint64_t> g_lastFrameBytes = 0;
+
+FrameArena::FrameArena(size_t blockSize)
+    : m_frame(g_frame)
+{
+    m_blocks.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[blockSize]), blockSize});
+}
+
+void FrameArena::Rewind()
+{
+    if (m_blocks.size() > 1)
+    {
+        // overflowed in last frame. one block for all
+        size_t size = 0;
+        for (auto &block : m_blocks)
+        {
+            size += block.Size;
+        }
+        m_blocks.clear();
+        m_blocks.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[size]), size});
+    }
+    m_offset = 0;
+}
+
+void *FrameArena::Allocate(size_t size, size_t align)
+{
+    auto frame = g_frame.load(std::memory_order_relaxed);
+    if (m_frame != frame)
+    {
+        m_frame = frame;
+        Rewind();
+    }
+    g_frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+    auto block = &m_blocks.back();
+    auto begin = (uintptr_t)block->Data.get();
+    auto p = (begin + m_offset + align - 1) & ~(uintptr_t)(align - 1);
+    if (p + size > begin + block->Size)
+    {
+        // add block. previous blocks are alive until next frame
+        auto blockSize = std::max(size + align, block->Size * 2);
+        m_blocks.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[blockSize]), blockSize});
+        block = &m_blocks.back();
+        begin = (uintptr_t)block->Data.get();
+        p = (begin + align - 1) & ~(uintptr_t)(align - 1);
+    }
+    m_offset = p + size - begin;
+    return (void *)p;
+}
+
+FrameArena &FrameArena::ThreadLocal()
+{
+    thread_local FrameArena tl_arena(BLOCK_SIZE);
+    return tl_arena;
+}
+
+void FrameArena::NewFrame()
+{
+    g_lastFrameBytes = g_frameBytes.exchange(0);
+    ++g_frame;
+}
+
+uint64_t FrameArena::LastFrameBytes()
+{
+    return g_lastFrameBytes;
+}
+
+} // namespace hierarchy
@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+///
+/// linear allocator for data that does not outlive the frame
+///
+/// * one arena per thread(ThreadLocal). no lock
+/// * NewFrame(frame_metrics::new_frame) resets all arenas in O(1).
+///   each arena rewinds at its next Allocate
+/// * do not keep memory across NewFrame. WorkerPool::Enqueue tasks should not use it
+///
+class FrameArena
+{
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> Data;
+        size_t Size;
+    };
+    std::vector<Block> m_blocks;
+    size_t m_offset = 0;
+    uint32_t m_frame = 0;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void Rewind();
+
+public:
+    FrameArena(size_t blockSize);
+
+    void *Allocate(size_t size, size_t align);
+
+    // thread_local instance
+    static FrameArena &ThreadLocal();
+
+    // reset all arenas
+    static void NewFrame();
+
+    // arena bytes of last frame. all threads
+    static uint64_t LastFrameBytes();
+};
+
+template <typename T>
+struct ArenaAllocator
+{
+    using value_type = T;
+
+    FrameArena *Arena;
+
+    ArenaAllocator()
+        : Arena(&FrameArena::ThreadLocal())
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &rhs)
+        : Arena(rhs.Arena)
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        return (T *)Arena->Allocate(n * sizeof(T), alignof(T));
+    }
+
+    void deallocate(T *, size_t)
+    {
+        // free at NewFrame
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &rhs) const { return Arena == rhs.Arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &rhs) const { return Arena != rhs.Arena; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename K, typename V, typename H = std::hash<K>>
+using FrameHashMap = std::unordered_map<K, V, H, std::equal_to<K>, ArenaAllocator<std::pair<const K, V>>>;
+
+} // namespace hierarchy
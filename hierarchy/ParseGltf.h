@@ -1,5 +1,5 @@
-#pragma once
-#include <gltfformat/gltf.h>
-
-
-gltfformat::glTF ParseGltf(const uint8_t *p, int size);
+#pragma once
+#include <gltfformat/gltf.h>
+
+
+gltfformat::glTF ParseGltf(const uint8_t *p, int size);
@@ -0,0 +1,201 @@
+#include "Payload.h"
+#include "WorkerPool.h"
+#include <plog/Log.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdio.h>
+
+namespace hierarchy
+{
+
+static std::atomic<bool> g_releaseAfterUpload = false;
+static std::atomic<uint64_t> g_releasedBytes = 0;
+static std::atomic<uint64_t> g_releases = 0;
+static std::atomic<uint64_t> g_rematerializations = 0;
+static std::atomic<uint64_t> g_spilledBytes = 0;
+
+bool ReadFileRange(const std::filesystem::path &path, uint64_t offset, uint64_t size, std::vector<uint8_t> *bytes)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+    ifs.seekg(offset);
+    bytes->resize(size);
+    ifs.read((char *)bytes->data(), size);
+    if ((uint64_t)ifs.gcount() != size)
+    {
+        bytes->clear();
+        return false;
+    }
+    return true;
+}
+
+// removed with the last PayloadSource
+class SpillFile
+{
+    std::filesystem::path m_path;
+    uint64_t m_size;
+
+    // bytes until written. kept if the write failed
+    std::mutex m_mutex;
+    std::vector<uint8_t> m_pending;
+
+    static std::filesystem::path NewPath()
+    {
+        // unique in this process and between processes
+        static const uint64_t session = std::random_device()() | ((uint64_t)std::random_device()() << 32);
+        static std::atomic<uint64_t> counter = 0;
+
+        std::error_code ec;
+        auto directory = std::filesystem::temp_directory_path(ec) / "MainMonitor";
+        std::filesystem::create_directories(directory, ec);
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx_%llu.payload", (unsigned long long)session,
+                 (unsigned long long)counter++);
+        return directory / name;
+    }
+
+    // on WorkerPool. m_pending is not modified until written
+    void Write()
+    {
+        std::ofstream ofs(m_path, std::ios::binary);
+        if (ofs)
+        {
+            ofs.write((const char *)m_pending.data(), m_pending.size());
+        }
+        if (!ofs)
+        {
+            LOGW << "fail to spill: " << m_path;
+            return;
+        }
+        ofs.close();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<uint8_t>().swap(m_pending);
+    }
+
+public:
+    SpillFile(std::vector<uint8_t> *bytes)
+        : m_path(NewPath()), m_size(bytes->size())
+    {
+        m_pending.swap(*bytes);
+        g_spilledBytes += m_size;
+    }
+
+    ~SpillFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+        g_spilledBytes -= m_size;
+    }
+
+    bool Read(std::vector<uint8_t> *bytes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_pending.empty())
+            {
+                // not written yet
+                *bytes = m_pending;
+                return true;
+            }
+        }
+        return ReadFileRange(m_path, 0, m_size, bytes);
+    }
+
+    // take bytes and write them on WorkerPool. not block the render thread
+    static std::shared_ptr<SpillFile> Spill(std::vector<uint8_t> *bytes)
+    {
+        auto file = std::make_shared<SpillFile>(bytes);
+        WorkerPool::Instance().Enqueue([file]() { file->Write(); });
+        return file;
+    }
+};
+
+Payload::~Payload()
+{
+    if (m_released)
+    {
+        g_releasedBytes -= m_releasedBytes;
+    }
+}
+
+void Payload::EndUpload(std::vector<uint8_t> *bytes)
+{
+    if (m_uploading == 0 || --m_uploading > 0)
+    {
+        return;
+    }
+    if (g_releaseAfterUpload)
+    {
+        Release(bytes);
+    }
+}
+
+bool Payload::Release(std::vector<uint8_t> *bytes)
+{
+    if (m_released || m_uploading > 0 || bytes->empty())
+    {
+        return false;
+    }
+
+    m_releasedBytes = bytes->size();
+    if (Source)
+    {
+        // free capacity
+        std::vector<uint8_t>().swap(*bytes);
+    }
+    else
+    {
+        // bytes move to the file
+        auto file = SpillFile::Spill(bytes);
+        Source = [file](std::vector<uint8_t> *bytes) { return file->Read(bytes); };
+    }
+    g_releasedBytes += m_releasedBytes;
+    ++g_releases;
+    m_released = true;
+    return true;
+}
+
+bool Payload::Rematerialize(std::vector<uint8_t> *bytes)
+{
+    if (!m_released)
+    {
+        return true;
+    }
+    if (!Source(bytes))
+    {
+        return false;
+    }
+    g_releasedBytes -= m_releasedBytes;
+    ++g_rematerializations;
+    m_released = false;
+    return true;
+}
+
+void Payload::ReleaseAfterUpload(bool enable)
+{
+    g_releaseAfterUpload = enable;
+}
+
+bool Payload::ReleaseAfterUpload()
+{
+    return g_releaseAfterUpload;
+}
+
+Payload::Stats Payload::GetStats()
+{
+    return {
+        .ReleasedBytes = g_releasedBytes,
+        .Releases = g_releases,
+        .Rematerializations = g_rematerializations,
+        .SpilledBytes = g_spilledBytes,
+    };
+}
+
+} // namespace hierarchy
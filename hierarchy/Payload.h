@@ -0,0 +1,61 @@
+#pragma once
+#include <functional>
+#include <filesystem>
+#include <vector>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+// reload released bytes. false if the source is lost
+using PayloadSource = std::function<bool(std::vector<uint8_t> *)>;
+
+bool ReadFileRange(const std::filesystem::path &path, uint64_t offset, uint64_t size, std::vector<uint8_t> *bytes);
+
+///
+/// CPU copy state of VertexBuffer::buffer and SceneImage::Bytes()
+///
+/// * opt-in. ReleaseAfterUpload(true) drops bytes when the last upload of them completed
+/// * Source reloads bytes. without Source, bytes are spilled to a temporary file on WorkerPool
+/// * Rematerialize before CPU access or re-upload
+/// * main thread
+///
+class Payload
+{
+    uint32_t m_uploading = 0;
+    bool m_released = false;
+    uint64_t m_releasedBytes = 0;
+
+public:
+    PayloadSource Source;
+
+    Payload() = default;
+    ~Payload();
+    // avoid copy
+    Payload(const Payload &) = delete;
+    Payload &operator=(const Payload &) = delete;
+
+    bool IsReleased() const { return m_released; }
+
+    // upload refers bytes until EndUpload
+    void BeginUpload() { ++m_uploading; }
+    void EndUpload(std::vector<uint8_t> *bytes);
+    bool Release(std::vector<uint8_t> *bytes);
+    bool Rematerialize(std::vector<uint8_t> *bytes);
+
+    static void ReleaseAfterUpload(bool enable);
+    static bool ReleaseAfterUpload();
+
+    struct Stats
+    {
+        // dropped now
+        uint64_t ReleasedBytes = 0;
+        uint64_t Releases = 0;
+        uint64_t Rematerializations = 0;
+        // temporary files
+        uint64_t SpilledBytes = 0;
+    };
+    static Stats GetStats();
+};
+
+} // namespace hierarchy
@@ -1,55 +1,61 @@
-#include "Scene.h"
-#include "SceneNode.h"
-#include "SceneMeshSkin.h"
-#include "VertexBuffer.h"
-#include <functional>
-
-namespace hierarchy
-{
-
-Scene::Scene()
-{
-}
-
-static void UpdateRecursive(const SceneNodePtr &node)
-{
-    auto mesh = node->Mesh();
-    if (mesh)
-    {
-        auto skin = mesh->skin;
-        if (skin)
-        {
-            // update matrix
-            auto &vertices = mesh->vertices;
-            skin->Update(vertices->buffer.data(), vertices->stride, vertices->Count());
-        }
-    }
-
-    int count;
-    auto child = node->GetChildren(&count);
-    for (int i = 0; i < count; ++i, ++child)
-    {
-        UpdateRecursive(*child);
-    }
-}
-
-void Scene::Update()
-{
-    for (auto &node : gizmoNodes)
-    {
-        node->UpdateWorld();
-        UpdateRecursive(node);
-    }
-    for (auto &node : vrNodes)
-    {
-        node->UpdateWorld();
-        UpdateRecursive(node);
-    }
-    for (auto &node : sceneNodes)
-    {
-        node->UpdateWorld();
-        UpdateRecursive(node);
-    }
-}
-
-} // namespace hierarchy
+#include "Scene.h"
+#include "SceneNode.h"
+#include "SceneMeshSkin.h"
+#include "VertexBuffer.h"
+#include <functional>
+
+namespace hierarchy
+{
+
+Scene::Scene()
+{
+}
+
+static void UpdateRecursive(const SceneNodePtr &node, std::vector<SceneNode *> *changedNodes)
+{
+    if (node->TakeWorldChanged())
+    {
+        changedNodes->push_back(node.get());
+    }
+
+    auto mesh = node->Mesh();
+    if (mesh)
+    {
+        auto skin = mesh->skin;
+        if (skin)
+        {
+            // update matrix
+            auto &vertices = mesh->vertices;
+            skin->Update(vertices->buffer.data(), vertices->stride, vertices->Count());
+        }
+    }
+
+    int count;
+    auto child = node->GetChildren(&count);
+    for (int i = 0; i < count; ++i, ++child)
+    {
+        UpdateRecursive(*child, changedNodes);
+    }
+}
+
+void Scene::Update()
+{
+    changedNodes.clear();
+    for (auto &node : gizmoNodes)
+    {
+        node->UpdateWorld();
+        UpdateRecursive(node, &changedNodes);
+    }
+    for (auto &node : vrNodes)
+    {
+        node->UpdateWorld();
+        UpdateRecursive(node, &changedNodes);
+    }
+    for (auto &node : sceneNodes)
+    {
+        node->UpdateWorld();
+        UpdateRecursive(node, &changedNodes);
+    }
+}
+
+} // namespace hierarchy
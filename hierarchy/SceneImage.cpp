@@ -1,30 +1,53 @@
-#include "SceneImage.h"
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
-
-namespace hierarchy
-{
-
-std::shared_ptr<SceneImage> SceneImage::Create()
-{
-    return SceneImagePtr(new SceneImage);
-}
-
-std::shared_ptr<SceneImage> SceneImage::Load(const uint8_t *p, int size)
-{
-    int x, y, n;
-    unsigned char *data = stbi_load_from_memory(p, size, &x, &y, &n, 4);
-    if (!data)
-    {
-        return nullptr;
-    }
-
-    auto image = Create();
-    image->width = x;
-    image->height = y;
-    image->buffer.assign(data, data + x * y * 4);
-    stbi_image_free(data);
-    return image;
-}
-
-} // namespace hierarchy
+#include "SceneImage.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+namespace hierarchy
+{
+
+std::shared_ptr<SceneImage> SceneImage::Create()
+{
+    return SceneImagePtr(new SceneImage);
+}
+
+std::shared_ptr<SceneImage> SceneImage::Load(const uint8_t *p, int size)
+{
+    auto image = Create();
+    if (!Decode(p, size, &image->buffer))
+    {
+        return nullptr;
+    }
+    stbi_info_from_memory(p, size, &image->width, &image->height, nullptr);
+    return image;
+}
+
+std::shared_ptr<SceneImage> SceneImage::LoadEncoded(const uint8_t *p, int size)
+{
+    int x, y, n;
+    if (!stbi_info_from_memory(p, size, &x, &y, &n))
+    {
+        return nullptr;
+    }
+
+    auto image = Create();
+    image->type = ImageType::Encoded;
+    image->width = x;
+    image->height = y;
+    image->encoded.assign(p, p + size);
+    return image;
+}
+
+bool SceneImage::Decode(const uint8_t *p, int size, std::vector<uint8_t> *rgba)
+{
+    int x, y, n;
+    unsigned char *data = stbi_load_from_memory(p, size, &x, &y, &n, 4);
+    if (!data)
+    {
+        return false;
+    }
+    rgba->assign(data, data + x * y * 4);
+    stbi_image_free(data);
+    return true;
+}
+
+} // namespace hierarchy
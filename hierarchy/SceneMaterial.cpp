@@ -1,14 +1,14 @@
-#include "SceneMaterial.h"
-#include "ShaderManager.h"
-
-namespace hierarchy
-{
-
-std::shared_ptr<SceneMaterial> SceneMaterial::Create()
-{
-    auto material = SceneMaterialPtr(new SceneMaterial);
-    material->shader = ShaderManager::Instance().getDefault();
-    return material;
-}
-
+#include "SceneMaterial.h"
+#include "ShaderManager.h"
+
+namespace hierarchy
+{
+
+std::shared_ptr<SceneMaterial> SceneMaterial::Create()
+{
+    auto material = SceneMaterialPtr(new SceneMaterial);
+    material->shader(ShaderManager::Instance().getDefault());
+    return material;
+}
+
 } // namespace hierarchy
\ No newline at end of file
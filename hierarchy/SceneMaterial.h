@@ -1,32 +1,55 @@
-#pragma once
-#include <memory>
-#include <string>
-#include <stdint.h>
-#include "SceneImage.h"
-#include "ShaderWatcher.h"
-
-namespace hierarchy
-{
-
-enum class AlphaMode
-{
-    Opaque,
-    Mask,
-    Blend,
-};
-
-class SceneMaterial
-{
-
-public:
-    static std::shared_ptr<SceneMaterial> Create();
-
-    std::string name;
-    ShaderWatcherPtr shader;
-    AlphaMode alphaMode{};
-    float alphaCutoff = 0;
-    SceneImagePtr colorImage;
-};
-using SceneMaterialPtr = std::shared_ptr<SceneMaterial>;
-
-} // namespace hierarchy
+#pragma once
+#include <memory>
+#include <string>
+#include <stdint.h>
+#include "SceneImage.h"
+#include "ShaderWatcher.h"
+
+namespace hierarchy
+{
+
+enum class AlphaMode
+{
+    Opaque,
+    Mask,
+    Blend,
+};
+
+class SceneMaterial
+{
+    ShaderWatcherPtr m_shader;
+    AlphaMode m_alphaMode{};
+    SceneImagePtr m_colorImage;
+
+    // retained DrawList. shader, alphaMode or colorImage changed
+    int m_version = 0;
+
+public:
+    static std::shared_ptr<SceneMaterial> Create();
+
+    std::string name;
+    float alphaCutoff = 0;
+
+    const ShaderWatcherPtr &shader() const { return m_shader; }
+    void shader(const ShaderWatcherPtr &shader)
+    {
+        m_shader = shader;
+        ++m_version;
+    }
+    AlphaMode alphaMode() const { return m_alphaMode; }
+    void alphaMode(AlphaMode alphaMode)
+    {
+        m_alphaMode = alphaMode;
+        ++m_version;
+    }
+    const SceneImagePtr &colorImage() const { return m_colorImage; }
+    void colorImage(const SceneImagePtr &colorImage)
+    {
+        m_colorImage = colorImage;
+        ++m_version;
+    }
+    int Version() const { return m_version; }
+};
+using SceneMaterialPtr = std::shared_ptr<SceneMaterial>;
+
+} // namespace hierarchy
@@ -1,90 +1,480 @@
-#include "SceneView.h"
-#include "Scene.h"
-#include "SceneMeshSkin.h"
-#include "VertexBuffer.h"
-#include "SceneMaterial.h"
-#include "Shader.h"
-#include <functional>
-
-namespace hierarchy
-{
-using FilterFunc = std::function<bool(const SceneMaterialPtr &)>;
-
-void TraverseMesh(DrawList *drawlist, const std::shared_ptr<SceneNode> &node, const FilterFunc &filter)
-{
-    auto mesh = node->Mesh();
-    if (mesh)
-    {
-
-        auto &submeshes = mesh->submeshes;
-        for (int i = 0; i < (int)submeshes.size(); ++i)
-        {
-            auto &material = submeshes[i].material;
-            if (filter(material))
-            {
-                auto shader = material->shader->Compiled();
-                if (shader)
-                {
-                    auto m = node->World().RowMatrix();
-                    CBValue values[] = {
-                        {.semantic = ConstantSemantics::NODE_WORLD,
-                         .p = &m,
-                         .size = sizeof(m)}};
-                    drawlist->PushCB(shader->VS.DrawCB(), values, _countof(values));
-                    drawlist->Items.push_back({
-                        .Mesh = mesh,
-                        .SubmeshIndex = i,
-                    });
-                }
-            }
-        }
-    }
-
-    int count;
-    auto child = node->GetChildren(&count);
-    for (int i = 0; i < count; ++i, ++child)
-    {
-        TraverseMesh(drawlist, *child, filter);
-    }
-}
-
-static void UpdateDrawListIf(SceneView *view, const Scene *scene, const FilterFunc &filter)
-{
-    if (view->ShowGrid)
-    {
-        for (auto &node : scene->gizmoNodes)
-        {
-            TraverseMesh(&view->Drawlist, node, filter);
-        }
-    }
-    if (view->ShowVR)
-    {
-        for (auto &node : scene->vrNodes)
-        {
-            TraverseMesh(&view->Drawlist, node, filter);
-        }
-    }
-    for (auto &node : scene->sceneNodes)
-    {
-        TraverseMesh(&view->Drawlist, node, filter);
-    }
-}
-
-void SceneView::UpdateDrawList(const Scene *scene)
-{
-    Drawlist.Clear();
-
-    //
-    // mesh
-    //
-    // Opaque
-    UpdateDrawListIf(this, scene, [](const SceneMaterialPtr &m) {
-        return m->alphaMode != AlphaMode::Blend;
-    });
-    // AlphaBlend
-    UpdateDrawListIf(this, scene, [](const SceneMaterialPtr &m) {
-        return m->alphaMode == AlphaMode::Blend;
-    });
-}
-
-} // namespace hierarchy
\ No newline at end of file
+#include "SceneView.h"
+#include "Scene.h"
+#include "SceneMeshSkin.h"
+#include "VertexBuffer.h"
+#include "SceneMaterial.h"
+#include "Shader.h"
+#include "ShaderWatcher.h"
+#include "WorkerPool.h"
+#include "FrameArena.h"
+#include "frame_metrics.h"
+#include <algorithm>
+#include <iterator>
+
+// split subtree until tasks >= workers * TASKS_PER_WORKER
+const int TASKS_PER_WORKER = 4;
+const int SPLIT_DEPTH_MAX = 8;
+
+namespace hierarchy
+{
+
+static void PushShader(DrawListChunk *chunk, const ShaderWatcher *shader, int generation)
+{
+    for (auto &[s, generation] : chunk->Shaders)
+    {
+        if (s == shader)
+        {
+            return;
+        }
+    }
+    chunk->Shaders.push_back({shader, generation});
+}
+
+static void PushMaterial(DrawListChunk *chunk, const SceneMaterial *material, int version)
+{
+    for (auto &[m, version] : chunk->Materials)
+    {
+        if (m == material)
+        {
+            return;
+        }
+    }
+    chunk->Materials.push_back({material, version});
+}
+
+static void PushMesh(DrawListChunk *chunk, SceneNode *node)
+{
+    auto &mesh = node->Mesh();
+    if (!mesh)
+    {
+        return;
+    }
+
+    auto &submeshes = mesh->submeshes;
+    for (int i = 0; i < (int)submeshes.size(); ++i)
+    {
+        auto &material = submeshes[i].material;
+        PushMaterial(chunk, material.get(), material->Version());
+        auto shader = material->shader()->Compiled();
+        if (!shader)
+        {
+            // compiling. rebuild when compiled
+            PushShader(chunk, material->shader().get(), -1);
+            continue;
+        }
+        PushShader(chunk, material->shader().get(), shader->Generation());
+
+        // AlphaMode::Blend draws after Opaque and Mask
+        auto drawlist = material->alphaMode() == AlphaMode::Blend ? &chunk->Blend : &chunk->Opaque;
+        auto m = node->World().RowMatrix();
+        CBValue values[] = {
+            {.semantic = ConstantSemantics::NODE_WORLD,
+             .p = &m,
+             .size = sizeof(m)}};
+        drawlist->PushCB(shader->VS.DrawCB(), values, (int)std::size(values));
+        drawlist->Items.push_back({
+            .Mesh = mesh,
+            .SubmeshIndex = i,
+        });
+        if (shader->HasInstanceWorld())
+        {
+            drawlist->PushInstance(m);
+        }
+        drawlist->PushWorldPatch(node, shader->VS.DrawCB());
+    }
+}
+
+static void TraverseMesh(DrawListChunk *chunk, SceneNode *node)
+{
+    PushMesh(chunk, node);
+
+    int count;
+    auto child = node->GetChildren(&count);
+    for (int i = 0; i < count; ++i, ++child)
+    {
+        TraverseMesh(chunk, child->get());
+    }
+}
+
+// pre-order same as TraverseMesh. concatenated chunks equal to serial traversal
+static void SplitTasks(std::vector<DrawListTask> *tasks, SceneNode *node, int depth, int segment)
+{
+    int count;
+    auto child = node->GetChildren(&count);
+    if (depth <= 0 || count == 0)
+    {
+        tasks->push_back({node, true, segment});
+        return;
+    }
+
+    tasks->push_back({node, false, segment});
+    for (int i = 0; i < count; ++i, ++child)
+    {
+        SplitTasks(tasks, child->get(), depth - 1, segment);
+    }
+}
+
+static void SplitTasks(SceneView *view, const FrameVector<int> &dirty, int depth)
+{
+    view->DrawListTasks.clear();
+    for (auto i : dirty)
+    {
+        SplitTasks(&view->DrawListTasks, view->DrawListSegments[i].Root.get(), depth, i);
+    }
+}
+
+static void PushRoots(FrameVector<SceneNode *> *roots, const std::vector<SceneNodePtr> &nodes)
+{
+    for (auto &node : nodes)
+    {
+        roots->push_back(node.get());
+    }
+}
+
+// segments follow root nodes. keep built segment of same root
+static bool SyncSegments(SceneView *view, const Scene *scene)
+{
+    FrameVector<SceneNode *> roots;
+    roots.reserve(scene->gizmoNodes.size() + scene->vrNodes.size() + scene->sceneNodes.size());
+    if (view->ShowGrid)
+    {
+        PushRoots(&roots, scene->gizmoNodes);
+    }
+    if (view->ShowVR)
+    {
+        PushRoots(&roots, scene->vrNodes);
+    }
+    PushRoots(&roots, scene->sceneNodes);
+
+    auto &current = view->DrawListSegments;
+    if (std::equal(roots.begin(), roots.end(), current.begin(), current.end(),
+                   [](const SceneNode *root, const DrawListSegment &segment) {
+                       return root == segment.Root.get();
+                   }))
+    {
+        return false;
+    }
+
+    std::vector<DrawListSegment> segments(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i)
+    {
+        auto found = std::find_if(current.begin(), current.end(), [root = roots[i]](const DrawListSegment &segment) {
+            return segment.Root.get() == root;
+        });
+        if (found != current.end())
+        {
+            segments[i] = std::move(*found);
+        }
+        else
+        {
+            segments[i].Root = roots[i]->shared_from_this();
+        }
+    }
+    current = std::move(segments);
+    return true;
+}
+
+static bool IsDirty(const DrawListSegment &segment)
+{
+    if (segment.StructureVersion != segment.Root->StructureVersion())
+    {
+        return true;
+    }
+    for (auto &[shader, generation] : segment.Chunk.Shaders)
+    {
+        auto compiled = shader->Compiled();
+        if ((compiled ? compiled->Generation() : -1) != generation)
+        {
+            // recompiled. CB layout may be changed
+            return true;
+        }
+    }
+    for (auto &[material, version] : segment.Chunk.Materials)
+    {
+        if (material->Version() != version)
+        {
+            // shader, alphaMode or colorImage
+            return true;
+        }
+    }
+    return false;
+}
+
+static void BuildSegments(SceneView *view, const FrameVector<int> &dirty)
+{
+    //
+    // tasks
+    //
+    auto &pool = WorkerPool::Instance();
+    auto parallel = view->ParallelDrawList && pool.ThreadCount() > 0;
+    if (parallel)
+    {
+        size_t target = (pool.ThreadCount() + 1) * TASKS_PER_WORKER;
+        for (int depth = 1; depth <= SPLIT_DEPTH_MAX; ++depth)
+        {
+            SplitTasks(view, dirty, depth);
+            if (view->DrawListTasks.size() >= target)
+            {
+                break;
+            }
+        }
+
+        // small scene is faster on this thread
+        int heavy = 0;
+        for (auto &task : view->DrawListTasks)
+        {
+            if (!task.Recursive)
+            {
+                continue;
+            }
+            int count;
+            task.Node->GetChildren(&count);
+            if (count > 0)
+            {
+                ++heavy;
+            }
+        }
+        if (heavy < 2)
+        {
+            parallel = false;
+        }
+    }
+    else
+    {
+        SplitTasks(view, dirty, 0);
+    }
+
+    //
+    // traverse each task to chunk
+    //
+    auto taskCount = (int)view->DrawListTasks.size();
+    if (view->DrawListChunks.size() < view->DrawListTasks.size())
+    {
+        view->DrawListChunks.resize(view->DrawListTasks.size());
+    }
+    auto run = [view](int i) {
+        frame_metrics::scoped s("task");
+        auto &task = view->DrawListTasks[i];
+        auto chunk = &view->DrawListChunks[i];
+        chunk->Opaque.Clear();
+        chunk->Blend.Clear();
+        chunk->Shaders.clear();
+        chunk->Materials.clear();
+        if (task.Recursive)
+        {
+            TraverseMesh(chunk, task.Node);
+        }
+        else
+        {
+            PushMesh(chunk, task.Node);
+        }
+    };
+    if (parallel)
+    {
+        pool.ParallelFor(taskCount, run);
+    }
+    else
+    {
+        for (int i = 0; i < taskCount; ++i)
+        {
+            run(i);
+        }
+    }
+
+    //
+    // chunks to segment in task order
+    //
+    for (auto i : dirty)
+    {
+        auto &segment = view->DrawListSegments[i];
+        segment.StructureVersion = segment.Root->StructureVersion();
+        segment.Chunk.Opaque.Clear();
+        segment.Chunk.Blend.Clear();
+        segment.Chunk.Shaders.clear();
+        segment.Chunk.Materials.clear();
+    }
+    for (int i = 0; i < taskCount; ++i)
+    {
+        auto &src = view->DrawListChunks[i];
+        auto &dst = view->DrawListSegments[view->DrawListTasks[i].Segment].Chunk;
+        dst.Opaque.Append(src.Opaque);
+        dst.Blend.Append(src.Blend);
+        for (auto [shader, generation] : src.Shaders)
+        {
+            PushShader(&dst, shader, generation);
+        }
+        for (auto [material, version] : src.Materials)
+        {
+            PushMaterial(&dst, material, version);
+        }
+    }
+
+    for (auto i : dirty)
+    {
+        auto &chunk = view->DrawListSegments[i].Chunk;
+        // same mesh and material to one DrawIndexedInstanced. Blend keeps back to front order
+        chunk.Opaque.MergeInstances();
+        chunk.Opaque.SortWorldPatches();
+        chunk.Blend.SortWorldPatches();
+    }
+}
+
+static void Advance(DrawList::Mark *mark, const DrawList::Mark &size)
+{
+    mark->CB += size.CB;
+    mark->CBRanges += size.CBRanges;
+    mark->Instances += size.Instances;
+    mark->Items += size.Items;
+    mark->WorldPatches += size.WorldPatches;
+}
+
+// Drawlist position of each segment. Opaque of all segments, then Blend
+static void GetBases(const SceneView *view, FrameVector<DrawList::Mark> *opaque, FrameVector<DrawList::Mark> *blend)
+{
+    auto &segments = view->DrawListSegments;
+    opaque->resize(segments.size());
+    blend->resize(segments.size());
+    DrawList::Mark base{};
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        (*opaque)[i] = base;
+        Advance(&base, segments[i].OpaqueSize);
+    }
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        (*blend)[i] = base;
+        Advance(&base, segments[i].BlendSize);
+    }
+}
+
+// Drawlist from all segments. retained segments are patched
+static void Assemble(SceneView *view, const FrameVector<bool> &built)
+{
+    auto &drawlist = view->Drawlist;
+    drawlist.Clear();
+    for (auto &segment : view->DrawListSegments)
+    {
+        segment.OpaqueSize = segment.Chunk.Opaque.GetMark();
+        drawlist.Append(segment.Chunk.Opaque);
+    }
+    for (auto &segment : view->DrawListSegments)
+    {
+        segment.BlendSize = segment.Chunk.Blend.GetMark();
+        drawlist.Append(segment.Chunk.Blend);
+    }
+    // kept by segments
+    drawlist.WorldPatches.clear();
+
+    FrameVector<DrawList::Mark> opaque;
+    FrameVector<DrawList::Mark> blend;
+    GetBases(view, &opaque, &blend);
+    for (size_t i = 0; i < view->DrawListSegments.size(); ++i)
+    {
+        if (!built[i])
+        {
+            // old world
+            auto &chunk = view->DrawListSegments[i].Chunk;
+            chunk.Opaque.PatchAllWorlds(&drawlist, opaque[i]);
+            chunk.Blend.PatchAllWorlds(&drawlist, blend[i]);
+        }
+    }
+}
+
+// replace Opaque and Blend of the segment. the following segments are moved
+static void Splice(SceneView *view, int i)
+{
+    auto &segment = view->DrawListSegments[i];
+    FrameVector<DrawList::Mark> opaque;
+    FrameVector<DrawList::Mark> blend;
+    GetBases(view, &opaque, &blend);
+    view->Drawlist.Splice(opaque[i], segment.OpaqueSize, segment.Chunk.Opaque);
+    segment.OpaqueSize = segment.Chunk.Opaque.GetMark();
+
+    // Blend after the new Opaque
+    GetBases(view, &opaque, &blend);
+    view->Drawlist.Splice(blend[i], segment.BlendSize, segment.Chunk.Blend);
+    segment.BlendSize = segment.Chunk.Blend.GetMark();
+}
+
+// write world of moved nodes in retained segments
+static void PatchWorlds(SceneView *view, const std::vector<SceneNode *> &nodes, const FrameVector<bool> &built)
+{
+    if (nodes.empty())
+    {
+        return;
+    }
+    auto &segments = view->DrawListSegments;
+    FrameHashMap<const SceneNode *, int> segmentMap;
+    for (int i = 0; i < (int)segments.size(); ++i)
+    {
+        segmentMap.insert(std::make_pair(segments[i].Root.get(), i));
+    }
+    FrameVector<DrawList::Mark> opaque;
+    FrameVector<DrawList::Mark> blend;
+    GetBases(view, &opaque, &blend);
+
+    for (auto node : nodes)
+    {
+        auto root = node;
+        for (auto parent = node->Parent(); parent; parent = parent->Parent())
+        {
+            root = parent.get();
+        }
+        auto found = segmentMap.find(root);
+        if (found == segmentMap.end() || built[found->second])
+        {
+            // not drawn or built with this world
+            continue;
+        }
+        auto i = found->second;
+        segments[i].Chunk.Opaque.PatchWorld(node, &view->Drawlist, opaque[i]);
+        segments[i].Chunk.Blend.PatchWorld(node, &view->Drawlist, blend[i]);
+    }
+}
+
+void SceneView::UpdateDrawList(const Scene *scene)
+{
+    frame_metrics::scoped s("drawlist");
+
+    auto rootChanged = SyncSegments(this, scene);
+    FrameVector<int> dirty;
+    for (int i = 0; i < (int)DrawListSegments.size(); ++i)
+    {
+        if (!RetainDrawList || IsDirty(DrawListSegments[i]))
+        {
+            dirty.push_back(i);
+        }
+    }
+
+    // items pushed after UpdateDrawList(gizmo)
+    Drawlist.Rewind(DrawlistRetained);
+
+    FrameVector<bool> built(DrawListSegments.size());
+    if (!dirty.empty())
+    {
+        BuildSegments(this, dirty);
+        for (auto i : dirty)
+        {
+            built[i] = true;
+        }
+    }
+
+    //
+    // segment order. Opaque then AlphaBlend
+    //
+    if (rootChanged || dirty.size() == DrawListSegments.size())
+    {
+        Assemble(this, built);
+    }
+    else
+    {
+        for (auto i : dirty)
+        {
+            Splice(this, i);
+        }
+        PatchWorlds(this, scene->changedNodes, built);
+    }
+    DrawlistRetained = Drawlist.GetMark();
+}
+
+} // namespace hierarchy
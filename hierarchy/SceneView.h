@@ -1,29 +1,78 @@
-#pragma once
-#include <memory>
-#include <array>
-#include "DrawList.h"
-
-namespace hierarchy
-{
-
-struct SceneView
-{
-    int Width = 0;
-    int Height = 0;
-    std::array<float, 16> Projection = {};
-    std::array<float, 16> View = {};
-    std::array<float, 3> CameraPosition = {0, 0, 0};
-    float CameraFovYRadians = 1.0f;
-
-    std::array<float, 4> ClearColor = {0, 0, 0, 1};
-    bool ShowGrid = true;
-    bool ShowGizmo = true;
-    bool ShowVR = false;
-
-    hierarchy::DrawList Drawlist;
-
-    void UpdateDrawList(const class Scene *scene);
-};
-using SceneViewPtr = std::shared_ptr<SceneView>;
-
-} // namespace hierarchy
+#pragma once
+#include <memory>
+#include <array>
+#include <vector>
+#include "DrawList.h"
+
+namespace hierarchy
+{
+
+// UpdateDrawList work unit
+struct DrawListTask
+{
+    class SceneNode *Node;
+    // false: Node only. children are other tasks
+    bool Recursive;
+    // DrawListSegments index
+    int Segment;
+};
+
+// UpdateDrawList result of each DrawListTask
+struct DrawListChunk
+{
+    DrawList Opaque;
+    DrawList Blend;
+    // shader and generation when built. compiled Shader is replaced by the watcher
+    std::vector<std::pair<const class ShaderWatcher *, int>> Shaders;
+    // material and SceneMaterial::Version() when built
+    std::vector<std::pair<const class SceneMaterial *, int>> Materials;
+};
+
+// retained draw items of a root node
+struct DrawListSegment
+{
+    std::shared_ptr<class SceneNode> Root;
+    // Root->StructureVersion() when built. -1 is not built
+    int StructureVersion = -1;
+    // Opaque is merged. WorldPatches are sorted. worlds are not patched after build
+    DrawListChunk Chunk;
+    // size of Opaque and Blend in SceneView::Drawlist. old size until spliced
+    DrawList::Mark OpaqueSize;
+    DrawList::Mark BlendSize;
+};
+
+struct SceneView
+{
+    int Width = 0;
+    int Height = 0;
+    std::array<float, 16> Projection = {};
+    std::array<float, 16> View = {};
+    std::array<float, 3> CameraPosition = {0, 0, 0};
+    float CameraFovYRadians = 1.0f;
+
+    std::array<float, 4> ClearColor = {0, 0, 0, 1};
+    bool ShowGrid = true;
+    bool ShowGizmo = true;
+    bool ShowVR = false;
+    // request DrawListCapture::Save of next frame
+    bool CaptureDrawList = false;
+
+    // build subtrees on WorkerPool
+    bool ParallelDrawList = true;
+    // keep Drawlist between frames. splice only changed root and patch world
+    bool RetainDrawList = true;
+
+    hierarchy::DrawList Drawlist;
+    // Drawlist without items pushed after UpdateDrawList(gizmo)
+    DrawList::Mark DrawlistRetained;
+
+    // keep capacity between frames
+    std::vector<DrawListTask> DrawListTasks;
+    std::vector<DrawListChunk> DrawListChunks;
+    std::vector<DrawListSegment> DrawListSegments;
+
+    void UpdateDrawList(const class Scene *scene);
+};
+using SceneViewPtr = std::shared_ptr<SceneView>;
+
+} // namespace hierarchy
@@ -1,84 +1,78 @@
-#pragma once
-#include <wrl/client.h>
-#include <d3d12.h>
-#include <d3dcompiler.h>
-#include <string>
-#include <vector>
-#include <memory>
-#include "ShaderConstantVariable.h"
-
-namespace hierarchy
-{
-
-class Shader
-{
-    template <typename T>
-    using ComPtr = Microsoft::WRL::ComPtr<T>;
-
-    Shader(const Shader &) = delete;
-    Shader &operator=(const Shader &) = delete;
-
-private:
-    std::string m_name;
-    int m_generation = -1;
-
-    // keep semantics string
-    std::vector<std::string> m_semantics;
-    std::vector<D3D12_INPUT_ELEMENT_DESC> m_layout;
-    bool InputLayoutFromReflection(const ComPtr<ID3D12ShaderReflection> &reflection);
-
-public:
-    struct ShaderWithConstants
-    {
-        ComPtr<ID3DBlob> Compiled;
-
-    private:
-        std::vector<ConstantBuffer> Buffers;
-
-    public:
-        const ConstantBuffer *DrawCB() const
-        {
-            for (auto &b : Buffers)
-            {
-                if (b.reg == 1)
-                {
-                    return &b;
-                }
-            }
-            return nullptr;
-        }
-
-        D3D12_SHADER_BYTECODE ByteCode() const
-        {
-            return {
-                Compiled->GetBufferPointer(),
-                Compiled->GetBufferSize(),
-            };
-        }
-
-        void ShaderWithConstants::GetConstants(const ComPtr<ID3D12ShaderReflection> &pReflection,
-                                               const std::string &source);
-    };
-
-public:
-    ShaderWithConstants VS;
-    ShaderWithConstants PS;
-
-    Shader(const std::string &name)
-        : m_name(name)
-    {
-    }
-
-    int Generation() const { return m_generation; }
-
-    const D3D12_INPUT_ELEMENT_DESC *inputLayout(int *count) const
-    {
-        *count = (int)m_layout.size();
-        return m_layout.data();
-    }
-    bool Initialize(const ComPtr<ID3D12Device> &device,
-                    const std::string &source, int generation);
-};
-using ShaderPtr = std::shared_ptr<Shader>;
-
-} // namespace hierarchy
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include "ShaderCompiler.h"
+
+namespace hierarchy
+{
+
+///
+/// immutable after Initialize. ShaderWatcher swaps in a new Shader for each generation
+///
+class Shader
+{
+    Shader(const Shader &) = delete;
+    Shader &operator=(const Shader &) = delete;
+
+private:
+    std::string m_name;
+    int m_generation = -1;
+
+    // owns bytecode and semantics string
+    std::shared_ptr<const ShaderBinary> m_binary;
+    // float4x4 world : INSTANCE_WORLD. vertex stream slot 1
+    bool m_instanceWorld = false;
+
+public:
+    struct ShaderWithConstants
+    {
+        friend class Shader;
+
+    private:
+        const std::vector<uint8_t> *Compiled = nullptr;
+        const std::vector<ConstantBuffer> *Buffers = nullptr;
+
+    public:
+        const ConstantBuffer *DrawCB() const
+        {
+            if (!Buffers)
+            {
+                return nullptr;
+            }
+            for (auto &b : *Buffers)
+            {
+                if (b.reg == 1)
+                {
+                    return &b;
+                }
+            }
+            return nullptr;
+        }
+
+        const std::vector<uint8_t> &ByteCode() const
+        {
+            return *Compiled;
+        }
+    };
+
+public:
+    ShaderWithConstants VS;
+    ShaderWithConstants PS;
+
+    Shader(const std::string &name)
+        : m_name(name)
+    {
+    }
+
+    int Generation() const { return m_generation; }
+    const std::shared_ptr<const ShaderBinary> &Binary() const { return m_binary; }
+    bool HasInstanceWorld() const { return m_instanceWorld; }
+
+    // VS inputs. PerInstance is slot 1, others are slot 0 in order
+    const std::vector<ShaderInput> &Inputs() const { return m_binary->Inputs; }
+    void Initialize(const std::shared_ptr<const ShaderBinary> &binary, int generation);
+};
+using ShaderPtr = std::shared_ptr<Shader>;
+
+} // namespace hierarchy
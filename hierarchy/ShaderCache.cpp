@@ -0,0 +1,319 @@
+#include "ShaderCache.h"
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
+
+namespace hierarchy
+{
+
+// bump if ShaderBinary layout or semantic parsing is changed
+static const uint32_t SHADER_CACHE_MAGIC = 0x32484353; // SCH2
+
+class BinaryWriter
+{
+    std::vector<uint8_t> &m_bytes;
+
+public:
+    BinaryWriter(std::vector<uint8_t> &bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    void Write(const T &value)
+    {
+        auto p = (const uint8_t *)&value;
+        m_bytes.insert(m_bytes.end(), p, p + sizeof(T));
+    }
+
+    void WriteBytes(const void *p, uint32_t size)
+    {
+        Write(size);
+        m_bytes.insert(m_bytes.end(), (const uint8_t *)p, (const uint8_t *)p + size);
+    }
+
+    void WriteString(const std::string &src)
+    {
+        WriteBytes(src.data(), (uint32_t)src.size());
+    }
+
+    void WriteConstants(const std::vector<ConstantBuffer> &buffers)
+    {
+        Write((uint32_t)buffers.size());
+        for (auto &buffer : buffers)
+        {
+            Write(buffer.reg);
+            Write((uint32_t)buffer.Variables.size());
+            for (auto &variable : buffer.Variables)
+            {
+                WriteString(variable.Name);
+                Write((uint32_t)variable.Semantic);
+                Write(variable.Offset);
+                Write(variable.Size);
+            }
+        }
+    }
+};
+
+class BinaryReader
+{
+    const uint8_t *m_p;
+    const uint8_t *m_end;
+
+public:
+    BinaryReader(const std::vector<uint8_t> &bytes)
+        : m_p(bytes.data()), m_end(bytes.data() + bytes.size())
+    {
+    }
+
+    const uint8_t *Skip(uint32_t size)
+    {
+        if (size > (uint32_t)(m_end - m_p))
+        {
+            throw "shader cache: unexpected end";
+        }
+        auto p = m_p;
+        m_p += size;
+        return p;
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T value;
+        memcpy(&value, Skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // count of elements at least minSize bytes each. before resize
+    uint32_t ReadCount(uint32_t minSize)
+    {
+        auto count = Read<uint32_t>();
+        if (count > (uint32_t)(m_end - m_p) / minSize)
+        {
+            throw "shader cache: invalid count";
+        }
+        return count;
+    }
+
+    void ReadBytes(std::vector<uint8_t> *values)
+    {
+        auto size = Read<uint32_t>();
+        auto p = Skip(size);
+        values->assign(p, p + size);
+    }
+
+    std::string ReadString()
+    {
+        auto size = Read<uint32_t>();
+        auto p = Skip(size);
+        return std::string((const char *)p, (const char *)p + size);
+    }
+
+    void ReadConstants(std::vector<ConstantBuffer> *buffers)
+    {
+        // reg, variable count
+        buffers->resize(ReadCount(8));
+        for (auto &buffer : *buffers)
+        {
+            buffer.reg = Read<uint32_t>();
+            // name size, semantic, offset, size
+            buffer.Variables.resize(ReadCount(16));
+            for (auto &variable : buffer.Variables)
+            {
+                variable.Name = ReadString();
+                variable.Semantic = (ConstantSemantics)Read<uint32_t>();
+                variable.Offset = Read<uint32_t>();
+                variable.Size = Read<uint32_t>();
+            }
+        }
+    }
+};
+
+// FNV-1a. stable between runs
+static uint64_t Hash(const std::string &version, const std::string &preprocessed)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (auto &src : {version, preprocessed})
+    {
+        for (auto c : src)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3ull;
+        }
+        // separator
+        hash ^= 0xff;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+ShaderCache::ShaderCache(std::unique_ptr<ShaderCompiler> &&compiler, const std::filesystem::path &directory)
+    : m_compiler(std::move(compiler)), m_directory(directory)
+{
+}
+
+std::vector<uint8_t> ShaderCache::Serialize(const ShaderBinary &binary)
+{
+    std::vector<uint8_t> bytes;
+    BinaryWriter w(bytes);
+    w.Write(SHADER_CACHE_MAGIC);
+    w.WriteBytes(binary.VS.data(), (uint32_t)binary.VS.size());
+    w.WriteBytes(binary.PS.data(), (uint32_t)binary.PS.size());
+    w.Write((uint32_t)binary.Inputs.size());
+    for (auto &input : binary.Inputs)
+    {
+        w.WriteString(input.Semantic);
+        w.Write(input.SemanticIndex);
+        w.Write(input.Format);
+    }
+    w.WriteConstants(binary.VSConstants);
+    w.WriteConstants(binary.PSConstants);
+    return bytes;
+}
+
+bool ShaderCache::Deserialize(const std::vector<uint8_t> &bytes, ShaderBinary *binary)
+{
+    try
+    {
+        BinaryReader r(bytes);
+        if (r.Read<uint32_t>() != SHADER_CACHE_MAGIC)
+        {
+            return false;
+        }
+        r.ReadBytes(&binary->VS);
+        r.ReadBytes(&binary->PS);
+        // semantic size, index, format
+        binary->Inputs.resize(r.ReadCount(12));
+        for (auto &input : binary->Inputs)
+        {
+            input.Semantic = r.ReadString();
+            input.SemanticIndex = r.Read<uint32_t>();
+            input.Format = r.Read<uint32_t>();
+        }
+        r.ReadConstants(&binary->VSConstants);
+        r.ReadConstants(&binary->PSConstants);
+        return true;
+    }
+    catch (const char *)
+    {
+        // broken file
+        return false;
+    }
+}
+
+static std::filesystem::path CachePath(const std::filesystem::path &directory, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.shader", (unsigned long long)key);
+    return directory / name;
+}
+
+std::shared_ptr<const ShaderBinary> ShaderCache::Load(uint64_t key)
+{
+    if (m_directory.empty())
+    {
+        return nullptr;
+    }
+    std::ifstream ifs(CachePath(m_directory, key), std::ios::binary);
+    if (!ifs)
+    {
+        return nullptr;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    auto binary = std::make_shared<ShaderBinary>();
+    if (!Deserialize(bytes, binary.get()))
+    {
+        return nullptr;
+    }
+    return binary;
+}
+
+void ShaderCache::Store(uint64_t key, const ShaderBinary &binary)
+{
+    if (m_directory.empty())
+    {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+
+    // other process may read. rename after write
+    auto path = CachePath(m_directory, key);
+    // workers may store the same key at once
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%llu.tmp", (unsigned long long)++m_tmpCount);
+    auto tmp = path;
+    tmp += suffix;
+    {
+        auto bytes = Serialize(binary);
+        std::ofstream ofs(tmp, std::ios::binary);
+        if (!ofs)
+        {
+            return;
+        }
+        ofs.write((const char *)bytes.data(), bytes.size());
+    }
+    std::filesystem::rename(tmp, path, ec);
+}
+
+std::shared_ptr<const ShaderBinary> ShaderCache::GetOrCompile(const std::string &name, const std::string &source,
+                                                              const ShaderIncludeFunc &include, std::string *error)
+{
+    std::string preprocessed;
+    if (!m_compiler->Preprocess(name, source, include, &preprocessed, error))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.Requests;
+        ++m_stats.Failures;
+        return nullptr;
+    }
+    auto key = Hash(m_compiler->Version(), preprocessed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.Requests;
+        auto found = m_binaryMap.find(key);
+        if (found != m_binaryMap.end())
+        {
+            ++m_stats.MemoryHits;
+            return found->second;
+        }
+    }
+
+    // out of lock
+    auto binary = Load(key);
+    bool compiled = false;
+    if (!binary)
+    {
+        auto compiling = std::make_shared<ShaderBinary>();
+        if (!m_compiler->Compile(name, preprocessed, compiling.get(), error))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.Failures;
+            return nullptr;
+        }
+        Store(key, *compiling);
+        binary = compiling;
+        compiled = true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (compiled)
+    {
+        ++m_stats.Compiles;
+    }
+    else
+    {
+        ++m_stats.DiskHits;
+    }
+    return m_binaryMap.insert(std::make_pair(key, binary)).first->second;
+}
+
+ShaderCache::Stats ShaderCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace hierarchy
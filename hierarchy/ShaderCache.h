@@ -0,0 +1,60 @@
+#pragma once
+#include "ShaderCompiler.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <filesystem>
+
+namespace hierarchy
+{
+
+///
+/// ShaderBinary keyed by hash of compiler version and preprocessed source. no d3d12
+///
+/// * memory, then {directory}/{key}.shader, then ShaderCompiler::Compile
+/// * thread safe. called from WorkerPool
+///
+class ShaderCache
+{
+public:
+    struct Stats
+    {
+        uint64_t Requests = 0;
+        uint64_t MemoryHits = 0;
+        uint64_t DiskHits = 0;
+        uint64_t Compiles = 0;
+        uint64_t Failures = 0;
+    };
+
+private:
+    std::unique_ptr<ShaderCompiler> m_compiler;
+    // empty is memory only
+    std::filesystem::path m_directory;
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const ShaderBinary>> m_binaryMap;
+    Stats m_stats;
+    // unique tmp file of Store
+    std::atomic<uint64_t> m_tmpCount = 0;
+
+    // avoid copy
+    ShaderCache(const ShaderCache &) = delete;
+    ShaderCache &operator=(const ShaderCache &) = delete;
+
+    std::shared_ptr<const ShaderBinary> Load(uint64_t key);
+    void Store(uint64_t key, const ShaderBinary &binary);
+
+public:
+    ShaderCache(std::unique_ptr<ShaderCompiler> &&compiler, const std::filesystem::path &directory);
+
+    // nullptr and error if failed. same binary for same preprocessed source
+    std::shared_ptr<const ShaderBinary> GetOrCompile(const std::string &name, const std::string &source,
+                                                     const ShaderIncludeFunc &include, std::string *error);
+    Stats GetStats();
+
+    static std::vector<uint8_t> Serialize(const ShaderBinary &binary);
+    static bool Deserialize(const std::vector<uint8_t> &bytes, ShaderBinary *binary);
+};
+
+} // namespace hierarchy
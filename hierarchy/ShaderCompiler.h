@@ -0,0 +1,52 @@
+#pragma once
+#include "ShaderConstantVariable.h"
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+// vertex input from VS reflection
+struct ShaderInput
+{
+    std::string Semantic;
+    uint32_t SemanticIndex = 0;
+    // DXGI_FORMAT
+    uint32_t Format = 0;
+
+    // float4x4 world : INSTANCE_WORLD. per instance matrix rows
+    bool PerInstance() const { return Semantic == "INSTANCE_WORLD"; }
+};
+
+// compiled VS/PS and reflection. no d3d12
+struct ShaderBinary
+{
+    std::vector<uint8_t> VS;
+    std::vector<uint8_t> PS;
+    std::vector<ShaderInput> Inputs;
+    std::vector<ConstantBuffer> VSConstants;
+    std::vector<ConstantBuffer> PSConstants;
+};
+
+// #include "path". relative to the shader directory. false if not found
+using ShaderIncludeFunc = std::function<bool(const std::string &path, std::string *source)>;
+
+///
+/// compiler of ShaderCache. D3DShaderCompiler or stub
+///
+class ShaderCompiler
+{
+public:
+    virtual ~ShaderCompiler() = default;
+    // part of cache key. compiler, targets and flags
+    virtual std::string Version() const = 0;
+    // expand includes and macros. include may be empty
+    virtual bool Preprocess(const std::string &name, const std::string &source, const ShaderIncludeFunc &include,
+                            std::string *preprocessed, std::string *error) = 0;
+    virtual bool Compile(const std::string &name, const std::string &preprocessed,
+                         ShaderBinary *binary, std::string *error) = 0;
+};
+
+} // namespace hierarchy
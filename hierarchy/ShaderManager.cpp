@@ -1,241 +1,238 @@
-#include "ShaderManager.h"
-#include <thread>
-#include <functional>
-#include <fstream>
-#include <windows.h>
-
-namespace hierarchy
-{
-
-static std::string ReadAllText(const std::filesystem::path &path)
-{
-    std::string result;
-    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
-    if (ifs)
-    {
-        auto pos = ifs.tellg();
-        result.resize(pos);
-        ifs.seekg(0, std::ios::beg);
-        ifs.read((char *)result.data(), pos);
-    }
-    return result;
-}
-
-static std::wstring multi_to_wide_winapi(std::string const &src)
-{
-    auto const dest_size = ::MultiByteToWideChar(CP_ACP, 0U, src.data(), -1, nullptr, 0U);
-    std::vector<wchar_t> dest(dest_size, L'\0');
-    if (::MultiByteToWideChar(CP_ACP, 0U, src.data(), -1, dest.data(), (int)dest.size()) == 0)
-    {
-        throw std::system_error{static_cast<int>(::GetLastError()), std::system_category()};
-    }
-    dest.resize(std::char_traits<wchar_t>::length(dest.data()));
-    dest.shrink_to_fit();
-    return std::wstring(dest.begin(), dest.end());
-}
-
-class DirectoryWatcher
-{
-    std::filesystem::path m_path;
-    HANDLE m_hDir = NULL;
-    std::thread m_thread;
-    using OnFileFunc = const std::function<void(const std::wstring &, int)>;
-    OnFileFunc m_onFile;
-    bool m_isEnd = false;
-
-public:
-    DirectoryWatcher(const std::filesystem::path &path, const OnFileFunc &callback)
-        : m_path(path), m_onFile(callback)
-    {
-        auto hDir = CreateFileW((LPCWSTR)path.u16string().c_str(),
-                                FILE_LIST_DIRECTORY,
-                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
-                                NULL,
-                                OPEN_EXISTING,
-                                FILE_FLAG_BACKUP_SEMANTICS,
-                                NULL);
-        if (hDir == INVALID_HANDLE_VALUE)
-        {
-            throw "CreateFile failed.";
-        }
-        m_hDir = hDir;
-
-        m_thread = std::thread(std::bind(&DirectoryWatcher::OnFile, this));
-    }
-
-    void OnFile()
-    {
-        while (true)
-        {
-            if (m_isEnd)
-            {
-                break;
-            }
-            uint8_t buffer[1024] = {};
-            DWORD dwBytesReturned;
-            auto bRet = ReadDirectoryChangesW(m_hDir,
-                                              buffer,
-                                              sizeof(buffer),
-                                              TRUE,
-                                              FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION | FILE_NOTIFY_CHANGE_SIZE,
-                                              &dwBytesReturned,
-                                              NULL,
-                                              NULL);
-            if (!bRet)
-            {
-                throw "ReadDirectoryChangesW failed.";
-            }
-
-            if (dwBytesReturned == 0)
-            {
-                throw;
-            }
-
-            FILE_NOTIFY_INFORMATION *p = nullptr;
-            for (DWORD i = 0; i < dwBytesReturned; i += p->NextEntryOffset)
-            {
-                p = (FILE_NOTIFY_INFORMATION *)&buffer[i];
-                m_onFile(std::wstring(p->FileName, p->FileName + p->FileNameLength / 2), p->Action);
-                // switch (p->Action)
-                // {
-                // case FILE_ACTION_ADDED:
-                //     // wprintf(L"FILE_ACTION_ADDED: %s\n", filename);
-                //     break;
-
-                // case FILE_ACTION_REMOVED:
-                //     // wprintf(L"FILE_ACTION_REMOVED: %s\n", filename);
-                //     break;
-
-                // case FILE_ACTION_MODIFIED:
-                //     // wprintf(L"FILE_ACTION_MODIFIED: %s\n", filename);
-                //     break;
-
-                // case FILE_ACTION_RENAMED_OLD_NAME:
-                //     // wprintf(L"FILE_ACTION_RENAMED_OLD_NAME: %s\n", filename);
-                //     break;
-
-                // case FILE_ACTION_RENAMED_NEW_NAME:
-                //     // wprintf(L"FILE_ACTION_RENAMED_NEW_NAME: %s\n", filename);
-                //     break;
-
-                // default:
-                //     // wprintf(L"Unknown File Action: %s\n", filename);
-                //     break;
-                // }
-
-                if (!p->NextEntryOffset)
-                {
-                    break;
-                }
-            }
-        }
-
-        auto a = 0;
-    }
-
-    ~DirectoryWatcher()
-    {
-        m_isEnd = true;
-
-        // create dummy file for ReadDirectoryChangesW blocking
-        {
-            auto path = m_path;
-            path.append("tmp.tmp");
-            auto hFile = CreateFileW((LPCWSTR)path.u16string().c_str(), // name of the write
-                                     GENERIC_WRITE,                     // open for writing
-                                     0,                                 // do not share
-                                     NULL,                              // default security
-                                     CREATE_NEW,                        // create new file only
-                                     FILE_ATTRIBUTE_NORMAL,             // normal file
-                                     NULL);                             // no attr. template
-            int a = 0;
-            DWORD write;
-            WriteFile(hFile, &a, 4, &write, NULL);
-            CloseHandle(hFile);
-            DeleteFileW((LPCWSTR)path.u16string().c_str());
-        }
-
-        m_thread.join();
-
-        if (m_hDir)
-        {
-            CloseHandle(m_hDir);
-            m_hDir = nullptr;
-        }
-    }
-
-    std::filesystem::path getPath(const std::wstring &shaderName) const
-    {
-        auto path = m_path;
-        return path.append(shaderName);
-    }
-
-}; // namespace hierarchy
-
-ShaderManager::ShaderManager()
-{
-}
-
-ShaderManager::~ShaderManager()
-{
-    stop();
-}
-
-ShaderManager &ShaderManager::Instance()
-{
-    static ShaderManager s_instance;
-    return s_instance;
-}
-
-void ShaderManager::watch(std::filesystem::path &path)
-{
-    stop();
-    m_watcher = new DirectoryWatcher(path, std::bind(&ShaderManager::onFile, this, std::placeholders::_1, std::placeholders::_2));
-}
-
-void ShaderManager::stop()
-{
-    if (m_watcher)
-    {
-        delete m_watcher;
-        m_watcher = nullptr;
-    }
-}
-
-// default
-ShaderWatcherPtr ShaderManager::get(const std::string &shaderName)
-{
-    auto fileName = multi_to_wide_winapi(shaderName + ".hlsl");
-    auto found = m_shaderMap.find(fileName);
-    if (found != m_shaderMap.end())
-    {
-        return found->second;
-    }
-
-    auto shader = std::make_shared<ShaderWatcher>(shaderName);
-    auto source = ReadAllText(m_watcher->getPath(fileName));
-    shader->source(source);
-
-    {
-        std::lock_guard<std::mutex> scoped(m_mutex);
-        m_shaderMap.insert(std::make_pair(fileName, shader));
-    }
-
-    return shader;
-}
-
-void ShaderManager::onFile(const std::wstring &fileName, int action)
-{
-    if (action == FILE_ACTION_MODIFIED)
-    {
-        std::lock_guard<std::mutex> scoped(m_mutex);
-        auto found = m_shaderMap.find(fileName);
-        if (found != m_shaderMap.end())
-        {
-            auto source = ReadAllText(m_watcher->getPath(fileName));
-            found->second->source(source);
-        }
-    }
-}
-
-} // namespace hierarchy
+#include "ShaderManager.h"
+#include "ShaderCache.h"
+#include "StubShaderCompiler.h"
+#include "DirectoryWatcher.h"
+#include <plog/Log.h>
+#include <functional>
+#include <fstream>
+
+namespace hierarchy
+{
+
+static std::string ReadAllText(const std::filesystem::path &path)
+{
+    std::string result;
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (ifs)
+    {
+        auto pos = ifs.tellg();
+        result.resize(pos);
+        ifs.seekg(0, std::ios::beg);
+        ifs.read((char *)result.data(), pos);
+    }
+    return result;
+}
+
+// FNV-1a
+static uint64_t Hash(const std::string &src)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (auto c : src)
+    {
+        hash ^= (uint8_t)c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+ShaderManager::ShaderManager()
+    : m_registry(std::make_shared<Registry>()),
+      m_cache(new ShaderCache(std::make_unique<StubShaderCompiler>(), std::filesystem::current_path() / "shader_cache"))
+{
+}
+
+ShaderManager::~ShaderManager()
+{
+    stop();
+}
+
+ShaderManager &ShaderManager::Instance()
+{
+    static ShaderManager s_instance;
+    return s_instance;
+}
+
+void ShaderManager::compiler(std::unique_ptr<ShaderCompiler> &&compiler)
+{
+    std::lock_guard<std::mutex> scoped(m_writeMutex);
+    if (!m_registry.load()->Shaders.empty())
+    {
+        throw "ShaderManager::compiler: shaders are already created";
+    }
+    m_cache.reset(new ShaderCache(std::move(compiler), std::filesystem::current_path() / "shader_cache"));
+}
+
+void ShaderManager::watch(std::filesystem::path &path)
+{
+    stop();
+    m_watcher = new DirectoryWatcher(path, std::bind(&ShaderManager::onFile, this, std::placeholders::_1));
+}
+
+void ShaderManager::stop()
+{
+    if (m_watcher)
+    {
+        delete m_watcher;
+        m_watcher = nullptr;
+    }
+}
+
+static ShaderKeywords FindKeyword(const std::vector<std::string> &keywords, const std::string &name)
+{
+    for (size_t i = 0; i < keywords.size(); ++i)
+    {
+        if (keywords[i] == name)
+        {
+            return 1u << i;
+        }
+    }
+    return 0;
+}
+
+ShaderKeywords ShaderManager::keyword(const std::string &name)
+{
+    if (auto bit = FindKeyword(m_registry.load()->Keywords, name))
+    {
+        return bit;
+    }
+
+    std::lock_guard<std::mutex> scoped(m_writeMutex);
+    auto current = m_registry.load();
+    if (auto bit = FindKeyword(current->Keywords, name))
+    {
+        // added by other thread
+        return bit;
+    }
+    if (current->Keywords.size() >= sizeof(ShaderKeywords) * 8)
+    {
+        throw "too many shader keywords";
+    }
+    auto registry = std::make_shared<Registry>(*current);
+    registry->Keywords.push_back(name);
+    m_registry.store(registry);
+    return 1u << (registry->Keywords.size() - 1);
+}
+
+ShaderWatcherPtr ShaderManager::get(const std::string &shaderName, ShaderKeywords keywords)
+{
+    auto fileName = std::filesystem::path(shaderName + ".hlsl").wstring();
+    auto find = [&fileName, keywords](const Registry &registry) -> ShaderWatcherPtr {
+        auto variants = registry.Shaders.find(fileName);
+        if (variants == registry.Shaders.end())
+        {
+            return nullptr;
+        }
+        auto found = variants->second.find(keywords);
+        return found != variants->second.end() ? found->second : nullptr;
+    };
+    if (auto shader = find(*m_registry.load()))
+    {
+        return shader;
+    }
+
+    ShaderWatcherPtr shader;
+    {
+        std::lock_guard<std::mutex> scoped(m_writeMutex);
+        auto current = m_registry.load();
+        if (auto found = find(*current))
+        {
+            // added by other thread
+            return found;
+        }
+
+        std::vector<std::string> defines;
+        for (size_t i = 0; i < current->Keywords.size(); ++i)
+        {
+            if (keywords & (1u << i))
+            {
+                defines.push_back(current->Keywords[i]);
+            }
+        }
+        shader = std::make_shared<ShaderWatcher>(shaderName, m_cache.get(),
+                                                 std::bind(&ShaderManager::readInclude, this,
+                                                           std::placeholders::_1, std::placeholders::_2),
+                                                 defines);
+        // copy on write
+        auto registry = std::make_shared<Registry>(*current);
+        registry->Shaders[fileName].insert(std::make_pair(keywords, shader));
+        m_registry.store(registry);
+    }
+
+    if (m_watcher)
+    {
+        // read and compile on WorkerPool
+        shader->load([path = m_watcher->GetPath(fileName)]() { return ReadAllText(path); });
+    }
+
+    return shader;
+}
+
+bool ShaderManager::readInclude(const std::string &path, std::string *source)
+{
+    if (!m_watcher)
+    {
+        return false;
+    }
+    auto fullPath = m_watcher->GetPath(path);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(fullPath, ec))
+    {
+        return false;
+    }
+    *source = ReadAllText(fullPath);
+
+    std::lock_guard<std::mutex> scoped(m_includeMutex);
+    m_includeHashes[path] = Hash(*source);
+    return true;
+}
+
+void ShaderManager::onFile(const std::filesystem::path &fileName)
+{
+    // once for a save. ShaderWatcher skips same source
+    auto registry = m_registry.load();
+    auto source = ReadAllText(m_watcher->GetPath(fileName));
+    auto found = registry->Shaders.find(fileName.wstring());
+    if (found != registry->Shaders.end())
+    {
+        for (auto &[keywords, shader] : found->second)
+        {
+            shader->source(source);
+        }
+    }
+
+    // may be included by others
+    auto include = fileName.generic_string();
+    {
+        auto hash = Hash(source);
+        std::lock_guard<std::mutex> scoped(m_includeMutex);
+        auto recorded = m_includeHashes.find(include);
+        if (recorded != m_includeHashes.end())
+        {
+            if (recorded->second == hash)
+            {
+                // touched
+                return;
+            }
+            recorded->second = hash;
+        }
+    }
+    int count = 0;
+    for (auto &[key, variants] : registry->Shaders)
+    {
+        for (auto &[keywords, shader] : variants)
+        {
+            if (shader->dependsOn(include))
+            {
+                // in parallel on WorkerPool
+                shader->reload();
+                ++count;
+            }
+        }
+    }
+    if (count)
+    {
+        LOGI << include << ": reload " << count << " shaders";
+    }
+}
+
+} // namespace hierarchy
@@ -1,41 +1,82 @@
-#pragma once
-#include "ShaderWatcher.h"
-#include <unordered_map>
-#include <filesystem>
-#include <mutex>
-
-namespace hierarchy
-{
-
-class ShaderManager
-{
-    std::unordered_map<std::wstring, ShaderWatcherPtr> m_shaderMap;
-    std::mutex m_mutex;
-
-    class DirectoryWatcher *m_watcher = nullptr;
-
-    // avoid copy
-    ShaderManager(const ShaderManager &) = delete;
-    ShaderManager &operator=(const ShaderManager &) = delete;
-
-    ShaderManager();
-    ~ShaderManager();
-
-public:
-    // singleton
-    static ShaderManager &Instance();
-
-    void watch(std::filesystem::path &path);
-    void stop();
-
-    // default
-    ShaderWatcherPtr get(const std::string &shaderName);
-    ShaderWatcherPtr getDefault()
-    {
-        return get("default");
-    }
-
-    void onFile(const std::wstring &fileName, int action);
-};
-
-} // namespace hierarchy
+#pragma once
+#include "ShaderWatcher.h"
+#include <atomic>
+#include <unordered_map>
+#include <filesystem>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+// bit set of ShaderManager::keyword
+using ShaderKeywords = uint32_t;
+
+///
+/// shaders in the watched directory
+///
+/// * a changed shader file compiles the shader
+/// * a changed include compiles the shaders that included it. skipped if the content hash is same
+/// * permutation by keywords. compiled on first get. same preprocessed source shares the binary
+/// * without watch shaders are empty. headless tools
+/// * copy-on-write snapshot. readers copy the pointer of an immutable Registry. writers copy it and publish under m_writeMutex
+///
+class ShaderManager
+{
+    struct Registry
+    {
+        // file name to permutations. 0 is without keywords
+        std::unordered_map<std::wstring, std::unordered_map<ShaderKeywords, ShaderWatcherPtr>> Shaders;
+        // bit index to keyword
+        std::vector<std::string> Keywords;
+    };
+    // std::atomic<std::shared_ptr> may lock internally. readers never wait for file reads or compiles
+    std::atomic<std::shared_ptr<const Registry>> m_registry;
+    // new Registry. not held while reading files or compiling
+    std::mutex m_writeMutex;
+
+    // content hash of includes when read. relative generic path
+    std::unordered_map<std::string, uint64_t> m_includeHashes;
+    std::mutex m_includeMutex;
+
+    // compiled blobs under current_path()/shader_cache. StubShaderCompiler until compiler()
+    std::unique_ptr<class ShaderCache> m_cache;
+
+    class DirectoryWatcher *m_watcher = nullptr;
+
+    // avoid copy
+    ShaderManager(const ShaderManager &) = delete;
+    ShaderManager &operator=(const ShaderManager &) = delete;
+
+    ShaderManager();
+    ~ShaderManager();
+
+    // ShaderIncludeFunc. on WorkerPool
+    bool readInclude(const std::string &path, std::string *source);
+
+public:
+    // singleton
+    static ShaderManager &Instance();
+
+    void watch(std::filesystem::path &path);
+    void stop();
+    class ShaderCache *cache() { return m_cache.get(); }
+    // D3DShaderCompiler etc. before the first get. ShaderWatchers hold the cache
+    void compiler(std::unique_ptr<class ShaderCompiler> &&compiler);
+
+    // bit of #define {name} 1. registered on first use. up to 32
+    ShaderKeywords keyword(const std::string &name);
+    ShaderWatcherPtr get(const std::string &shaderName, ShaderKeywords keywords = 0);
+    // default
+    ShaderWatcherPtr getDefault()
+    {
+        return get("default");
+    }
+
+    // relative path. on the watcher thread
+    void onFile(const std::filesystem::path &fileName);
+};
+
+} // namespace hierarchy
@@ -1,27 +1,158 @@
-#include "ShaderWatcher.h"
-#include <vector>
-#include <stdint.h>
-#include <fstream>
-#include "Shader.h"
-
-namespace hierarchy
-{
-ShaderWatcher::ShaderWatcher(const std::string &name)
-    : m_name(name), m_compiled(new Shader(name))
-{
-}
-
-void ShaderWatcher::source(const std::string &source)
-{
-    if (m_source == source)
-    {
-        return;
-    }
-
-    m_source = source;
-    m_generation++;
-
-    m_compiled->Initialize(nullptr, source, m_generation);
-}
-
-} // namespace hierarchy
+#include "ShaderWatcher.h"
+#include <vector>
+#include <stdint.h>
+#include <fstream>
+#include "Shader.h"
+#include "ShaderCache.h"
+#include "WorkerPool.h"
+#include "frame_metrics.h"
+#include <plog/Log.h>
+
+namespace hierarchy
+{
+ShaderWatcher::ShaderWatcher(const std::string &name, ShaderCache *cache, const ShaderIncludeFunc &include,
+                             const std::vector<std::string> &keywords)
+    : m_name(name), m_cache(cache), m_include(include), m_keywords(keywords)
+{
+    for (auto &keyword : m_keywords)
+    {
+        m_defines += "#define " + keyword + " 1\n";
+    }
+    if (!m_defines.empty())
+    {
+        // keep line numbers of errors
+        m_defines += "#line 1\n";
+    }
+}
+
+bool ShaderWatcher::setSource(const std::string &source, int *generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_source == source)
+    {
+        return false;
+    }
+    m_source = source;
+    *generation = ++m_generation;
+    return true;
+}
+
+void ShaderWatcher::source(const std::string &source)
+{
+    int generation;
+    if (setSource(source, &generation))
+    {
+        enqueue(source, generation);
+    }
+}
+
+void ShaderWatcher::load(const std::function<std::string()> &read)
+{
+    std::weak_ptr<ShaderWatcher> weak = shared_from_this();
+    WorkerPool::Instance().Enqueue([weak, read]() {
+        auto source = read();
+        int generation;
+        {
+            auto shared = weak.lock();
+            if (!shared || !shared->setSource(source, &generation))
+            {
+                return;
+            }
+        }
+        compile(weak, source, generation);
+    });
+}
+
+void ShaderWatcher::reload()
+{
+    std::string source;
+    int generation;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        source = m_source;
+        generation = ++m_generation;
+    }
+    enqueue(source, generation);
+}
+
+void ShaderWatcher::enqueue(const std::string &source, int generation)
+{
+    // not block file watcher thread
+    std::weak_ptr<ShaderWatcher> weak = shared_from_this();
+    WorkerPool::Instance().Enqueue([weak, source, generation]() {
+        compile(weak, source, generation);
+    });
+}
+
+void ShaderWatcher::compile(const std::weak_ptr<ShaderWatcher> &weak, const std::string &source, int generation)
+{
+    frame_metrics::scoped s("shader");
+
+    ShaderCache *cache;
+    std::string name;
+    ShaderIncludeFunc include;
+    std::string defined;
+    {
+        auto shared = weak.lock();
+        if (!shared)
+        {
+            return;
+        }
+        // immutable after construction
+        cache = shared->m_cache;
+        name = shared->m_name;
+        include = shared->m_include;
+        defined = shared->m_defines + source;
+    }
+
+    // not found includes too. may be created later
+    std::unordered_set<std::string> includes;
+    ShaderIncludeFunc recording;
+    if (include)
+    {
+        recording = [&includes, &include](const std::string &path, std::string *source) {
+            includes.insert(path);
+            return include(path, source);
+        };
+    }
+
+    std::string error;
+    auto binary = cache->GetOrCompile(name, defined, recording, &error);
+    std::shared_ptr<Shader> shader;
+    if (binary)
+    {
+        shader = std::make_shared<Shader>(name);
+        shader->Initialize(binary, generation);
+    }
+    else
+    {
+        LOGW << name << ": " << error;
+    }
+
+    auto shared = weak.lock();
+    if (!shared)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(shared->m_mutex);
+    if (shared->m_compiledGeneration > generation)
+    {
+        // newer source is already compiled
+        return;
+    }
+    shared->m_includes = std::move(includes);
+    if (!shader)
+    {
+        return;
+    }
+    shared->m_compiledGeneration = generation;
+    auto compiled = shared->m_compiled.load();
+    if (compiled && compiled->Binary() == binary)
+    {
+        // same preprocessed source. keep pipelines
+        return;
+    }
+    shared->m_compiled.store(shader);
+}
+
+} // namespace hierarchy
@@ -1,32 +1,86 @@
-#pragma once
-#include <string>
-#include <memory>
-#include <unordered_map>
-#include <filesystem>
-
-namespace hierarchy
-{
-
-class Shader;
-class ShaderWatcher
-{
-    std::string m_name;
-    std::string m_source;
-    int m_generation = 1;
-    std::shared_ptr<Shader> m_compiled;
-
-public:
-    ShaderWatcher(const std::string &name);
-    const std::string &name() const { return m_name; }
-    void source(const std::string &source);
-    std::pair<std::string, int> source() const { return std::make_pair(m_source, m_generation); }
-    void clear()
-    {
-        m_source = "";
-        m_compiled = nullptr;
-    };
-    const std::shared_ptr<Shader> &Compiled() const { return m_compiled; }
-};
-using ShaderWatcherPtr = std::shared_ptr<ShaderWatcher>;
-
-} // namespace hierarchy
+#pragma once
+#include "ShaderCompiler.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <filesystem>
+
+namespace hierarchy
+{
+
+class Shader;
+///
+/// source of a shader file and the last compiled Shader
+///
+/// * source compiles on WorkerPool through ShaderCache
+/// * Compiled is replaced when the compile is done. previous Shader is used until then
+/// * includes of the last preprocess are recorded. reload if one of them is changed
+/// * Compiled is kept if the preprocessed source is same
+/// * keywords are defined before the source. a permutation of the shader file
+///
+class ShaderWatcher : public std::enable_shared_from_this<ShaderWatcher>
+{
+    std::string m_name;
+    class ShaderCache *m_cache;
+    ShaderIncludeFunc m_include;
+    std::vector<std::string> m_keywords;
+    // #define KEYWORD 1 ...
+    std::string m_defines;
+
+    mutable std::mutex m_mutex;
+    std::string m_source;
+    int m_generation = 1;
+    // last applied compile
+    int m_compiledGeneration = 0;
+    // render thread loads a copy of the pointer without m_mutex.
+    // std::atomic<std::shared_ptr> may lock internally. never waits for compiles
+    std::atomic<std::shared_ptr<Shader>> m_compiled;
+    std::unordered_set<std::string> m_includes;
+
+    // true if changed. new generation
+    bool setSource(const std::string &source, int *generation);
+    void enqueue(const std::string &source, int generation);
+    // on WorkerPool
+    static void compile(const std::weak_ptr<ShaderWatcher> &weak, const std::string &source, int generation);
+
+public:
+    ShaderWatcher(const std::string &name, class ShaderCache *cache, const ShaderIncludeFunc &include = {},
+                  const std::vector<std::string> &keywords = {});
+    const std::string &name() const { return m_name; }
+    const std::vector<std::string> &keywords() const { return m_keywords; }
+    void source(const std::string &source);
+    // read the source and compile in a WorkerPool job. not block the caller
+    void load(const std::function<std::string()> &read);
+    // compile same source with changed includes
+    void reload();
+    // relative path as ShaderIncludeFunc
+    bool dependsOn(const std::string &include) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_includes.find(include) != m_includes.end();
+    }
+    std::pair<std::string, int> source() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::make_pair(m_source, m_generation);
+    }
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_source = "";
+        m_compiled.store(nullptr);
+    };
+    // nullptr until first compile. not blocked by compiles
+    std::shared_ptr<Shader> Compiled() const
+    {
+        return m_compiled.load();
+    }
+};
+using ShaderWatcherPtr = std::shared_ptr<ShaderWatcher>;
+
+} // namespace hierarchy
@@ -0,0 +1,120 @@
+#include "StubShaderCompiler.h"
+#include "ConstantSemanticParser.h"
+#include <algorithm>
+#include <string_view>
+
+namespace hierarchy
+{
+
+// nested includes
+const int INCLUDE_DEPTH_MAX = 16;
+
+static bool Expand(const std::string &source, const ShaderIncludeFunc &include, int depth,
+                   std::string *preprocessed, std::string *error)
+{
+    if (depth > INCLUDE_DEPTH_MAX)
+    {
+        *error = "include too deep";
+        return false;
+    }
+    for (size_t pos = 0; pos < source.size();)
+    {
+        auto end = source.find('\n', pos);
+        end = end == std::string::npos ? source.size() : end + 1;
+        auto line = std::string_view(source).substr(pos, end - pos);
+        pos = end;
+
+        auto directive = line.substr(std::min(line.find_first_not_of(" \t"), line.size()));
+        if (directive.substr(0, 8) != "#include")
+        {
+            preprocessed->append(line);
+            continue;
+        }
+        auto open = directive.find('"');
+        auto close = open == std::string_view::npos ? open : directive.find('"', open + 1);
+        if (close == std::string_view::npos)
+        {
+            *error = "invalid #include";
+            return false;
+        }
+        auto path = std::string(directive.substr(open + 1, close - open - 1));
+        std::string included;
+        if (!include || !include(path, &included))
+        {
+            *error = path + ": not found";
+            return false;
+        }
+        if (!Expand(included, include, depth + 1, preprocessed, error))
+        {
+            return false;
+        }
+        preprocessed->push_back('\n');
+    }
+    return true;
+}
+
+std::string StubShaderCompiler::Version() const
+{
+    return "stub";
+}
+
+bool StubShaderCompiler::Preprocess(const std::string &name, const std::string &source, const ShaderIncludeFunc &include,
+                                    std::string *preprocessed, std::string *error)
+{
+    preprocessed->clear();
+    if (!Expand(source, include, 0, preprocessed, error))
+    {
+        *error = name + ": " + *error;
+        return false;
+    }
+    return true;
+}
+
+bool StubShaderCompiler::Compile(const std::string &name, const std::string &preprocessed,
+                                 ShaderBinary *binary, std::string *error)
+{
+    if (preprocessed.find("#error") != std::string::npos)
+    {
+        *error = name + ": #error";
+        return false;
+    }
+
+    binary->VS.assign(preprocessed.begin(), preprocessed.end());
+    binary->PS = binary->VS;
+    binary->Inputs = {
+        // DXGI_FORMAT_R32G32B32_FLOAT
+        {.Semantic = "POSITION", .SemanticIndex = 0, .Format = 6},
+    };
+    if (preprocessed.find("INSTANCE_WORLD") != std::string::npos)
+    {
+        // float4x4 rows. DXGI_FORMAT_R32G32B32A32_FLOAT
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            binary->Inputs.push_back({.Semantic = "INSTANCE_WORLD", .SemanticIndex = i, .Format = 2});
+        }
+    }
+
+    auto semantics = ParseConstantSemantics(preprocessed);
+    std::vector<std::pair<std::string, ConstantSemantics>> sorted(semantics.begin(), semantics.end());
+    std::sort(sorted.begin(), sorted.end());
+    ConstantBuffer cb;
+    cb.reg = 1;
+    for (auto &[variable, semantic] : sorted)
+    {
+        cb.Variables.push_back({
+            .Name = variable,
+            .Semantic = semantic,
+            .Offset = (uint32_t)cb.Variables.size() * 64,
+            .Size = 64,
+        });
+    }
+    binary->VSConstants.clear();
+    if (!cb.Variables.empty())
+    {
+        binary->VSConstants.push_back(cb);
+    }
+    binary->PSConstants = binary->VSConstants;
+    return true;
+}
+
+} // namespace hierarchy
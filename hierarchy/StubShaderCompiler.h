@@ -0,0 +1,25 @@
+#pragma once
+#include "ShaderCompiler.h"
+
+namespace hierarchy
+{
+
+///
+/// ShaderCompiler without d3dcompiler. for checks of ShaderCache and headless tools
+///
+/// * Preprocess expands #include "path" only
+/// * VS and PS are the preprocessed source. #error fails
+/// * POSITION input. INSTANCE_WORLD rows if the source has it
+/// * constants of ": SEMANTIC" annotations to b1. 64 bytes each in name order
+///
+class StubShaderCompiler : public ShaderCompiler
+{
+public:
+    std::string Version() const override;
+    bool Preprocess(const std::string &name, const std::string &source, const ShaderIncludeFunc &include,
+                    std::string *preprocessed, std::string *error) override;
+    bool Compile(const std::string &name, const std::string &preprocessed,
+                 ShaderBinary *binary, std::string *error) override;
+};
+
+} // namespace hierarchy
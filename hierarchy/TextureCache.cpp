@@ -0,0 +1,255 @@
+#include "TextureCache.h"
+#include "WorkerPool.h"
+#include "SceneImage.h"
+#include "frame_metrics.h"
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
+
+namespace hierarchy
+{
+
+// bump if ProcessedTexture layout or encoders are changed
+static const uint32_t TEXTURE_CACHE_MAGIC = 0x32584554; // TEX2
+
+// FNV-1a over 8 byte words. stable between runs
+static uint64_t Hash(const uint8_t *source, size_t size, bool encoded, uint32_t width, uint32_t height,
+                     const TextureOptions &options)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto push = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 0x100000001b3ull;
+    };
+    push(TEXTURE_CACHE_MAGIC);
+    push((uint64_t)width << 32 | height);
+    push((uint64_t)options.Format << 3 | (encoded ? 4 : 0) | (options.Mips ? 2 : 0) | (options.SRGB ? 1 : 0));
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t value;
+        memcpy(&value, source + i, 8);
+        push(value);
+    }
+    for (; i < size; ++i)
+    {
+        push(source[i]);
+    }
+    return hash;
+}
+
+std::vector<uint8_t> TextureCache::Serialize(const ProcessedTexture &texture)
+{
+    std::vector<uint8_t> bytes;
+    auto write = [&bytes](uint32_t value) {
+        auto p = (const uint8_t *)&value;
+        bytes.insert(bytes.end(), p, p + 4);
+    };
+    write(TEXTURE_CACHE_MAGIC);
+    write((uint32_t)texture.Format);
+    write((uint32_t)texture.Levels.size());
+    for (auto &level : texture.Levels)
+    {
+        write(level.Width);
+        write(level.Height);
+        write(level.RowBytes);
+        write(level.Rows);
+        write(level.RowPitch);
+        bytes.insert(bytes.end(), level.Bytes.begin(), level.Bytes.end());
+    }
+    return bytes;
+}
+
+bool TextureCache::Deserialize(const std::vector<uint8_t> &bytes, ProcessedTexture *texture)
+{
+    size_t pos = 0;
+    auto read = [&bytes, &pos](uint32_t *value) {
+        if (pos + 4 > bytes.size())
+        {
+            return false;
+        }
+        memcpy(value, bytes.data() + pos, 4);
+        pos += 4;
+        return true;
+    };
+
+    uint32_t magic, format, count;
+    if (!read(&magic) || magic != TEXTURE_CACHE_MAGIC || !read(&format) || !read(&count))
+    {
+        return false;
+    }
+    if (format > (uint32_t)TextureFormat::BC7)
+    {
+        // ToDXGI throws
+        return false;
+    }
+    // Width, Height, RowBytes, Rows, RowPitch of each level. before resize
+    if (count > (bytes.size() - pos) / 20)
+    {
+        return false;
+    }
+    texture->Format = (TextureFormat)format;
+    texture->Levels.resize(count);
+    for (auto &level : texture->Levels)
+    {
+        if (!read(&level.Width) || !read(&level.Height) || !read(&level.RowBytes) || !read(&level.Rows) ||
+            !read(&level.RowPitch) || level.RowPitch < level.RowBytes || level.RowPitch % TEXTURE_PITCH_ALIGNMENT)
+        {
+            return false;
+        }
+        auto size = (size_t)level.RowPitch * level.Rows;
+        if (pos + size > bytes.size())
+        {
+            // broken file
+            return false;
+        }
+        level.Bytes.assign(bytes.data() + pos, bytes.data() + pos + size);
+        pos += size;
+    }
+    return true;
+}
+
+static std::filesystem::path CachePath(const std::filesystem::path &directory, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.texture", (unsigned long long)key);
+    return directory / name;
+}
+
+TextureCache::TextureCache(const std::filesystem::path &directory)
+    : m_directory(directory)
+{
+}
+
+TextureCache::~TextureCache()
+{
+    // workers capture this
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_stats.Pending == 0; });
+}
+
+std::shared_ptr<const ProcessedTexture> TextureCache::Load(uint64_t key)
+{
+    if (m_directory.empty())
+    {
+        return nullptr;
+    }
+    std::ifstream ifs(CachePath(m_directory, key), std::ios::binary);
+    if (!ifs)
+    {
+        return nullptr;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    auto texture = std::make_shared<ProcessedTexture>();
+    if (!Deserialize(bytes, texture.get()))
+    {
+        return nullptr;
+    }
+    return texture;
+}
+
+void TextureCache::Store(uint64_t key, const ProcessedTexture &texture)
+{
+    if (m_directory.empty())
+    {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+
+    // other process may read. rename after write
+    auto path = CachePath(m_directory, key);
+    auto tmp = path;
+    tmp += ".tmp";
+    {
+        auto bytes = Serialize(texture);
+        std::ofstream ofs(tmp, std::ios::binary);
+        if (!ofs)
+        {
+            return;
+        }
+        ofs.write((const char *)bytes.data(), bytes.size());
+    }
+    std::filesystem::rename(tmp, path, ec);
+}
+
+std::shared_ptr<TextureCache::Request> TextureCache::EnqueueSource(const std::shared_ptr<const void> &owner,
+                                                                   const uint8_t *source, size_t size, bool encoded,
+                                                                   uint32_t width, uint32_t height, const TextureOptions &options)
+{
+    auto request = std::make_shared<Request>();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.Requests;
+        ++m_stats.Pending;
+    }
+    WorkerPool::Instance().Enqueue([this, owner, request, source, size, encoded, width, height, options]() {
+        Process(request, source, size, encoded, width, height, options);
+    });
+    return request;
+}
+
+void TextureCache::Process(const std::shared_ptr<Request> &request, const uint8_t *source, size_t size, bool encoded,
+                           uint32_t width, uint32_t height, const TextureOptions &options)
+{
+    frame_metrics::scoped s("texture");
+
+    auto key = Hash(source, size, encoded, width, height, options);
+    auto texture = Load(key);
+    bool processed = false;
+    bool decoded = false;
+    if (!texture)
+    {
+        auto rgba = source;
+        std::vector<uint8_t> pixels;
+        if (encoded)
+        {
+            decoded = SceneImage::Decode(source, (int)size, &pixels) && pixels.size() == (size_t)width * height * 4;
+            rgba = decoded ? pixels.data() : nullptr;
+        }
+        if (rgba)
+        {
+            auto processing = ProcessTexture(rgba, width, height, options);
+            Store(key, *processing);
+            texture = processing;
+            processed = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (processed)
+        {
+            ++m_stats.Processed;
+            for (auto &level : texture->Levels)
+            {
+                m_stats.ProcessedBytes += level.Bytes.size();
+            }
+        }
+        else if (texture)
+        {
+            ++m_stats.DiskHits;
+        }
+        if (decoded)
+        {
+            ++m_stats.Decoded;
+        }
+        else if (encoded && !texture)
+        {
+            ++m_stats.DecodeFailures;
+        }
+        request->m_texture = texture;
+        request->m_ready.store(true, std::memory_order_release);
+        --m_stats.Pending;
+    }
+    m_cv.notify_all();
+}
+
+TextureCache::Stats TextureCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace hierarchy
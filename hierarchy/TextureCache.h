@@ -0,0 +1,87 @@
+#pragma once
+#include "TextureProcessor.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+
+namespace hierarchy
+{
+
+///
+/// ProcessedTexture keyed by hash of source pixels and options. no d3d12
+///
+/// * {directory}/{key}.texture, then ProcessTexture on WorkerPool
+/// * owner keeps source pixels alive until the request is ready
+/// * encoded source is keyed by its bytes and decoded only if not cached
+///
+class TextureCache
+{
+public:
+    class Request
+    {
+        friend class TextureCache;
+        std::shared_ptr<const ProcessedTexture> m_texture;
+        std::atomic<bool> m_ready = false;
+
+    public:
+        bool IsReady() const { return m_ready.load(std::memory_order_acquire); }
+        // nullptr until ready or if failed
+        std::shared_ptr<const ProcessedTexture> Get() const { return IsReady() ? m_texture : nullptr; }
+    };
+
+    struct Stats
+    {
+        uint64_t Requests = 0;
+        uint32_t Pending = 0;
+        uint64_t DiskHits = 0;
+        uint64_t Processed = 0;
+        uint64_t ProcessedBytes = 0;
+        uint64_t Decoded = 0;
+        uint64_t DecodeFailures = 0;
+    };
+
+private:
+    // empty is not persistent
+    std::filesystem::path m_directory;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    Stats m_stats;
+
+    // avoid copy
+    TextureCache(const TextureCache &) = delete;
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    std::shared_ptr<const ProcessedTexture> Load(uint64_t key);
+    void Store(uint64_t key, const ProcessedTexture &texture);
+    std::shared_ptr<Request> EnqueueSource(const std::shared_ptr<const void> &owner, const uint8_t *source, size_t size,
+                                           bool encoded, uint32_t width, uint32_t height, const TextureOptions &options);
+    void Process(const std::shared_ptr<Request> &request, const uint8_t *source, size_t size, bool encoded,
+                 uint32_t width, uint32_t height, const TextureOptions &options);
+
+public:
+    TextureCache(const std::filesystem::path &directory);
+    // wait workers
+    ~TextureCache();
+
+    std::shared_ptr<Request> Enqueue(const std::shared_ptr<const void> &owner,
+                                     const uint8_t *rgba, uint32_t width, uint32_t height,
+                                     const TextureOptions &options)
+    {
+        return EnqueueSource(owner, rgba, (size_t)width * height * 4, false, width, height, options);
+    }
+    // PNG/JPEG. ready without texture if decode failed
+    std::shared_ptr<Request> EnqueueEncoded(const std::shared_ptr<const void> &owner,
+                                            const uint8_t *encoded, size_t size, uint32_t width, uint32_t height,
+                                            const TextureOptions &options)
+    {
+        return EnqueueSource(owner, encoded, size, true, width, height, options);
+    }
+    Stats GetStats();
+
+    static std::vector<uint8_t> Serialize(const ProcessedTexture &texture);
+    static bool Deserialize(const std::vector<uint8_t> &bytes, ProcessedTexture *texture);
+};
+
+} // namespace hierarchy
@@ -0,0 +1,836 @@
+#include "TextureProcessor.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <math.h>
+#include <string.h>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TEXTURE_PROCESSOR_SSE2
+#endif
+
+namespace hierarchy
+{
+
+struct GammaTables
+{
+    std::array<float, 256> ToLinear;
+    std::array<uint8_t, 4096> FromLinear;
+
+    GammaTables()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            auto c = i / 255.0f;
+            ToLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; ++i)
+        {
+            auto l = i / 4095.0f;
+            auto c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+            FromLinear[i] = (uint8_t)std::clamp((int)(c * 255.0f + 0.5f), 0, 255);
+        }
+    }
+
+    static const GammaTables &Instance()
+    {
+        static GammaTables s_tables;
+        return s_tables;
+    }
+};
+
+uint32_t MipCount(uint32_t width, uint32_t height)
+{
+    uint32_t count = 1;
+    for (auto size = std::max(width, height); size > 1; size /= 2)
+    {
+        ++count;
+    }
+    return count;
+}
+
+uint32_t BlockBytes(TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::BC1:
+        return 8;
+    case TextureFormat::BC3:
+    case TextureFormat::BC7:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+TextureLevel LevelLayout(TextureFormat format, uint32_t width, uint32_t height)
+{
+    auto blockSize = format == TextureFormat::RGBA8 ? 1u : 4u;
+    TextureLevel level{
+        .Width = width,
+        .Height = height,
+        .RowBytes = std::max((width + blockSize - 1) / blockSize, 1u) * BlockBytes(format),
+        .Rows = std::max((height + blockSize - 1) / blockSize, 1u),
+    };
+    level.RowPitch = (level.RowBytes + TEXTURE_PITCH_ALIGNMENT - 1) & ~(TEXTURE_PITCH_ALIGNMENT - 1);
+    level.Bytes.resize((size_t)level.RowPitch * level.Rows);
+    return level;
+}
+
+TextureLevel CreateLevel(const uint8_t *rgba, uint32_t width, uint32_t height)
+{
+    auto level = LevelLayout(TextureFormat::RGBA8, width, height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        memcpy(level.Bytes.data() + y * level.RowPitch, rgba + y * level.RowBytes, level.RowBytes);
+    }
+    return level;
+}
+
+//
+// mip
+//
+TextureLevel Downsample(const TextureLevel &src, bool srgb)
+{
+    auto width = std::max(src.Width / 2, 1u);
+    auto height = std::max(src.Height / 2, 1u);
+    auto dst = LevelLayout(TextureFormat::RGBA8, width, height);
+
+    auto &gamma = GammaTables::Instance();
+    WorkerPool::Instance().ParallelFor((int)height, [&src, &dst, &gamma, srgb](int y) {
+        // 2 source rows in linear space
+        std::vector<float> linear(src.Width * 4 * 2);
+        for (int i = 0; i < 2; ++i)
+        {
+            auto sy = std::min((uint32_t)y * 2 + i, src.Height - 1);
+            auto p = src.Bytes.data() + sy * src.RowPitch;
+            auto l = linear.data() + i * src.Width * 4;
+            for (uint32_t x = 0; x < src.Width; ++x, p += 4, l += 4)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    l[c] = srgb ? gamma.ToLinear[p[c]] : p[c] * (1.0f / 255.0f);
+                }
+                // alpha is linear
+                l[3] = p[3] * (1.0f / 255.0f);
+            }
+        }
+
+        auto row0 = linear.data();
+        auto row1 = linear.data() + src.Width * 4;
+        auto out = dst.Bytes.data() + y * dst.RowPitch;
+        for (uint32_t x = 0; x < dst.Width; ++x, out += 4)
+        {
+            auto x0 = std::min(x * 2, src.Width - 1) * 4;
+            auto x1 = std::min(x * 2 + 1, src.Width - 1) * 4;
+            float average[4];
+#ifdef TEXTURE_PROCESSOR_SSE2
+            auto sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+                                  _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+            _mm_storeu_ps(average, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+            for (int c = 0; c < 4; ++c)
+            {
+                average[c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+            }
+#endif
+            for (int c = 0; c < 3; ++c)
+            {
+                out[c] = srgb ? gamma.FromLinear[(int)(average[c] * 4095.0f + 0.5f)]
+                              : (uint8_t)(average[c] * 255.0f + 0.5f);
+            }
+            out[3] = (uint8_t)(average[3] * 255.0f + 0.5f);
+        }
+    });
+
+    return dst;
+}
+
+//
+// blocks
+//
+class BitWriter
+{
+    uint8_t *m_dst;
+    int m_pos = 0;
+
+public:
+    BitWriter(uint8_t *dst, int size)
+        : m_dst(dst)
+    {
+        memset(dst, 0, size);
+    }
+
+    void Write(uint32_t value, int bits)
+    {
+        for (int i = 0; i < bits; ++i, ++m_pos)
+        {
+            m_dst[m_pos >> 3] |= ((value >> i) & 1) << (m_pos & 7);
+        }
+    }
+};
+
+class BitReader
+{
+    const uint8_t *m_src;
+    int m_pos = 0;
+
+public:
+    BitReader(const uint8_t *src)
+        : m_src(src)
+    {
+    }
+
+    uint32_t Read(int bits)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++m_pos)
+        {
+            value |= ((m_src[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+        }
+        return value;
+    }
+};
+
+// 4x4 texels. clamp at edge
+static void FetchBlock(const TextureLevel &rgba, uint32_t bx, uint32_t by, uint8_t *block)
+{
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        auto sy = std::min(by * 4 + y, rgba.Height - 1);
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            auto sx = std::min(bx * 4 + x, rgba.Width - 1);
+            memcpy(block + (y * 4 + x) * 4, rgba.Bytes.data() + sy * rgba.RowPitch + sx * 4, 4);
+        }
+    }
+}
+
+// endpoints at the extent of the principal axis. channels 3 or 4
+static void FitPrincipalAxis(const uint8_t *block, int channels, float *e0, float *e1)
+{
+    float mean[4] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            mean[c] += block[i * 4 + c];
+        }
+    }
+    for (int c = 0; c < channels; ++c)
+    {
+        mean[c] /= 16;
+    }
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int a = 0; a < channels; ++a)
+        {
+            for (int b = 0; b < channels; ++b)
+            {
+                cov[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+            }
+        }
+    }
+
+    // power iteration
+    float axis[4] = {1, 1, 1, 1};
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[4] = {};
+        for (int a = 0; a < channels; ++a)
+        {
+            for (int b = 0; b < channels; ++b)
+            {
+                next[a] += cov[a][b] * axis[b];
+            }
+        }
+        float length = 0;
+        for (int c = 0; c < channels; ++c)
+        {
+            length += next[c] * next[c];
+        }
+        if (length < 1e-6f)
+        {
+            break;
+        }
+        length = sqrtf(length);
+        for (int c = 0; c < channels; ++c)
+        {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float tmin = std::numeric_limits<float>::max();
+    float tmax = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 16; ++i)
+    {
+        float t = 0;
+        for (int c = 0; c < channels; ++c)
+        {
+            t += (block[i * 4 + c] - mean[c]) * axis[c];
+        }
+        tmin = std::min(tmin, t);
+        tmax = std::max(tmax, t);
+    }
+    for (int c = 0; c < channels; ++c)
+    {
+        e0[c] = std::clamp(mean[c] + axis[c] * tmax, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + axis[c] * tmin, 0.0f, 255.0f);
+    }
+}
+
+// least squares endpoints for the weights of the selected indices. false if degenerated
+static bool RefitEndpoints(const uint8_t *block, int channels, const float *weights, float *e0, float *e1)
+{
+    float a = 0, b = 0, c = 0;
+    float r0[4] = {}, r1[4] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        auto w = weights[i];
+        a += (1 - w) * (1 - w);
+        b += (1 - w) * w;
+        c += w * w;
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            r0[ch] += (1 - w) * block[i * 4 + ch];
+            r1[ch] += w * block[i * 4 + ch];
+        }
+    }
+    auto det = a * c - b * b;
+    if (fabsf(det) < 1e-6f)
+    {
+        return false;
+    }
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        e0[ch] = std::clamp((c * r0[ch] - b * r1[ch]) / det, 0.0f, 255.0f);
+        e1[ch] = std::clamp((a * r1[ch] - b * r0[ch]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+template <int N>
+static int SquaredDistance(const uint8_t *p, const int *q)
+{
+    int d = 0;
+    for (int c = 0; c < N; ++c)
+    {
+        auto v = p[c] - q[c];
+        d += v * v;
+    }
+    return d;
+}
+
+//
+// BC1 color
+//
+static uint16_t To565(const float *c)
+{
+    auto r = std::clamp((int)(c[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+    auto g = std::clamp((int)(c[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+    auto b = std::clamp((int)(c[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void From565(uint16_t v, int *c)
+{
+    auto r = (v >> 11) & 31;
+    auto g = (v >> 5) & 63;
+    auto b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+static void ColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4])
+{
+    From565(c0, palette[0]);
+    From565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        if (fourColor || c0 > c1)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = (fourColor || c0 > c1) ? 255 : 0;
+}
+
+// 4 color mode. returns squared error
+static int QuantizeColorBlock(const uint8_t *block, const float *e0, const float *e1,
+                              uint16_t *c0, uint16_t *c1, uint8_t *indices)
+{
+    *c0 = To565(e0);
+    *c1 = To565(e1);
+    if (*c0 < *c1)
+    {
+        std::swap(*c0, *c1);
+    }
+    int palette[4][4];
+    ColorPalette(*c0, *c1, true, palette);
+
+    int error = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        int best = 0;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int j = 0; j < 4; ++j)
+        {
+            auto d = SquaredDistance<3>(block + i * 4, palette[j]);
+            if (d < bestDistance)
+            {
+                best = j;
+                bestDistance = d;
+            }
+        }
+        indices[i] = (uint8_t)best;
+        error += bestDistance;
+    }
+    return error;
+}
+
+static void EncodeColorBlock(const uint8_t *block, uint8_t *dst)
+{
+    float e0[4], e1[4];
+    FitPrincipalAxis(block, 3, e0, e1);
+    uint16_t c0, c1;
+    uint8_t indices[16];
+    auto error = QuantizeColorBlock(block, e0, e1, &c0, &c1, indices);
+
+    if (error > 0 && c0 != c1)
+    {
+        static const float WEIGHTS[] = {0, 1, 1.0f / 3, 2.0f / 3};
+        float weights[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            weights[i] = WEIGHTS[indices[i]];
+        }
+        float r0[4], r1[4];
+        if (RefitEndpoints(block, 3, weights, r0, r1))
+        {
+            uint16_t rc0, rc1;
+            uint8_t refit[16];
+            auto refitError = QuantizeColorBlock(block, r0, r1, &rc0, &rc1, refit);
+            if (refitError < error)
+            {
+                c0 = rc0;
+                c1 = rc1;
+                memcpy(indices, refit, 16);
+            }
+        }
+    }
+
+    BitWriter w(dst, 8);
+    w.Write(c0, 16);
+    w.Write(c1, 16);
+    for (int i = 0; i < 16; ++i)
+    {
+        w.Write(indices[i], 2);
+    }
+}
+
+static void DecodeColorBlock(const uint8_t *src, bool fourColor, uint8_t *block)
+{
+    BitReader r(src);
+    auto c0 = (uint16_t)r.Read(16);
+    auto c1 = (uint16_t)r.Read(16);
+    int palette[4][4];
+    ColorPalette(c0, c1, fourColor, palette);
+    for (int i = 0; i < 16; ++i)
+    {
+        auto &color = palette[r.Read(2)];
+        for (int c = 0; c < 4; ++c)
+        {
+            block[i * 4 + c] = (uint8_t)color[c];
+        }
+    }
+}
+
+//
+// BC3 alpha
+//
+static void AlphaPalette(int a0, int a1, int *palette)
+{
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1)
+    {
+        for (int i = 2; i < 8; ++i)
+        {
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+        {
+            palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static void EncodeAlphaBlock(const uint8_t *block, uint8_t *dst)
+{
+    int a0 = 0;
+    int a1 = 255;
+    for (int i = 0; i < 16; ++i)
+    {
+        a0 = std::max(a0, (int)block[i * 4 + 3]);
+        a1 = std::min(a1, (int)block[i * 4 + 3]);
+    }
+    int palette[8];
+    AlphaPalette(a0, a1, palette);
+
+    BitWriter w(dst, 8);
+    w.Write(a0, 8);
+    w.Write(a1, 8);
+    for (int i = 0; i < 16; ++i)
+    {
+        int best = 0;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int j = 0; j < 8; ++j)
+        {
+            auto d = abs(block[i * 4 + 3] - palette[j]);
+            if (d < bestDistance)
+            {
+                best = j;
+                bestDistance = d;
+            }
+        }
+        w.Write(best, 3);
+    }
+}
+
+static void DecodeAlphaBlock(const uint8_t *src, uint8_t *block)
+{
+    BitReader r(src);
+    auto a0 = (int)r.Read(8);
+    auto a1 = (int)r.Read(8);
+    int palette[8];
+    AlphaPalette(a0, a1, palette);
+    for (int i = 0; i < 16; ++i)
+    {
+        block[i * 4 + 3] = (uint8_t)palette[r.Read(3)];
+    }
+}
+
+//
+// BC7 mode 6. one subset, RGBA 7 bits + p-bit endpoints, 4 bit indices
+//
+static const int BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct BC7Endpoint
+{
+    int Q[4];
+    int P;
+
+    void Quantize(const float *e)
+    {
+        int bestError = std::numeric_limits<int>::max();
+        for (int p = 0; p < 2; ++p)
+        {
+            int q[4];
+            int error = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                q[c] = std::clamp((int)((e[c] - p) * 0.5f + 0.5f), 0, 127);
+                auto d = (q[c] * 2 + p) - (int)(e[c] + 0.5f);
+                error += d * d;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                memcpy(Q, q, sizeof(q));
+                P = p;
+            }
+        }
+    }
+
+    int Value(int c) const { return Q[c] * 2 + P; }
+};
+
+static void BC7Palette(const BC7Endpoint &e0, const BC7Endpoint &e1, int palette[16][4])
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        auto w = BC7_WEIGHTS4[i];
+        for (int c = 0; c < 4; ++c)
+        {
+            palette[i][c] = ((64 - w) * e0.Value(c) + w * e1.Value(c) + 32) >> 6;
+        }
+    }
+}
+
+static int QuantizeBC7Block(const uint8_t *block, const float *f0, const float *f1,
+                            BC7Endpoint *e0, BC7Endpoint *e1, uint8_t *indices)
+{
+    e0->Quantize(f0);
+    e1->Quantize(f1);
+    int palette[16][4];
+    BC7Palette(*e0, *e1, palette);
+
+    int error = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        int best = 0;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int j = 0; j < 16; ++j)
+        {
+            auto d = SquaredDistance<4>(block + i * 4, palette[j]);
+            if (d < bestDistance)
+            {
+                best = j;
+                bestDistance = d;
+            }
+        }
+        indices[i] = (uint8_t)best;
+        error += bestDistance;
+    }
+    return error;
+}
+
+static void EncodeBC7Block(const uint8_t *block, uint8_t *dst)
+{
+    float f0[4], f1[4];
+    FitPrincipalAxis(block, 4, f0, f1);
+    BC7Endpoint e0, e1;
+    uint8_t indices[16];
+    auto error = QuantizeBC7Block(block, f0, f1, &e0, &e1, indices);
+
+    if (error > 0)
+    {
+        float weights[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            weights[i] = BC7_WEIGHTS4[indices[i]] / 64.0f;
+        }
+        float r0[4], r1[4];
+        if (RefitEndpoints(block, 4, weights, r0, r1))
+        {
+            BC7Endpoint q0, q1;
+            uint8_t refit[16];
+            if (QuantizeBC7Block(block, r0, r1, &q0, &q1, refit) < error)
+            {
+                e0 = q0;
+                e1 = q1;
+                memcpy(indices, refit, 16);
+            }
+        }
+    }
+
+    // anchor index has implicit 0 msb
+    if (indices[0] & 8)
+    {
+        std::swap(e0, e1);
+        for (auto &index : indices)
+        {
+            index = 15 - index;
+        }
+    }
+
+    BitWriter w(dst, 16);
+    w.Write(1 << 6, 7);
+    for (int c = 0; c < 4; ++c)
+    {
+        w.Write(e0.Q[c], 7);
+        w.Write(e1.Q[c], 7);
+    }
+    w.Write(e0.P, 1);
+    w.Write(e1.P, 1);
+    w.Write(indices[0], 3);
+    for (int i = 1; i < 16; ++i)
+    {
+        w.Write(indices[i], 4);
+    }
+}
+
+// mode 6 only. other modes are black
+static void DecodeBC7Block(const uint8_t *src, uint8_t *block)
+{
+    BitReader r(src);
+    if (r.Read(7) != (1 << 6))
+    {
+        memset(block, 0, 64);
+        return;
+    }
+    BC7Endpoint e0, e1;
+    for (int c = 0; c < 4; ++c)
+    {
+        e0.Q[c] = r.Read(7);
+        e1.Q[c] = r.Read(7);
+    }
+    e0.P = r.Read(1);
+    e1.P = r.Read(1);
+    int palette[16][4];
+    BC7Palette(e0, e1, palette);
+    for (int i = 0; i < 16; ++i)
+    {
+        auto &color = palette[r.Read(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c)
+        {
+            block[i * 4 + c] = (uint8_t)color[c];
+        }
+    }
+}
+
+//
+// levels
+//
+TextureLevel EncodeLevel(const TextureLevel &rgba, TextureFormat format)
+{
+    if (format == TextureFormat::RGBA8)
+    {
+        return rgba;
+    }
+
+    auto blockBytes = BlockBytes(format);
+    auto dst = LevelLayout(format, rgba.Width, rgba.Height);
+
+    WorkerPool::Instance().ParallelFor((int)dst.Rows, [&rgba, &dst, format, blockBytes](int by) {
+        uint8_t block[64];
+        auto out = dst.Bytes.data() + by * dst.RowPitch;
+        for (uint32_t bx = 0; bx * blockBytes < dst.RowBytes; ++bx, out += blockBytes)
+        {
+            FetchBlock(rgba, bx, by, block);
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                EncodeColorBlock(block, out);
+                break;
+            case TextureFormat::BC3:
+                EncodeAlphaBlock(block, out);
+                EncodeColorBlock(block, out + 8);
+                break;
+            case TextureFormat::BC7:
+                EncodeBC7Block(block, out);
+                break;
+            default:
+                break;
+            }
+        }
+    });
+
+    return dst;
+}
+
+TextureLevel DecodeLevel(const TextureLevel &encoded, TextureFormat format)
+{
+    if (format == TextureFormat::RGBA8)
+    {
+        return encoded;
+    }
+
+    auto dst = LevelLayout(TextureFormat::RGBA8, encoded.Width, encoded.Height);
+
+    auto blockBytes = BlockBytes(format);
+    for (uint32_t by = 0; by < encoded.Rows; ++by)
+    {
+        auto src = encoded.Bytes.data() + by * encoded.RowPitch;
+        for (uint32_t bx = 0; bx * blockBytes < encoded.RowBytes; ++bx, src += blockBytes)
+        {
+            uint8_t block[64];
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                DecodeColorBlock(src, false, block);
+                break;
+            case TextureFormat::BC3:
+                DecodeColorBlock(src + 8, true, block);
+                DecodeAlphaBlock(src, block);
+                break;
+            case TextureFormat::BC7:
+                DecodeBC7Block(src, block);
+                break;
+            default:
+                break;
+            }
+
+            // crop
+            for (uint32_t y = 0; y < 4 && by * 4 + y < dst.Height; ++y)
+            {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < dst.Width; ++x)
+                {
+                    memcpy(dst.Bytes.data() + (by * 4 + y) * dst.RowPitch + (bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+double PSNR(const TextureLevel &a, const TextureLevel &b, int channels)
+{
+    if (a.Width != b.Width || a.Height != b.Height)
+    {
+        return 0;
+    }
+    double sum = 0;
+    for (uint32_t y = 0; y < a.Height; ++y)
+    {
+        auto pa = a.Bytes.data() + y * a.RowPitch;
+        auto pb = b.Bytes.data() + y * b.RowPitch;
+        for (uint32_t x = 0; x < a.Width; ++x, pa += 4, pb += 4)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                auto d = (double)pa[c] - pb[c];
+                sum += d * d;
+            }
+        }
+    }
+    if (sum == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    auto mse = sum / ((double)a.Width * a.Height * channels);
+    return 10 * log10(255.0 * 255.0 / mse);
+}
+
+std::shared_ptr<ProcessedTexture> ProcessTexture(const uint8_t *rgba, uint32_t width, uint32_t height,
+                                                 const TextureOptions &options)
+{
+    auto texture = std::make_shared<ProcessedTexture>();
+    texture->Format = options.Format;
+    if (width % 4 || height % 4)
+    {
+        // D3D12 requires block aligned top level
+        texture->Format = TextureFormat::RGBA8;
+    }
+
+    auto count = options.Mips ? MipCount(width, height) : 1;
+    auto source = CreateLevel(rgba, width, height);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (texture->Format == TextureFormat::RGBA8)
+        {
+            if (i > 0)
+            {
+                source = Downsample(texture->Levels.back(), options.SRGB);
+            }
+            texture->Levels.push_back(std::move(source));
+        }
+        else
+        {
+            if (i > 0)
+            {
+                source = Downsample(source, options.SRGB);
+            }
+            texture->Levels.push_back(EncodeLevel(source, texture->Format));
+        }
+    }
+    return texture;
+}
+
+} // namespace hierarchy
@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace hierarchy
+{
+
+enum class TextureFormat : uint32_t
+{
+    RGBA8,
+    // RGB. 8 bytes per 4x4 block
+    BC1,
+    // RGBA. 16 bytes per 4x4 block
+    BC3,
+    // RGBA mode 6. 16 bytes per 4x4 block
+    BC7,
+};
+
+struct TextureOptions
+{
+    TextureFormat Format = TextureFormat::RGBA8;
+    bool Mips = true;
+    // filter color in linear space
+    bool SRGB = true;
+};
+
+// same as D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+static const uint32_t TEXTURE_PITCH_ALIGNMENT = 256;
+
+// rows of texels or rows of 4x4 blocks.
+// RowPitch is aligned for upload. Bytes is RowPitch * Rows
+struct TextureLevel
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint32_t RowBytes = 0;
+    uint32_t Rows = 0;
+    uint32_t RowPitch = 0;
+    std::vector<uint8_t> Bytes;
+};
+
+struct ProcessedTexture
+{
+    TextureFormat Format = TextureFormat::RGBA8;
+    std::vector<TextureLevel> Levels;
+};
+
+///
+/// mip chain and block compression of RGBA8 images. no d3d12
+///
+/// * box filter in linear space. SSE2 if available
+/// * range fit BC1/BC3 and BC7 mode 6 encoders. block rows on WorkerPool
+/// * BC requires width and height of multiple of 4. otherwise RGBA8
+/// * each level is one memcpy to upload staging
+///
+uint32_t MipCount(uint32_t width, uint32_t height);
+// 4 for RGBA8 texel. 8 or 16 for BC block
+uint32_t BlockBytes(TextureFormat format);
+// empty level of pitched layout. BC is in 4x4 blocks
+TextureLevel LevelLayout(TextureFormat format, uint32_t width, uint32_t height);
+// from tight RGBA8
+TextureLevel CreateLevel(const uint8_t *rgba, uint32_t width, uint32_t height);
+TextureLevel Downsample(const TextureLevel &src, bool srgb);
+TextureLevel EncodeLevel(const TextureLevel &rgba, TextureFormat format);
+// to RGBA8. for quality measurement
+TextureLevel DecodeLevel(const TextureLevel &encoded, TextureFormat format);
+// RGBA8 levels of same size. channels 3 ignores alpha. infinity if identical
+double PSNR(const TextureLevel &a, const TextureLevel &b, int channels = 4);
+
+std::shared_ptr<ProcessedTexture> ProcessTexture(const uint8_t *rgba, uint32_t width, uint32_t height,
+                                                 const TextureOptions &options);
+
+} // namespace hierarchy
@@ -1,22 +1,66 @@
-#include "ToUnicode.h"
-#include <windows.h>
-#include <vector>
-#include <system_error>
-
-std::wstring ToUnicode(const std::string &src, UINT CP)
-{
-    auto const dest_size = ::MultiByteToWideChar(CP, 0U, src.data(), -1, nullptr, 0U);
-    std::vector<wchar_t> dest(dest_size, L'\0');
-    if (::MultiByteToWideChar(CP, 0U, src.data(), -1, dest.data(), (UINT)dest.size()) == 0)
-    {
-        throw std::system_error{static_cast<int>(::GetLastError()), std::system_category()};
-    }
-    dest.resize(std::char_traits<wchar_t>::length(dest.data()));
-    dest.shrink_to_fit();
-    return std::wstring(dest.begin(), dest.end());
-}
-
-std::wstring Utf8ToUnicode(const std::string &src)
-{
-    return ToUnicode(src, CP_UTF8);
-}
+#include "ToUnicode.h"
+#include <vector>
+#include <system_error>
+#if defined(_WIN32)
+#include <windows.h>
+
+std::wstring ToUnicode(const std::string &src, UINT CP)
+{
+    auto const dest_size = ::MultiByteToWideChar(CP, 0U, src.data(), -1, nullptr, 0U);
+    std::vector<wchar_t> dest(dest_size, L'\0');
+    if (::MultiByteToWideChar(CP, 0U, src.data(), -1, dest.data(), (UINT)dest.size()) == 0)
+    {
+        throw std::system_error{static_cast<int>(::GetLastError()), std::system_category()};
+    }
+    dest.resize(std::char_traits<wchar_t>::length(dest.data()));
+    dest.shrink_to_fit();
+    return std::wstring(dest.begin(), dest.end());
+}
+
+std::wstring Utf8ToUnicode(const std::string &src)
+{
+    return ToUnicode(src, CP_UTF8);
+}
+
+#else
+
+// CP_UTF8
+static const uint32_t UTF8 = 65001;
+
+// wchar_t is UTF-32. invalid sequence is U+FFFD
+std::wstring Utf8ToUnicode(const std::string &src)
+{
+    std::wstring dst;
+    dst.reserve(src.size());
+    auto p = (const uint8_t *)src.data();
+    auto end = p + src.size();
+    while (p < end)
+    {
+        uint32_t c = *p++;
+        int follows = c < 0x80 ? 0 : (c & 0xE0) == 0xC0 ? 1 : (c & 0xF0) == 0xE0 ? 2 : (c & 0xF8) == 0xF0 ? 3 : -1;
+        if (follows < 0)
+        {
+            dst.push_back(0xFFFD);
+            continue;
+        }
+        c &= 0x7F >> follows;
+        int i = 0;
+        for (; i < follows && p < end && (*p & 0xC0) == 0x80; ++i)
+        {
+            c = (c << 6) | (*p++ & 0x3F);
+        }
+        dst.push_back(i == follows ? (wchar_t)c : 0xFFFD);
+    }
+    return dst;
+}
+
+std::wstring ToUnicode(const std::string &src, uint32_t CP)
+{
+    if (CP != UTF8)
+    {
+        throw std::system_error{std::make_error_code(std::errc::not_supported)};
+    }
+    return Utf8ToUnicode(src);
+}
+
+#endif
@@ -1,5 +1,5 @@
-#include <string>
-#include <stdint.h>
-
-std::wstring ToUnicode(std::string const &src, uint32_t CP);
-std::wstring Utf8ToUnicode(const std::string &src);
+#include <string>
+#include <stdint.h>
+
+std::wstring ToUnicode(std::string const &src, uint32_t CP);
+std::wstring Utf8ToUnicode(const std::string &src);
@@ -0,0 +1,114 @@
+#include "WorkerPool.h"
+#include "frame_metrics.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <string>
+
+namespace hierarchy
+{
+
+WorkerPool::WorkerPool(int threadCount)
+{
+    for (int i = 0; i < threadCount; ++i)
+    {
+        m_threads.push_back(std::thread(&WorkerPool::Loop, this, i));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> scoped(m_mutex);
+        m_isEnd = true;
+    }
+    m_cv.notify_all();
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+WorkerPool &WorkerPool::Instance()
+{
+    static WorkerPool s_instance(std::max((int)std::thread::hardware_concurrency() - 1, 1));
+    return s_instance;
+}
+
+void WorkerPool::Loop(int index)
+{
+    auto name = "worker " + std::to_string(index);
+    frame_metrics::set_thread_name(name.c_str());
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_isEnd || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                // m_isEnd
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+void WorkerPool::Enqueue(const std::function<void()> &task)
+{
+    {
+        std::lock_guard<std::mutex> scoped(m_mutex);
+        m_tasks.push(task);
+    }
+    m_cv.notify_one();
+}
+
+void WorkerPool::ParallelFor(int count, const std::function<void(int)> &func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<int> next = 0;
+        std::atomic<int> done = 0;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+
+    // worker may start after return. keep state and func copy
+    auto run = [state, count, func]() {
+        while (true)
+        {
+            auto i = state->next++;
+            if (i >= count)
+            {
+                break;
+            }
+            func(i);
+            if (++state->done == count)
+            {
+                std::lock_guard<std::mutex> scoped(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    auto helpers = std::min(ThreadCount(), count - 1);
+    for (int i = 0; i < helpers; ++i)
+    {
+        Enqueue(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state, count] { return state->done == count; });
+}
+
+} // namespace hierarchy
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace hierarchy
+{
+
+///
+/// fixed size worker threads
+///
+class WorkerPool
+{
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_isEnd = false;
+
+    // avoid copy
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    void Loop(int index);
+
+public:
+    WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    // singleton. hardware_concurrency - 1 workers
+    static WorkerPool &Instance();
+
+    int ThreadCount() const { return (int)m_threads.size(); }
+
+    // fire and forget
+    void Enqueue(const std::function<void()> &task);
+
+    // func(0) ... func(count-1) on workers and calling thread. return after all done
+    void ParallelFor(int count, const std::function<void(int)> &func);
+};
+
+} // namespace hierarchy
@@ -1,128 +1,585 @@
-#include "frame_metrics.h"
-#include <array>
-#include <algorithm>
-#include <Windows.h>
-#include <vector>
-#include <assert.h>
-
-namespace frame_metrics
-{
-
-struct FrameMetric
-{
-    float duration;
-    std::vector<section> sections;
-};
-
-class Metrics
-{
-    int m_pos = 0;
-    std::array<FrameMetric, 60> m_delta;
-    std::vector<int> m_stack;
-
-    LARGE_INTEGER m_freq;
-    float m_freqInv;
-    LARGE_INTEGER m_last{};
-
-public:
-    Metrics()
-    {
-        QueryPerformanceFrequency(&m_freq);
-        m_freqInv = 1.0f / m_freq.QuadPart;
-    }
-
-    void new_frame()
-    {
-        LARGE_INTEGER now;
-        QueryPerformanceCounter(&now);
-        if (m_last.QuadPart)
-        {
-            auto delta = now.QuadPart - m_last.QuadPart;
-            m_delta[m_pos++].duration = delta * m_freqInv;
-            if (m_pos >= 60)
-            {
-                m_pos -= 60;
-                assert(m_pos == 0);
-            }
-            m_delta[m_pos].sections.clear();
-            m_stack.clear();
-        }
-        m_last = now;
-    }
-
-    float histroy(int index)
-    {
-        auto wrapped = (m_pos - 60 + index);
-        while (wrapped < 0)
-        {
-            wrapped += 60;
-        }
-
-        return m_delta[wrapped].duration;
-    }
-
-    float now()
-    {
-        LARGE_INTEGER value;
-        QueryPerformanceCounter(&value);
-        auto delta = value.QuadPart - m_last.QuadPart;
-        return delta * m_freqInv;
-    }
-
-    ///
-    /// profiler
-    ///
-    void push(const char *section)
-    {
-        auto index = (int)m_delta[m_pos].sections.size();
-        m_delta[m_pos].sections.push_back({
-            .parent = m_stack.empty() ? -1 : m_stack.back(),
-            .name = section,
-            .start = now(),
-        });
-        m_stack.push_back(index);
-    }
-
-    void pop()
-    {
-        auto index = m_stack.back();
-        m_stack.pop_back();
-        m_delta[m_pos].sections[index].end = now();
-    }
-
-    const section *get_sections(int *count)
-    {
-        auto pos = m_pos == 0 ? 59 : m_pos - 1;
-        auto &frame = m_delta[pos];
-        *count = (int)frame.sections.size();
-        return frame.sections.data();
-    }
-};
-thread_local Metrics tl_metrics;
-
-void new_frame()
-{
-    tl_metrics.new_frame();
-}
-
-float imgui_plot(void *data, int index)
-{
-    return tl_metrics.histroy(index);
-}
-
-void push_internal(const char *section, size_t)
-{
-    tl_metrics.push(section);
-}
-
-void pop()
-{
-    tl_metrics.pop();
-}
-
-const section *get_sections(int *count)
-{
-    return tl_metrics.get_sections(count);
-}
-
-} // namespace frame_metrics
+#include "frame_metrics.h"
+#include "FrameArena.h"
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+// frame_metrics_new.cpp
+static std::atomic<uint64_t> g_allocationCount = 0;
+static std::atomic<uint64_t> g_allocationBytes = 0;
+
+namespace frame_metrics
+{
+
+using Clock = std::chrono::steady_clock;
+
+static float ToSeconds(Clock::rep ticks)
+{
+    return (float)((double)ticks * Clock::period::num / Clock::period::den);
+}
+
+struct Event
+{
+    const char *name;
+    Clock::rep start;
+    Clock::rep end;
+    int depth;
+};
+
+///
+/// sections of a thread
+///
+/// * owner thread writes ended sections. new_frame drains them
+/// * single producer single consumer ring. no lock per section
+///
+class ThreadBuffer
+{
+    static const uint32_t CAPACITY = 4096;
+    static const int STACK_MAX = 64;
+
+    std::array<Event, CAPACITY> m_events;
+    std::atomic<uint32_t> m_head = 0;
+    std::atomic<uint32_t> m_tail = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+    // owner only
+    std::array<Event, STACK_MAX> m_stack;
+    int m_depth = 0;
+
+public:
+    const int Id;
+    // under g_threadsMutex
+    std::string Name;
+    std::atomic<bool> Alive = true;
+
+    ThreadBuffer(int id)
+        : Id(id), Name("thread " + std::to_string(id))
+    {
+    }
+
+    void Push(const char *name)
+    {
+        if (m_depth < STACK_MAX)
+        {
+            m_stack[m_depth] = {
+                .name = name,
+                .start = Clock::now().time_since_epoch().count(),
+                .depth = m_depth,
+            };
+        }
+        ++m_depth;
+    }
+
+    void Pop()
+    {
+        if (m_depth == 0)
+        {
+            return;
+        }
+        --m_depth;
+        if (m_depth >= STACK_MAX)
+        {
+            return;
+        }
+        auto event = m_stack[m_depth];
+        event.end = Clock::now().time_since_epoch().count();
+
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_events[head % CAPACITY] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // new_frame thread
+    template <typename F>
+    uint64_t Drain(const F &f)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+        {
+            f(m_events[tail % CAPACITY]);
+        }
+        m_tail.store(tail, std::memory_order_release);
+        return m_dropped.exchange(0, std::memory_order_relaxed);
+    }
+};
+
+static std::mutex g_threadsMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> g_threads;
+static int g_nextThreadId = 0;
+
+struct ThreadLocal
+{
+    std::shared_ptr<ThreadBuffer> Buffer;
+
+    ThreadLocal()
+    {
+        std::lock_guard<std::mutex> lock(g_threadsMutex);
+        Buffer = std::make_shared<ThreadBuffer>(g_nextThreadId++);
+        g_threads.push_back(Buffer);
+    }
+
+    ~ThreadLocal()
+    {
+        // removed after drained
+        Buffer->Alive = false;
+    }
+};
+thread_local ThreadLocal tl_thread;
+
+// section with thread id for trace
+struct TraceEvent
+{
+    const char *name;
+    Clock::rep start;
+    Clock::rep end;
+    int thread;
+};
+
+struct FrameRecord
+{
+    Clock::rep start;
+    Clock::rep end;
+    std::vector<TraceEvent> events;
+    // ThreadBuffer::Id and name
+    std::vector<std::pair<int, std::string>> threads;
+    allocations Allocations;
+    // set_counter name and value
+    std::vector<std::pair<const char *, double>> counters;
+};
+
+///
+/// last frames for write_trace. vectors of slots are reused
+///
+class Capture
+{
+    std::vector<FrameRecord> m_frames = std::vector<FrameRecord>(300);
+    size_t m_next = 0;
+    size_t m_count = 0;
+
+public:
+    std::mutex Mutex;
+
+    void Resize(int frames)
+    {
+        m_frames.clear();
+        m_frames.resize(std::max(frames, 0));
+        m_next = 0;
+        m_count = 0;
+    }
+
+    // nullptr if not capturing
+    FrameRecord *Next()
+    {
+        if (m_frames.empty())
+        {
+            return nullptr;
+        }
+        auto record = &m_frames[m_next];
+        record->events.clear();
+        record->threads.clear();
+        record->counters.clear();
+        return record;
+    }
+
+    void Commit()
+    {
+        m_next = (m_next + 1) % m_frames.size();
+        m_count = std::min(m_count + 1, m_frames.size());
+    }
+
+    template <typename F>
+    void ForEach(const F &f) const
+    {
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            f(m_frames[(m_next + m_frames.size() - m_count + i) % m_frames.size()]);
+        }
+    }
+};
+
+class Metrics
+{
+    int m_pos = 0;
+    std::array<float, 60> m_delta{};
+    Clock::rep m_last = 0;
+
+    std::vector<section> m_sections;
+    std::vector<std::string> m_threadNames;
+    uint64_t m_dropped = 0;
+
+    void Merge(Clock::rep frameStart, ThreadBuffer *frameThread, FrameRecord *record)
+    {
+        m_sections.clear();
+        m_threadNames.clear();
+        m_dropped = 0;
+
+        std::lock_guard<std::mutex> lock(g_threadsMutex);
+        // new_frame thread is lane 0
+        std::stable_partition(g_threads.begin(), g_threads.end(),
+                              [frameThread](auto &buffer) { return buffer.get() == frameThread; });
+        for (auto it = g_threads.begin(); it != g_threads.end();)
+        {
+            auto &buffer = *it;
+            auto alive = buffer->Alive.load();
+            auto thread = (int)m_threadNames.size();
+            auto begin = m_sections.size();
+            auto id = buffer->Id;
+            m_dropped += buffer->Drain([this, frameStart, thread, record, id](const Event &event) {
+                if (record)
+                {
+                    record->events.push_back({event.name, event.start, event.end, id});
+                }
+                m_sections.push_back({
+                    .parent = -1,
+                    .name = event.name,
+                    .start = event.start > frameStart ? ToSeconds(event.start - frameStart) : 0,
+                    .end = event.end > frameStart ? ToSeconds(event.end - frameStart) : 0,
+                    .thread = thread,
+                    .depth = event.depth,
+                });
+            });
+
+            if (m_sections.size() > begin)
+            {
+                // ended order to start order. parent is the last started of depth - 1
+                std::stable_sort(m_sections.begin() + begin, m_sections.end(), [](const section &l, const section &r) {
+                    return l.start != r.start ? l.start < r.start : l.depth < r.depth;
+                });
+                std::array<int, 64> parents;
+                parents.fill(-1);
+                for (auto i = begin; i < m_sections.size(); ++i)
+                {
+                    auto &section = m_sections[i];
+                    if (section.depth > 0 && section.depth <= (int)parents.size())
+                    {
+                        // parent may end in a later frame
+                        auto parent = parents[section.depth - 1];
+                        if (parent >= 0 && m_sections[parent].end >= section.end)
+                        {
+                            section.parent = parent;
+                        }
+                    }
+                    if (section.depth < (int)parents.size())
+                    {
+                        parents[section.depth] = (int)i;
+                    }
+                }
+                m_threadNames.push_back(buffer->Name);
+            }
+            else if (buffer.get() == frameThread)
+            {
+                // keep lane 0
+                m_threadNames.push_back(buffer->Name);
+            }
+            if (record)
+            {
+                record->threads.push_back({buffer->Id, buffer->Name});
+            }
+
+            if (!alive)
+            {
+                it = g_threads.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+public:
+    // false if first frame
+    bool new_frame(FrameRecord *record)
+    {
+        auto now = Clock::now().time_since_epoch().count();
+        auto last = m_last;
+        m_last = now;
+        if (!last)
+        {
+            return false;
+        }
+        m_delta[m_pos] = ToSeconds(now - last);
+        m_pos = (m_pos + 1) % 60;
+        if (record)
+        {
+            record->start = last;
+            record->end = now;
+        }
+        Merge(last, tl_thread.Buffer.get(), record);
+        return true;
+    }
+
+    float histroy(int index)
+    {
+        auto wrapped = (m_pos - 60 + index);
+        while (wrapped < 0)
+        {
+            wrapped += 60;
+        }
+
+        return m_delta[wrapped];
+    }
+
+    const section *get_sections(int *count)
+    {
+        *count = (int)m_sections.size();
+        return m_sections.data();
+    }
+
+    int get_thread_count()
+    {
+        return (int)m_threadNames.size();
+    }
+
+    const char *get_thread_name(int thread)
+    {
+        return thread >= 0 && thread < (int)m_threadNames.size() ? m_threadNames[thread].c_str() : "";
+    }
+
+    uint64_t get_dropped()
+    {
+        return m_dropped;
+    }
+};
+// new_frame thread
+static Metrics g_metrics;
+static Capture g_capture;
+static void CaptureCounters(FrameRecord *record);
+
+static allocations g_lastAllocations{};
+static allocations g_frameStart{};
+
+void new_frame()
+{
+    std::lock_guard<std::mutex> lock(g_capture.Mutex);
+    auto record = g_capture.Next();
+    auto captured = g_metrics.new_frame(record);
+
+    allocations now{
+        .count = g_allocationCount,
+        .bytes = g_allocationBytes,
+    };
+    g_lastAllocations = {
+        .count = now.count - g_frameStart.count,
+        .bytes = now.bytes - g_frameStart.bytes,
+    };
+    g_frameStart = now;
+
+    hierarchy::FrameArena::NewFrame();
+    g_lastAllocations.arena_bytes = hierarchy::FrameArena::LastFrameBytes();
+
+    if (record && captured)
+    {
+        CaptureCounters(record);
+        g_capture.Commit();
+    }
+}
+
+float imgui_plot(void *data, int index)
+{
+    return g_metrics.histroy(index);
+}
+
+void set_thread_name(const char *name)
+{
+    auto buffer = tl_thread.Buffer.get();
+    std::lock_guard<std::mutex> lock(g_threadsMutex);
+    buffer->Name = name;
+}
+
+void push_internal(const char *section, size_t)
+{
+    tl_thread.Buffer->Push(section);
+}
+
+void pop()
+{
+    tl_thread.Buffer->Pop();
+}
+
+const section *get_sections(int *count)
+{
+    return g_metrics.get_sections(count);
+}
+
+int get_thread_count()
+{
+    return g_metrics.get_thread_count();
+}
+
+const char *get_thread_name(int thread)
+{
+    return g_metrics.get_thread_name(thread);
+}
+
+uint64_t get_dropped_sections()
+{
+    return g_metrics.get_dropped();
+}
+
+allocations get_allocations()
+{
+    return g_lastAllocations;
+}
+
+void count_allocation(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+// literal names. set_counter may be called from any thread
+static std::mutex g_countersMutex;
+static std::vector<std::pair<const char *, double>> g_counters;
+
+void set_counter_internal(const char *name, size_t, double value)
+{
+    std::lock_guard<std::mutex> lock(g_countersMutex);
+    auto found = std::find_if(g_counters.begin(), g_counters.end(), [name](auto &counter) {
+        return counter.first == name || strcmp(counter.first, name) == 0;
+    });
+    if (found == g_counters.end())
+    {
+        g_counters.push_back({name, value});
+    }
+    else
+    {
+        found->second = value;
+    }
+}
+
+static void CaptureCounters(FrameRecord *record)
+{
+    record->Allocations = g_lastAllocations;
+    std::lock_guard<std::mutex> lock(g_countersMutex);
+    record->counters.assign(g_counters.begin(), g_counters.end());
+}
+
+void set_capture_frames(int frames)
+{
+    std::lock_guard<std::mutex> lock(g_capture.Mutex);
+    g_capture.Resize(frames);
+}
+
+static void WriteString(std::ostream &os, const char *src)
+{
+    os << '"';
+    for (auto p = src; *p; ++p)
+    {
+        auto c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+        {
+            os << '\\' << (char)c;
+        }
+        else if (c < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            os << escaped;
+        }
+        else
+        {
+            os << (char)c;
+        }
+    }
+    os << '"';
+}
+
+bool write_trace(const char *path)
+{
+    std::ofstream os(path, std::ios::binary);
+    if (!os)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_capture.Mutex);
+    Clock::rep origin = 0;
+    g_capture.ForEach([&origin](const FrameRecord &frame) {
+        if (!origin)
+        {
+            origin = frame.start;
+        }
+    });
+    // microseconds from the first frame
+    auto us = [origin](Clock::rep ticks) {
+        return (double)(ticks - origin) * Clock::period::num / Clock::period::den * 1000000.0;
+    };
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"frame_metrics\"}}";
+
+    // last name of each thread
+    std::vector<std::pair<int, std::string>> threads;
+    g_capture.ForEach([&threads](const FrameRecord &frame) {
+        for (auto &thread : frame.threads)
+        {
+            auto found = std::find_if(threads.begin(), threads.end(), [&thread](auto &t) { return t.first == thread.first; });
+            if (found == threads.end())
+            {
+                threads.push_back(thread);
+            }
+            else
+            {
+                found->second = thread.second;
+            }
+        }
+    });
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threads[i].first << ",\"args\":{\"name\":";
+        WriteString(os, threads[i].second.c_str());
+        os << "}}";
+        // new_frame thread first
+        os << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threads[i].first
+           << ",\"args\":{\"sort_index\":" << i << "}}";
+    }
+
+    g_capture.ForEach([&os, &us](const FrameRecord &frame) {
+        // nested by time in each tid
+        for (auto &event : frame.events)
+        {
+            os << ",\n{\"name\":";
+            WriteString(os, event.name);
+            os << ",\"cat\":\"section\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+               << ",\"ts\":" << us(event.start) << ",\"dur\":" << us(event.end) - us(event.start) << "}";
+        }
+
+        auto counter = [&os, &us, &frame](const char *name) -> std::ostream & {
+            os << ",\n{\"name\":";
+            WriteString(os, name);
+            os << ",\"ph\":\"C\",\"pid\":1,\"ts\":" << us(frame.start) << ",\"args\":{";
+            return os;
+        };
+        counter("frame") << "\"ms\":" << (us(frame.end) - us(frame.start)) / 1000.0 << "}}";
+        counter("allocations") << "\"count\":" << frame.Allocations.count
+                               << ",\"bytes\":" << frame.Allocations.bytes
+                               << ",\"arena_bytes\":" << frame.Allocations.arena_bytes << "}}";
+        for (auto [name, value] : frame.counters)
+        {
+            counter(name) << "\"value\":" << value << "}}";
+        }
+    });
+
+    os << "\n]}\n";
+    return (bool)os;
+}
+
+} // namespace frame_metrics
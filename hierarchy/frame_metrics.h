@@ -1,43 +1,86 @@
-#pragma once
-
-namespace frame_metrics
-{
-
-void new_frame();
-float imgui_plot(void *data, int index);
-
-void push_internal(const char *section, size_t n);
-
-template <size_t N>
-void push(const char (&section)[N])
-{
-    push_internal(section, N);
-}
-void pop();
-
-template <size_t N>
-struct scoped
-{
-    scoped(const char (&section)[N])
-    {
-        push(section);
-    }
-    ~scoped()
-    {
-        pop();
-    }
-
-    scoped(const scoped &) = delete;
-    scoped &operator=(const scoped &) = delete;
-};
-
-struct section
-{
-    int parent;
-    const char *name;
-    float start;
-    float end;
-};
-const section *get_sections(int *count);
-
-} // namespace frame_metrics
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace frame_metrics
+{
+
+// steady_clock. QueryPerformanceCounter on Windows
+void new_frame();
+float imgui_plot(void *data, int index);
+
+// lane label of the calling thread. default is "thread {n}"
+void set_thread_name(const char *name);
+
+void push_internal(const char *section, size_t n);
+
+template <size_t N>
+void push(const char (&section)[N])
+{
+    push_internal(section, N);
+}
+void pop();
+
+template <size_t N>
+struct scoped
+{
+    scoped(const char (&section)[N])
+    {
+        push(section);
+    }
+    ~scoped()
+    {
+        pop();
+    }
+
+    scoped(const scoped &) = delete;
+    scoped &operator=(const scoped &) = delete;
+};
+
+struct section
+{
+    // index in get_sections. same thread
+    int parent;
+    const char *name;
+    // seconds from the last frame start. started in a previous frame is 0
+    float start;
+    float end;
+    // lane of get_thread_name. 0 is the thread of new_frame
+    int thread;
+    int depth;
+};
+// sections ended in last frame. all threads, sorted by thread and start
+const section *get_sections(int *count);
+int get_thread_count();
+const char *get_thread_name(int thread);
+// sections lost in last frame. per thread buffer was full
+uint64_t get_dropped_sections();
+
+// frames kept for write_trace. 0 stops capture. default 300
+void set_capture_frames(int frames);
+// Chrome trace event JSON of captured frames. chrome://tracing or ui.perfetto.dev
+bool write_trace(const char *path);
+
+struct allocations
+{
+    uint64_t count;
+    uint64_t bytes;
+    // hierarchy::FrameArena
+    uint64_t arena_bytes;
+};
+// heap allocations(operator new) in last frame. all threads
+// count and bytes are 0 unless the executable links frame_metrics_new
+allocations get_allocations();
+// operator new of frame_metrics_new.cpp
+void count_allocation(size_t size);
+
+void set_counter_internal(const char *name, size_t n, double value);
+
+// counter track of write_trace. the last value is captured each frame. owners keep their stats
+template <size_t N>
+void set_counter(const char (&name)[N], double value)
+{
+    set_counter_internal(name, N, value);
+}
+
+} // namespace frame_metrics
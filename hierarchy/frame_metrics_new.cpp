@@ -0,0 +1,41 @@
+#include "frame_metrics.h"
+#include <new>
+#include <stdlib.h>
+
+//
+// replace global operator new to count heap allocations. link only to the executable that shows them
+//
+void *operator new(size_t size)
+{
+    frame_metrics::count_allocation(size);
+    if (auto p = malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    operator delete(p);
+}
@@ -1,14 +1,18 @@
-#pragma once
-
-#include "Scene.h"
-#include "ShaderManager.h"
-#include "ShaderWatcher.h"
-#include "SceneLight.h"
-#include "SceneModel.h"
-#include "SceneMeshSkin.h"
-#include "VertexBuffer.h"
-#include "SceneMesh.h"
-#include "SceneView.h"
-#include "DrawList.h"
-#include "MeshFactory/CreateGrid.h"
-#include "Shader.h"
+#pragma once
+
+#include "Scene.h"
+#include "ShaderManager.h"
+#include "ShaderWatcher.h"
+#include "SceneLight.h"
+#include "SceneModel.h"
+#include "SceneMeshSkin.h"
+#include "VertexBuffer.h"
+#include "Payload.h"
+#include "TextureProcessor.h"
+#include "TextureCache.h"
+#include "SceneMesh.h"
+#include "SceneView.h"
+#include "DrawList.h"
+#include "DrawListCapture.h"
+#include "MeshFactory/CreateGrid.h"
+#include "Shader.h"
@@ -1,62 +1,64 @@
-SamplerState s0 : register(s0);
-Texture2D t0 : register(t0);
-cbuffer SceneConstantBuffer : register(b0)
-{
-    float4x4 b0View : CAMERA_VIEW;
-    float4x4 b0Projection : CAMERA_PROJECTION;
-    float3 b0LightDirection : LIGHT_DIRECTION;
-    float3 b0LightColor : LIGHT_COLOR;
-};
-cbuffer NodeConstantBuffer : register(b1)
-{
-    float4x4 b1World : NODE_WORLD;
-};
-// cbuffer MaterialConstantBuffer: register(b2)
-// {
-// 	float4 b2Diffuse;
-// 	float3 b2Ambient;
-// 	float3 b2Specular;
-// };
-
-struct VSInput
-{
-    float3 position : SV_POSITION;
-    float3 normal : NORMAL;
-    float2 uv : TEXCOORD0;
-};
-struct PSInput
-{
-    float4 position : SV_POSITION;
-    float3 normal : NORMAL;
-    float2 uv : TEXCOORD0;
-};
-
-PSInput VSMain(VSInput vs)
-{
-    PSInput result;
-
-    result.position = mul(b0Projection, mul(b0View, mul(b1World, float4(vs.position, 1))));
-    result.normal = normalize(mul(b1World, float4(vs.normal, 0)).xyz);
-    result.uv = vs.uv;
-
-    return result;
-}
-
-float4 PSMain(PSInput input) : SV_TARGET
-{
-    // float3 P = input.position.xyz;
-    float4 vColor = t0.Sample(s0, input.uv);
-    float3 N = input.normal;
-    float3 L = normalize(-b0LightDirection);
-    float3 Shading = vColor.xyz * (saturate(dot(N, L)) + float3(0.2, 0.2, 0.2));
-    return float4(Shading, 1);
-}
-
-technique MainTec0
-{
-    pass DrawObject
-    {
-        VertexShader = compile vs_3_0 VSMain();
-        PixelShader = compile ps_3_0 PSMain();
-    }
-}
+SamplerState s0 : register(s0);
+Texture2D t0 : register(t0);
+cbuffer SceneConstantBuffer : register(b0)
+{
+    float4x4 b0View : CAMERA_VIEW;
+    float4x4 b0Projection : CAMERA_PROJECTION;
+    float3 b0LightDirection : LIGHT_DIRECTION;
+    float3 b0LightColor : LIGHT_COLOR;
+};
+// cbuffer MaterialConstantBuffer: register(b2)
+// {
+// 	float4 b2Diffuse;
+// 	float3 b2Ambient;
+// 	float3 b2Specular;
+// };
+
+struct VSInput
+{
+    float3 position : SV_POSITION;
+    float3 normal : NORMAL;
+    float2 uv : TEXCOORD0;
+    // vertex stream slot 1
+    float4x4 world : INSTANCE_WORLD;
+};
+struct PSInput
+{
+    float4 position : SV_POSITION;
+    float3 normal : NORMAL;
+    float2 uv : TEXCOORD0;
+};
+
+PSInput VSMain(VSInput vs)
+{
+    PSInput result;
+
+    result.position = mul(b0Projection, mul(b0View, mul(vs.world, float4(vs.position, 1))));
+    result.normal = normalize(mul(vs.world, float4(vs.normal, 0)).xyz);
+    result.uv = vs.uv;
+
+    return result;
+}
+
+float4 PSMain(PSInput input) : SV_TARGET
+{
+    // float3 P = input.position.xyz;
+    float4 vColor = t0.Sample(s0, input.uv);
+#ifdef ALPHA_MASK
+    // glTF default alphaCutoff
+    clip(vColor.w - 0.5);
+#endif
+    float3 N = input.normal;
+    float3 L = normalize(-b0LightDirection);
+    float3 Shading = vColor.xyz * (saturate(dot(N, L)) + float3(0.2, 0.2, 0.2));
+    return float4(Shading, 1);
+}
+
+technique MainTec0
+{
+    pass DrawObject
+    {
+        VertexShader = compile vs_3_0 VSMain();
+        PixelShader = compile ps_3_0 PSMain();
+    }
+}